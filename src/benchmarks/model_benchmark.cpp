@@ -0,0 +1,631 @@
+/**
+ * @file model_benchmark.cpp
+ * @brief Замеры производительности загрузки и обработки моделей.
+ *
+ * Модели берутся из каталога objects/ (путь можно переопределить
+ * переменной окружения S21_OBJECTS_DIR) и из синтетических сеток
+ * (MeshGenerator) от 10^3 до 10^7 полигонов, которые создаются во временном
+ * каталоге при первом использовании. Верхнюю границу можно поднять
+ * переменной S21_BENCHMARK_MAX_FACES (например, до 10^8). Пропускная
+ * способность выводится в байтах, вершинах и рёбрах в секунду, для
+ * загрузки - ещё и число выделений памяти.
+ *
+ * Запуск: make benchmark (или цель benchmark в CMake). Отдельные замеры
+ * выбираются флагом --benchmark_filter.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../controller/controller.hpp"
+#include "../model/bvh.hpp"
+#include "../model/capture.hpp"
+#include "../model/lod.hpp"
+#include "../model/mesh_generator.hpp"
+#include "../model/model.hpp"
+#include "../model/transform_kernels.hpp"
+#include "../patterns/command.hpp"
+#include "../patterns/frame_recorder.hpp"
+#include "../patterns/model_manager.hpp"
+
+namespace {
+
+/// Число вызовов operator new во всей программе
+std::atomic<size_t> allocations{0};
+
+}  // namespace
+
+// Замена глобальных operator new/delete для подсчёта выделений. noinline:
+// иначе GCC видит malloc и free в одной функции после встраивания и выдаёт
+// ложное предупреждение -Wmismatched-new-delete.
+[[gnu::noinline]] void* operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](size_t size) {
+  return ::operator new(size);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete[](void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace s21 {
+
+namespace {
+
+/// Модели из objects/, от куба до самой большой
+const std::vector<std::string> kCorpus = {
+    "1_cube.OBJ", "2_Lowpoly_tree_sample.obj", "3_katana.OBJ",
+    "4_FinalBaseMesh.obj", "5_Rectangle.obj"};
+
+std::string ObjectsDir() {
+  const char* dir = std::getenv("S21_OBJECTS_DIR");
+  return dir && *dir ? dir : "objects";
+}
+
+/**
+ * @brief Путь к файлу OBJ синтетической сетки.
+ *
+ * Файл создаётся один раз и затем переиспользуется.
+ */
+std::string GeneratedMesh(const MeshSpec& spec) {
+  namespace fs = std::filesystem;
+  std::string name = MeshSpecName(spec);
+  std::replace(name.begin(), name.end(), ':', '_');
+  const fs::path path =
+      fs::temp_directory_path() / ("s21_benchmark_" + name + ".obj");
+  if (!fs::exists(path) && !WriteMeshObj(spec, path.string())) {
+    fs::remove(path);
+  }
+  return path.string();
+}
+
+/**
+ * @brief Путь к решётке из faces четырёхугольников.
+ */
+std::string SyntheticMesh(size_t faces) {
+  return GeneratedMesh({MeshShape::kGrid, faces, 4});
+}
+
+/**
+ * @brief Размеры синтетических сеток: 10^3, 10^4, ... до
+ * S21_BENCHMARK_MAX_FACES (по умолчанию 10^7).
+ */
+void SyntheticRange(benchmark::internal::Benchmark* b) {
+  int64_t max_faces = 10'000'000;
+  if (const char* env = std::getenv("S21_BENCHMARK_MAX_FACES")) {
+    max_faces = std::max<int64_t>(std::atoll(env), 1000);
+  }
+  b->RangeMultiplier(10)->Range(1000, max_faces);
+}
+
+/// Сетки разного вида и записи индексов с 10^6 полигонов
+const std::vector<std::string> kGenerated = {
+    "grid:1000000:3",   "grid:1000000:4:full", "grid:1000000:8",
+    "sphere:1000000:4", "soup:1000000:3",      "soup:1000000:6:texture"};
+
+MeshSpec GeneratedSpec(benchmark::State& state) {
+  const std::string& text = kGenerated[static_cast<size_t>(state.range(0))];
+  state.SetLabel(text);
+  MeshSpec spec;
+  ParseMeshSpec(text, spec);
+  return spec;
+}
+
+/**
+ * @brief Записывает пропускную способность замера.
+ *
+ * edges = 0 - замер не зависит от рёбер, счётчик edges/s не выводится.
+ */
+void SetThroughput(benchmark::State& state, size_t bytes, size_t vertices,
+                   size_t edges) {
+  const auto iterations = static_cast<double>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+  state.counters["vertices/s"] = benchmark::Counter(
+      iterations * static_cast<double>(vertices), benchmark::Counter::kIsRate);
+  if (edges > 0) {
+    state.counters["edges/s"] = benchmark::Counter(
+        iterations * static_cast<double>(edges), benchmark::Counter::kIsRate);
+  }
+}
+
+void RunLoad(benchmark::State& state, const std::string& path,
+             const LoadOptions& options) {
+  Model model;
+  const size_t allocations_before = allocations.load();
+  for (auto _ : state) {
+    if (!model.LoadFromFile(path, options)) {
+      state.SkipWithError(model.GetLastErrorString().c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(model.GetEdges().data());
+  }
+  SetThroughput(state, std::filesystem::file_size(path),
+                model.GetVertexCount(), model.GetEdgeCount());
+  // Выделения памяти на одну загрузку (вместе с построением рёбер)
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations.load() - allocations_before),
+      benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief Загружает модель для замеров, которым нужна готовая сетка.
+ *
+ * @return Модель или nullptr, если файл не загружен (замер пропускается с
+ * описанием ошибки).
+ */
+std::unique_ptr<Model> LoadModel(benchmark::State& state,
+                                 const std::string& path) {
+  auto model = std::make_unique<Model>();
+  if (!model->LoadFromFile(path)) {
+    state.SkipWithError(model->GetLastErrorString().c_str());
+    return nullptr;
+  }
+  return model;
+}
+
+std::string CorpusPath(benchmark::State& state) {
+  const std::string& name = kCorpus[static_cast<size_t>(state.range(0))];
+  state.SetLabel(name);
+  return ObjectsDir() + "/" + name;
+}
+
+// --- Загрузка ---
+
+void BM_LoadCorpus(benchmark::State& state) {
+  RunLoad(state, CorpusPath(state), LoadOptions());
+}
+BENCHMARK(BM_LoadCorpus)->DenseRange(0, 4)->Unit(benchmark::kMillisecond);
+
+void BM_LoadSynthetic(benchmark::State& state) {
+  RunLoad(state, SyntheticMesh(static_cast<size_t>(state.range(0))),
+          LoadOptions());
+}
+BENCHMARK(BM_LoadSynthetic)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_LoadSyntheticSerial(benchmark::State& state) {
+  LoadOptions options;
+  options.parallel = false;
+  RunLoad(state, SyntheticMesh(static_cast<size_t>(state.range(0))), options);
+}
+BENCHMARK(BM_LoadSyntheticSerial)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_LoadSyntheticEdgesOnly(benchmark::State& state) {
+  LoadOptions options;
+  options.mode = LoadMode::kEdgesOnly;
+  RunLoad(state, SyntheticMesh(static_cast<size_t>(state.range(0))), options);
+}
+BENCHMARK(BM_LoadSyntheticEdgesOnly)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_LoadGenerated(benchmark::State& state) {
+  RunLoad(state, GeneratedMesh(GeneratedSpec(state)), LoadOptions());
+}
+BENCHMARK(BM_LoadGenerated)
+    ->DenseRange(0, static_cast<int64_t>(kGenerated.size()) - 1)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_LoadGeneratedAttributes(benchmark::State& state) {
+  LoadOptions options;
+  options.attributes = true;
+  RunLoad(state, GeneratedMesh(GeneratedSpec(state)), options);
+}
+BENCHMARK(BM_LoadGeneratedAttributes)
+    ->DenseRange(0, static_cast<int64_t>(kGenerated.size()) - 1)
+    ->Unit(benchmark::kMillisecond);
+
+// --- Обработка загруженной модели ---
+
+/**
+ * @brief Выделение рёбер: GetEdges() на модели со сброшенным кэшем рёбер.
+ */
+void RunExtractEdges(benchmark::State& state, const Model& source) {
+  Model model;
+  for (auto _ : state) {
+    state.PauseTiming();
+    model.SetMeshData(source.GetPathFile(), source.GetVertices(),
+                      source.GetFaceIndices(), source.GetFaceOffsets());
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(model.GetEdges().data());
+  }
+  SetThroughput(state, source.GetFaceIndices().size() * sizeof(uint32_t),
+                source.GetVertexCount(), source.GetEdgeCount());
+}
+
+void BM_ExtractEdgesCorpus(benchmark::State& state) {
+  const std::unique_ptr<Model> model = LoadModel(state, CorpusPath(state));
+  if (model) RunExtractEdges(state, *model);
+}
+BENCHMARK(BM_ExtractEdgesCorpus)->DenseRange(0, 4)->Unit(benchmark::kMillisecond);
+
+void BM_ExtractEdgesSynthetic(benchmark::State& state) {
+  const auto faces = static_cast<size_t>(state.range(0));
+  const std::unique_ptr<Model> model = LoadModel(state, SyntheticMesh(faces));
+  if (model) RunExtractEdges(state, *model);
+}
+BENCHMARK(BM_ExtractEdgesSynthetic)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Выделение рёбер на сетке, построенной в памяти (без файла).
+ */
+void BM_ExtractEdgesGenerated(benchmark::State& state) {
+  Model source;
+  if (!GenerateMesh(GeneratedSpec(state), source)) {
+    state.SkipWithError("mesh is too large");
+    return;
+  }
+  RunExtractEdges(state, source);
+}
+BENCHMARK(BM_ExtractEdgesGenerated)
+    ->DenseRange(0, static_cast<int64_t>(kGenerated.size()) - 1)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Слияние вершин на сетке, у каждого полигона которой свои вершины
+ * (как у моделей, экспортированных из CAD).
+ */
+void BM_WeldGenerated(benchmark::State& state) {
+  Model shared;
+  if (!GenerateMesh(GeneratedSpec(state), shared)) {
+    state.SkipWithError("mesh is too large");
+    return;
+  }
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  vertices.reserve(shared.GetFaceIndices().size());
+  indices.reserve(shared.GetFaceIndices().size());
+  for (uint32_t index : shared.GetFaceIndices()) {
+    indices.push_back(static_cast<uint32_t>(vertices.size()));
+    vertices.push_back(shared.GetVertices()[index]);
+  }
+
+  Model model;
+  size_t removed = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    model.SetMeshData(shared.GetPathFile(), vertices, indices,
+                      shared.GetFaceOffsets());
+    state.ResumeTiming();
+    removed = model.WeldVertices().vertices_removed;
+  }
+  state.counters["removed"] = static_cast<double>(removed);
+  SetThroughput(state, vertices.size() * sizeof(Vertex), vertices.size(), 0);
+}
+BENCHMARK(BM_WeldGenerated)
+    ->DenseRange(0, static_cast<int64_t>(kGenerated.size()) - 1)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_NormalizeCorpus(benchmark::State& state) {
+  const std::unique_ptr<Model> model = LoadModel(state, CorpusPath(state));
+  if (!model) return;
+  for (auto _ : state) {
+    model->NormalizeModel();
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, model->GetVertexCount() * sizeof(Vertex),
+                model->GetVertexCount(), 0);
+}
+BENCHMARK(BM_NormalizeCorpus)->DenseRange(0, 4)->Unit(benchmark::kMicrosecond);
+
+void RunBuildLod(benchmark::State& state, const std::string& path) {
+  const std::unique_ptr<Model> model = LoadModel(state, path);
+  if (!model) return;
+  LodOptions options;
+  options.min_edges = 0;
+  size_t levels = 0;
+  for (auto _ : state) {
+    const LodSet set =
+        BuildLodSet(model->GetVertices(), model->GetEdges(), options);
+    levels = set.levels.size();
+    benchmark::DoNotOptimize(set.levels.data());
+  }
+  state.counters["levels"] = static_cast<double>(levels);
+  SetThroughput(state, model->GetEdgeCount() * sizeof(Edge),
+                model->GetVertexCount(), model->GetEdgeCount());
+}
+
+void BM_BuildLodCorpus(benchmark::State& state) {
+  RunBuildLod(state, CorpusPath(state));
+}
+BENCHMARK(BM_BuildLodCorpus)->DenseRange(0, 4)->Unit(benchmark::kMillisecond);
+
+void BM_BuildLodSynthetic(benchmark::State& state) {
+  RunBuildLod(state, SyntheticMesh(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_BuildLodSynthetic)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMillisecond);
+
+// --- Иерархия рёбер (отсечение и выбор мышью) ---
+
+void BM_BuildBvhSynthetic(benchmark::State& state) {
+  const std::unique_ptr<Model> model =
+      LoadModel(state, SyntheticMesh(static_cast<size_t>(state.range(0))));
+  if (!model) return;
+  for (auto _ : state) {
+    Bvh bvh;
+    bvh.Build(model->GetVertices(), model->GetEdges());
+    benchmark::DoNotOptimize(bvh.GetNodes().data());
+  }
+  SetThroughput(state, model->GetEdgeCount() * sizeof(Edge),
+                model->GetVertexCount(), model->GetEdgeCount());
+}
+BENCHMARK(BM_BuildBvhSynthetic)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Нормализованная модель, увеличенная вдвое: на экране (область
+ * [-1, 1]) видна примерно её центральная часть.
+ *
+ * @return Модель или nullptr, если файл не загружен (см. LoadModel).
+ */
+std::unique_ptr<Model> LoadZoomedModel(benchmark::State& state, size_t faces,
+                                       Matrix4& mvp) {
+  std::unique_ptr<Model> model = LoadModel(state, SyntheticMesh(faces));
+  if (!model) return nullptr;
+  model->NormalizeModel();
+  model->GetBvh();
+  mvp = Matrix4::Scale(2.0f);
+  return model;
+}
+
+void BM_CullBvh(benchmark::State& state) {
+  Matrix4 mvp;
+  const std::unique_ptr<Model> model =
+      LoadZoomedModel(state, static_cast<size_t>(state.range(0)), mvp);
+  if (!model) return;
+  const Frustum frustum = Frustum::FromMatrix(mvp);
+  std::vector<EdgeRange> ranges;
+  size_t visible = 0;
+  for (auto _ : state) {
+    visible = model->GetBvh().CollectVisible(frustum, ranges, 4096);
+    benchmark::DoNotOptimize(ranges.data());
+  }
+  state.counters["visible_edges"] = static_cast<double>(visible);
+  state.counters["ranges"] = static_cast<double>(ranges.size());
+}
+BENCHMARK(BM_CullBvh)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_PickBvh(benchmark::State& state) {
+  Matrix4 mvp;
+  const std::unique_ptr<Model> model =
+      LoadZoomedModel(state, static_cast<size_t>(state.range(0)), mvp);
+  if (!model) return;
+  const PickQuery query{400, 400, 800, 800, 6};
+  PickResult result;
+  for (auto _ : state) {
+    result = model->GetBvh().Pick(model->GetVertices(), model->GetEdges(),
+                                  mvp, query);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["hit"] = result.kind != PickResult::Kind::kNone;
+}
+BENCHMARK(BM_PickBvh)
+    ->Apply(SyntheticRange)
+    ->Unit(benchmark::kMicrosecond);
+
+// --- Команды ---
+
+/**
+ * @brief Выполнение команды над текущей моделью ModelManager.
+ *
+ * range(0) - индекс модели в kCorpus, range(1) - TransformMode. В режиме
+ * kMatrix вершины не обходятся, поэтому пропускная способность не выводится.
+ */
+template <typename MakeCommand>
+void RunCommand(benchmark::State& state, MakeCommand make_command) {
+  auto& manager = ModelManager::GetInstance();
+  const auto mode = static_cast<TransformMode>(state.range(1));
+  std::unique_ptr<Model> model = LoadModel(state, CorpusPath(state));
+  if (!model) return;
+  manager.SetTransformMode(mode);
+  manager.SetModel(std::move(model));
+  state.SetLabel(kCorpus[static_cast<size_t>(state.range(0))] +
+                 (mode == TransformMode::kBake ? " bake" : " matrix"));
+
+  auto command = make_command();
+  for (auto _ : state) {
+    command->Execute();
+    benchmark::ClobberMemory();
+  }
+  if (mode == TransformMode::kBake) {
+    const size_t vertices = manager.GetModel()->GetVertexCount();
+    SetThroughput(state, vertices * sizeof(Vertex), vertices, 0);
+  }
+
+  manager.Clear();
+  manager.SetTransformMode(TransformMode::kBake);
+}
+
+void CommandArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t model = 0; model < static_cast<int64_t>(kCorpus.size());
+       ++model) {
+    for (auto mode : {TransformMode::kBake, TransformMode::kMatrix}) {
+      b->Args({model, static_cast<int64_t>(mode)});
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+void BM_MoveCommand(benchmark::State& state) {
+  RunCommand(state, [] { return std::make_unique<MoveCommand>(0.1f, 0, 0); });
+}
+BENCHMARK(BM_MoveCommand)->Apply(CommandArgs);
+
+void BM_RotateCommand(benchmark::State& state) {
+  RunCommand(state,
+             [] { return std::make_unique<RotateCommand>(1.0f, 2.0f, 3.0f); });
+}
+BENCHMARK(BM_RotateCommand)->Apply(CommandArgs);
+
+void BM_ScaleCommand(benchmark::State& state) {
+  RunCommand(state, [] { return std::make_unique<ScaleCommand>(1.001f); });
+}
+BENCHMARK(BM_ScaleCommand)->Apply(CommandArgs);
+
+/**
+ * @brief Абсолютное состояние трансформации: одно вычисление на кадр.
+ *
+ * range(0) - индекс модели в kCorpus, range(1) - TransformMode. Как и в
+ * RunCommand, пропускная способность выводится только для kBake.
+ */
+void BM_AbsoluteTransform(benchmark::State& state) {
+  auto& manager = ModelManager::GetInstance();
+  const auto mode = static_cast<TransformMode>(state.range(1));
+  std::unique_ptr<Model> model = LoadModel(state, CorpusPath(state));
+  if (!model) return;
+  manager.SetTransformMode(mode);
+  manager.SetModel(std::move(model));
+  state.SetLabel(kCorpus[static_cast<size_t>(state.range(0))] +
+                 (mode == TransformMode::kBake ? " bake" : " matrix"));
+
+  Controller controller(manager);
+  TransformState transform;
+  for (auto _ : state) {
+    transform.rotate_y += 1.0f;
+    controller.SetTransformState(transform);
+    controller.ApplyTransformState();
+    benchmark::ClobberMemory();
+  }
+  if (mode == TransformMode::kBake) {
+    const size_t vertices = manager.GetModel()->GetVertexCount();
+    SetThroughput(state, vertices * sizeof(Vertex), vertices, 0);
+  }
+
+  manager.Clear();
+  manager.SetTransformMode(TransformMode::kBake);
+}
+BENCHMARK(BM_AbsoluteTransform)->Apply(CommandArgs);
+
+// --- Ядра преобразования (подготовка данных для отрисовки) ---
+
+void BM_TransformPoints(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  std::vector<float> points(count * 3);
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (float& v : points) v = dist(gen);
+  const Matrix4 m = Matrix4::Rotation(1.0f, 2.0f, 3.0f);
+
+  state.SetLabel(TransformKernelName());
+  for (auto _ : state) {
+    TransformPoints(points.data(), count, m);
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, count * sizeof(Vertex), count, 0);
+}
+BENCHMARK(BM_TransformPoints)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10'000'000)
+    ->Unit(benchmark::kMicrosecond);
+
+// --- Запись кадров (640x480, как при записи вращения модели) ---
+
+/**
+ * @brief Кадр, похожий на каркас: тёмный фон и светлые линии.
+ */
+CaptureFrame WireframeFrame(uint32_t seed) {
+  CaptureFrame frame;
+  frame.Resize(640, 480);
+  for (size_t i = 0; i < frame.pixels.size(); i += 4) {
+    frame.pixels[i] = frame.pixels[i + 1] = frame.pixels[i + 2] = 26;
+    frame.pixels[i + 3] = 255;
+  }
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<uint32_t> x(0, 639), y(0, 479);
+  for (int line = 0; line < 400; ++line) {
+    const int x0 = static_cast<int>(x(gen)), y0 = static_cast<int>(y(gen));
+    const int x1 = static_cast<int>(x(gen)), y1 = static_cast<int>(y(gen));
+    const int steps = std::max(std::abs(x1 - x0), std::abs(y1 - y0)) + 1;
+    for (int t = 0; t < steps; ++t) {
+      const size_t px = static_cast<size_t>(x0 + (x1 - x0) * t / steps);
+      const size_t py = static_cast<size_t>(y0 + (y1 - y0) * t / steps);
+      uint8_t* pixel = &frame.pixels[(py * 640 + px) * 4];
+      pixel[0] = pixel[1] = pixel[2] = 230;
+    }
+  }
+  return frame;
+}
+
+void BM_EncodeGifFrame(benchmark::State& state) {
+  const CaptureFrame frame = WireframeFrame(42);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    const std::vector<uint8_t> block = EncodeGifFrame(frame, 10);
+    bytes = block.size();
+    benchmark::DoNotOptimize(block.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() *
+                                               frame.pixels.size()));
+  state.counters["gif_bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_EncodeGifFrame)->Unit(benchmark::kMillisecond);
+
+void BM_RecordGif(benchmark::State& state) {
+  const auto frames = static_cast<size_t>(state.range(0));
+  std::vector<CaptureFrame> source;
+  for (uint32_t i = 0; i < 8; ++i) source.push_back(WireframeFrame(i));
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "s21_record.gif").string();
+
+  RecordOptions options{CaptureFormat::kGif, path};
+  options.queue_limit = frames;
+  FrameRecorder recorder;
+  for (auto _ : state) {
+    recorder.Start(options);
+    for (size_t i = 0; i < frames; ++i) {
+      CaptureFrame frame = recorder.AcquireFrame();
+      frame = source[i % source.size()];
+      recorder.Submit(std::move(frame));
+    }
+    recorder.Stop();
+  }
+  state.counters["frames/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * frames),
+      benchmark::Counter::kIsRate);
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_RecordGif)->Arg(30)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
+
+}  // namespace s21
+
+BENCHMARK_MAIN();
@@ -14,9 +14,13 @@
 #define CONTROLLER_HPP
 
 #include <string>
+#include <vector>
 
+#include "../patterns/async_loader.hpp"
 #include "../patterns/command.hpp"
+#include "../patterns/command_queue.hpp"
 #include "../patterns/model_manager.hpp"
+#include "../patterns/vertex_baker.hpp"
 
 namespace s21 {
 
@@ -27,8 +31,22 @@ namespace s21 {
  * Реализует паттерн Controller из архитектуры MVC. Отвечает за:
  * - Загрузку 3D-моделей
  * - Получение информации о модели
- * - Выполнение трансформаций модели через паттерн Command
+ * - Выполнение трансформаций модели через паттерн Command с отменой
  * - Обработку ошибок
+ *
+ * Вершины текущей модели могут пересчитываться в фоновом потоке
+ * (ApplyTransformStateAsync); методы, которые читают или меняют вершины
+ * и саму модель, сначала дожидаются пересчёта.
+ *
+ * Итоговое преобразование модели - шаги команд (TranslateModel() и др.,
+ * с отменой) поверх абсолютного состояния (SetTransformState()): оба
+ * отсчитываются от исходных вершин модели, поэтому смена состояния
+ * не отбрасывает шаги команд, а команды не запекают состояние в исходные
+ * вершины. Состояние и история команд хранятся вместе с моделью
+ * (ModelManager::GetPlacement) и восстанавливаются, когда модель снова
+ * становится текущей. TranslateModel() и др. меняют модель сразу, а
+ * QueueTranslate() и др. откладывают команды до FlushCommands(), чтобы
+ * объединить их в один шаг истории.
  */
 class Controller {
  public:
@@ -38,7 +56,8 @@ class Controller {
    * @param model_manager Ссылка на менеджер моделей (Singleton).
    */
   explicit Controller(ModelManager& model_manager)
-      : model_manager_(model_manager) {}
+      : model_manager_(model_manager),
+        commands_([this](const Matrix4&) { ApplyCurrentTransform(); }) {}
 
   /**
    * @brief Загружает 3D-модель из файла.
@@ -50,9 +69,58 @@ class Controller {
    * @return true если загрузка успешна, false в случае ошибки.
    */
   bool LoadModelFromFile(const std::string& path) {
+    LeaveCurrentModel();
     return model_manager_.LoadModel(path);
   }
 
+  /**
+   * @brief Запускает загрузку модели в фоновом потоке.
+   *
+   * Текущая модель остаётся доступной и не меняется до вызова
+   * FinishAsyncLoad(). Колбэки вызываются в фоновом потоке.
+   *
+   * @param path Путь к файлу модели (.obj).
+   * @param progress Вызывается по мере разбора файла.
+   * @param done Вызывается, когда результат готов к FinishAsyncLoad().
+   */
+  void LoadModelFromFileAsync(const std::string& path,
+                              AsyncLoader::ProgressCallback progress,
+                              AsyncLoader::DoneCallback done) {
+    loader_.Start(path, std::move(progress), std::move(done),
+                  model_manager_.GetMeshCache(), model_manager_.GetLoadMode());
+  }
+
+  /**
+   * @brief Отменяет фоновую загрузку, если она идёт.
+   */
+  void CancelAsyncLoad() { loader_.Cancel(); }
+
+  /**
+   * @brief Завершает фоновую загрузку.
+   *
+   * При успехе загруженная модель становится текущей; при ошибке или отмене
+   * текущая модель не меняется. Вызывается из потока, который отображает
+   * модель, так как старая модель при замене удаляется.
+   *
+   * @param error Сюда записывается описание ошибки при неудаче.
+   * @return true если новая модель стала текущей.
+   */
+  bool FinishAsyncLoad(std::string& error) {
+    std::unique_ptr<Model> model;
+    const bool loaded = loader_.TakeResult(model);
+    if (!model) {
+      error = "Модель не загружена";
+      return false;
+    }
+    if (!loaded) {
+      error = model->GetLastErrorString();
+      return false;
+    }
+    LeaveCurrentModel();
+    model_manager_.SetModel(std::move(model));
+    return true;
+  }
+
   /**
    * @brief Получает количество вершин в текущей модели.
    *
@@ -84,47 +152,344 @@ class Controller {
   }
 
   /**
-   * @brief Выполняет перемещение модели.
+   * @brief Перемещает модель.
    *
-   * Создаёт и выполняет команду перемещения через паттерн Command.
+   * Команда выполняется сразу (вместе с уже поставленными в очередь) и
+   * становится шагом истории.
    *
    * @param dx Смещение по оси X.
    * @param dy Смещение по оси Y.
    * @param dz Смещение по оси Z.
    */
   void TranslateModel(double dx, double dy, double dz) {
-    s21::MoveCommand cmd(dx, dy, dz);
-    cmd.Execute();
+    QueueTranslate(dx, dy, dz);
+    FlushCommands();
   }
 
   /**
-   * @brief Выполняет поворот модели.
+   * @brief Поворачивает модель.
    *
-   * Создаёт и выполняет команду поворота через паттерн Command.
+   * Команда выполняется сразу, как в TranslateModel().
    *
    * @param angle_x Угол поворота вокруг оси X в градусах.
    * @param angle_y Угол поворота вокруг оси Y в градусах.
    * @param angle_z Угол поворота вокруг оси Z в градусах.
    */
   void RotateModel(double angle_x, double angle_y, double angle_z) {
-    RotateCommand cmd(angle_x, angle_y, angle_z);
-    cmd.Execute();
+    QueueRotate(angle_x, angle_y, angle_z);
+    FlushCommands();
   }
 
   /**
-   * @brief Выполняет масштабирование модели.
+   * @brief Масштабирует модель.
    *
-   * Создаёт и выполняет команду масштабирования через паттерн Command.
+   * Команда выполняется сразу, как в TranslateModel().
    *
    * @param factor Коэффициент масштабирования.
    */
   void ScaleModel(double factor) {
-    ScaleCommand cmd(factor);
-    cmd.Execute();
+    QueueScale(factor);
+    FlushCommands();
+  }
+
+  /**
+   * @brief Ставит в очередь перемещение модели.
+   *
+   * Модель изменится при FlushCommands(); перемещения подряд объединяются
+   * в одно.
+   *
+   * @param dx Смещение по оси X.
+   * @param dy Смещение по оси Y.
+   * @param dz Смещение по оси Z.
+   */
+  void QueueTranslate(double dx, double dy, double dz) {
+    commands_.Push(std::make_unique<MoveCommand>(dx, dy, dz));
   }
 
+  /**
+   * @brief Ставит в очередь поворот модели.
+   *
+   * Модель изменится при FlushCommands(); повороты подряд вокруг одной оси
+   * объединяются в один.
+   *
+   * @param angle_x Угол поворота вокруг оси X в градусах.
+   * @param angle_y Угол поворота вокруг оси Y в градусах.
+   * @param angle_z Угол поворота вокруг оси Z в градусах.
+   */
+  void QueueRotate(double angle_x, double angle_y, double angle_z) {
+    commands_.Push(std::make_unique<RotateCommand>(angle_x, angle_y, angle_z));
+  }
+
+  /**
+   * @brief Ставит в очередь масштабирование модели.
+   *
+   * Модель изменится при FlushCommands(); масштабирования подряд
+   * объединяются в одно.
+   *
+   * @param factor Коэффициент масштабирования.
+   */
+  void QueueScale(double factor) {
+    commands_.Push(std::make_unique<ScaleCommand>(factor));
+  }
+
+  /**
+   * @brief Выполняет команды из очереди одним изменением модели.
+   *
+   * Модель получает итоговое преобразование заново (см. описание класса),
+   * вместе с ещё не применённым состоянием SetTransformState().
+   *
+   * @return true если модель изменилась.
+   */
+  bool FlushCommands() {
+    if (commands_.HasPending()) baker_.Wait();
+    return commands_.Flush();
+  }
+
+  /**
+   * @brief Отменяет последний шаг трансформации.
+   *
+   * @return true если шаг отменён.
+   */
+  bool Undo() {
+    baker_.Wait();
+    return commands_.Undo();
+  }
+
+  /**
+   * @brief Повторяет последний отменённый шаг трансформации.
+   *
+   * @return true если шаг повторён.
+   */
+  bool Redo() {
+    baker_.Wait();
+    return commands_.Redo();
+  }
+
+  /**
+   * @brief Проверяет, есть ли шаги для отмены.
+   */
+  bool CanUndo() const {
+    return commands_.GetUndoCount() > 0 || commands_.HasPending();
+  }
+
+  /**
+   * @brief Проверяет, есть ли шаги для повтора.
+   */
+  bool CanRedo() const { return commands_.GetRedoCount() > 0; }
+
+  /**
+   * @brief Возвращает абсолютное состояние трансформации текущей модели.
+   *
+   * @return Состояние, сохранённое вместе с моделью (исходное, если модель
+   * не загружена).
+   */
+  const TransformState& GetTransformState() const {
+    static const TransformState kInitial;
+    const auto* placement = model_manager_.GetPlacement();
+    return placement ? placement->state : kInitial;
+  }
+
+  /**
+   * @brief Устанавливает абсолютное состояние трансформации текущей модели.
+   *
+   * Модель не меняется до ApplyTransformState(), поэтому частые изменения
+   * (перетаскивание слайдера) объединяются в одно вычисление. Без
+   * загруженной модели состояние не сохраняется.
+   *
+   * @param state Перенос, поворот и масштаб относительно исходной модели.
+   */
+  void SetTransformState(const TransformState& state) {
+    if (auto* placement = model_manager_.GetPlacement()) {
+      placement->state = state;
+    }
+    transform_pending_ = true;
+  }
+
+  /**
+   * @brief Применяет отложенное состояние трансформации к текущей модели.
+   *
+   * Матрица строится заново из шагов команд и состояния: в режиме
+   * TransformMode::kMatrix она заменяет матрицу модели (вершины не
+   * трогаются), в режиме kBake вершины пересчитываются из исходных
+   * (Model::SetVertexTransform).
+   *
+   * @return true если модель изменилась; false если изменений не было.
+   */
+  bool ApplyTransformState() {
+    if (!transform_pending_) return false;
+    return ApplyCurrentTransform();
+  }
+
+  /**
+   * @brief Применяет отложенное состояние, не дожидаясь пересчёта вершин.
+   *
+   * В режиме TransformMode::kMatrix совпадает с ApplyTransformState(). В
+   * режиме kBake вершины пересчитываются в фоновом потоке (VertexBaker), а
+   * результат появляется в GetVertexBaker().GetSnapshots(); состояния,
+   * заданные во время пересчёта, объединяются в один следующий пересчёт.
+   *
+   * @return true если модель изменилась или изменится.
+   */
+  bool ApplyTransformStateAsync() {
+    if (model_manager_.GetTransformMode() == TransformMode::kMatrix) {
+      return ApplyTransformState();
+    }
+    if (!transform_pending_) return false;
+    transform_pending_ = false;
+    auto* model = model_manager_.GetModel();
+    if (!model) return false;
+
+    baker_.Request(*model, GetCurrentTransform());
+    return true;
+  }
+
+  /**
+   * @brief Возвращает фоновый пересчёт вершин.
+   *
+   * GUI получает из него снимки вершин и узнаёт, занята ли модель.
+   */
+  VertexBaker& GetVertexBaker() { return baker_; }
+
+  /**
+   * @brief Устанавливает способ применения трансформаций.
+   *
+   * Вершины текущей модели возвращаются к исходным, и итоговое
+   * преобразование применяется в новом режиме, поэтому оно не
+   * применяется дважды.
+   *
+   * @param mode kBake - переписывать вершины, kMatrix - накапливать матрицу.
+   */
+  void SetTransformMode(TransformMode mode) {
+    baker_.Wait();
+    if (mode == model_manager_.GetTransformMode()) return;
+    if (auto* model = model_manager_.GetModel()) {
+      model->SetTransform(Matrix4::Identity());
+      model->SetVertexTransform(Matrix4::Identity());
+    }
+    model_manager_.SetTransformMode(mode);
+    ApplyCurrentTransform();
+  }
+
+  /**
+   * @brief Применяет накопленную матрицу к вершинам текущей модели.
+   *
+   * Нужен перед операциями, которым требуются итоговые координаты вершин
+   * (например, экспорт модели). Исходные вершины сохраняются
+   * (Model::SetVertexTransform): следующие состояния и команды
+   * отсчитываются от них, а не от запечённых.
+   */
+  void BakeTransform() {
+    baker_.Wait();
+    auto* model = model_manager_.GetModel();
+    if (!model || model->GetTransform().IsIdentity()) return;
+    const Matrix4 transform = model->GetTransform();
+    model->SetTransform(Matrix4::Identity());
+    model->SetVertexTransform(transform);
+  }
+
+  /**
+   * @brief Делает текущей модель, которая уже загружена в память.
+   *
+   * Модель возвращается в своём положении (GetTransformState()).
+   *
+   * @param path Путь к файлу модели.
+   * @return true если модель была в памяти и файл с тех пор не менялся;
+   * иначе модель нужно загрузить заново.
+   */
+  bool SelectResidentModel(const std::string& path) {
+    LeaveCurrentModel();
+    return model_manager_.SelectModel(path);
+  }
+
+  /**
+   * @brief Пути моделей в памяти, от недавно использованной к давней.
+   */
+  std::vector<std::string> GetResidentModels() const {
+    return model_manager_.GetResidentPaths();
+  }
+
+  /**
+   * @brief Задаёт число экземпляров текущей модели в сцене.
+   *
+   * Модели сцены рисуются вместо одной текущей модели; команды
+   * трансформации по-прежнему применяются к текущей модели и меняют все её
+   * экземпляры.
+   *
+   * @param count Число экземпляров (0 - убрать модель из сцены).
+   */
+  void SetSceneInstances(uint32_t count) {
+    if (auto* model = model_manager_.GetModel()) {
+      model_manager_.GetScene().SetInstanceCount(model, count);
+    }
+  }
+
+  /**
+   * @brief Возвращает число экземпляров текущей модели в сцене.
+   */
+  uint32_t GetSceneInstances() const {
+    return model_manager_.GetScene().GetInstanceCount(
+        model_manager_.GetModel());
+  }
+
+  /**
+   * @brief Убирает из сцены все модели.
+   */
+  void ClearScene() { model_manager_.GetScene().Clear(); }
+
+  /**
+   * @brief Возвращает сцену из нескольких моделей.
+   */
+  const Scene& GetScene() const { return model_manager_.GetScene(); }
+
  private:
+  /**
+   * @brief Итоговое преобразование: шаги команд поверх состояния.
+   */
+  Matrix4 GetCurrentTransform() {
+    return commands_.GetTransform() * GetTransformState().ToMatrix();
+  }
+
+  /**
+   * @brief Завершает изменения текущей модели перед сменой текущей модели.
+   *
+   * Отложенные команды и состояние применяются к модели, с которой
+   * сохранены, чтобы при возврате к ней вершины соответствовали её
+   * положению и истории.
+   */
+  void LeaveCurrentModel() {
+    FlushCommands();
+    ApplyTransformState();
+    baker_.Wait();
+  }
+
+  /**
+   * @brief Применяет итоговое преобразование к текущей модели.
+   *
+   * @return true если модель загружена.
+   */
+  bool ApplyCurrentTransform() {
+    transform_pending_ = false;
+    auto* model = model_manager_.GetModel();
+    if (!model) return false;
+
+    ScopedTimer timer("command.absolute");
+    const Matrix4 matrix = GetCurrentTransform();
+    if (model_manager_.GetTransformMode() == TransformMode::kMatrix) {
+      // Вершины, запечённые BakeTransform(), возвращаются к исходным
+      model->SetVertexTransform(Matrix4::Identity());
+      model->SetTransform(matrix);
+    } else {
+      baker_.Wait();
+      model->SetVertexTransform(matrix);
+    }
+    return true;
+  }
+
   ModelManager& model_manager_;  ///< Ссылка на менеджер моделей (Singleton)
+  AsyncLoader loader_;           ///< Фоновая загрузка модели
+  CommandQueue commands_;        ///< Очередь команд и история отмены
+  VertexBaker baker_;            ///< Пересчёт вершин в фоновом потоке
+  bool transform_pending_ = false;  ///< Состояние ещё не применено
 };
 
 }  // namespace s21
@@ -1,35 +1,405 @@
 #include "glwidget.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "../model/metrics.hpp"
+#include "shaders.h"
+
+// Массивы модели загружаются в буферы как есть, без перепаковки
+static_assert(sizeof(s21::Vertex) == 3 * sizeof(GLfloat));
+static_assert(sizeof(s21::Edge) == 2 * sizeof(GLuint));
+static_assert(sizeof(s21::Matrix4) == 16 * sizeof(GLfloat));
+
+/// Задержка сохранения настроек после последнего изменения, мс
+constexpr int kSaveDelayMs = 500;
+
+/// Интервал таймера в режиме RenderMode::kContinuous, мс (~60 FPS)
+constexpr int kFrameIntervalMs = 16;
+
+/// Наибольший размер ячейки уровня детализации на экране, пикселей
+constexpr float kLodMaxCellPixels = 1.0f;
+
+/// Узлы иерархии не мельче этого числа рёбер не раскрываются при отсечении:
+/// лишние рёбра на границе дешевле лишних вызовов отрисовки
+constexpr uint32_t kCullMinEdges = 4096;
+
+/// Наибольшее расстояние от курсора до выбираемого элемента, пикселей
+constexpr float kPickRadiusPixels = 6.0f;
+
+/// Сдвиг мыши между нажатием и отпусканием, который ещё считается щелчком
+constexpr int kClickMaxDistance = 4;
+
+/// Цвет выделения выбранного элемента
+constexpr Colors kPickColor{1.0f, 0.8f, 0.0f};
+
+/// Атрибут с координатами вершины в шейдерах
+constexpr int kPositionAttribute = 0;
+
+/// Первый из четырёх атрибутов матрицы экземпляра (по столбцу в каждом)
+constexpr int kInstanceAttribute = 1;
+
+/// Длина штриха и пропуска пунктира, пикселей (как glLineStipple(2, 0x00FF))
+constexpr float kDashPixels = 16.0f;
+
 /**
  * @brief Конструктор виджета OpenGL
  * @param parent Родительский виджет (обычно MainWindow)
  *
- * Инициализирует таймер для регулярного обновления (анимации),
- * подключает слот onTimer к сигналу таймера и включает отслеживание мыши.
+ * Подключает слот onTimer к таймеру непрерывной отрисовки (таймер
+ * запускается только в режиме RenderMode::kContinuous) и загружает настройки.
  */
 GLWidget::GLWidget(QWidget* parent)
-    : QOpenGLWidget(parent), timer_(new QTimer(this)) {
+    : QOpenGLWidget(parent),
+      capture_timer_(new QTimer(this)),
+      save_timer_(new QTimer(this)),
+      timer_(new QTimer(this)) {
   // Подключаем таймер: каждый раз, когда он срабатывает — вызываем onTimer
   connect(timer_, &QTimer::timeout, this, &GLWidget::onTimer);
-  timer_->start(16);  // Запускаем таймер с интервалом ~16 мс (~60 FPS)
-  settings_ = new QSettings(config_path_, QSettings::IniFormat);
+  timer_->setInterval(kFrameIntervalMs);
+
+  save_timer_->setSingleShot(true);
+  save_timer_->setInterval(kSaveDelayMs);
+  connect(save_timer_, &QTimer::timeout, this, &GLWidget::saveConfig);
+
+  connect(capture_timer_, &QTimer::timeout, this, [this] { update(); });
+
+  settings_ = new QSettings(config_path_, QSettings::IniFormat, this);
   loadConfig();
 }
 
+GLWidget::~GLWidget() {
+  save_timer_->stop();
+  saveConfig();
+
+  makeCurrent();
+  for (QOpenGLTimerQuery& query : gpu_queries_) query.destroy();
+  vertex_buffer_.destroy();
+  index_buffer_.destroy();
+  pick_buffer_.destroy();
+  for (QOpenGLBuffer& buffer : pack_buffers_) buffer.destroy();
+  destroyLodBuffers();
+  destroySceneBuffers();
+  doneCurrent();
+}
+
 /**
  * @brief Устанавливает данные модели для отрисовки
  * @param vertices Вершины модели
  * @param edges Рёбра модели (пары индексов вершин)
+ * @param bvh Иерархия над рёбрами (может отсутствовать)
  *
- * Копирует данные модели и нормализует её положение и масштаб,
- * чтобы она хорошо помещалась в поле зрения. После этого обновляет отображение.
+ * Запоминает указатели на данные модели (без копирования) и сбрасывает
+ * матрицу модели, уровни детализации и выбор мышью. Загрузка в буферы
+ * OpenGL откладывается до ближайшей отрисовки.
  */
-void GLWidget::setModelData(
-    const std::vector<s21::Vertex>* vertices,
-    const std::vector<std::pair<size_t, size_t>> edges) {
+void GLWidget::setModelData(const std::vector<s21::Vertex>* vertices,
+                            const std::vector<s21::Edge>* edges,
+                            const s21::Bvh* bvh) {
   vertices_ = vertices;
   edges_ = edges;
-  update();  // Перерисовать
+  bvh_ = bvh;
+  // Снимок, оставшийся от прежней модели, ей и принадлежит
+  if (baker_) baker_->GetSnapshots().Consume();
+  pick_ = s21::PickResult();
+  model_matrix_ = s21::Matrix4::Identity();
+  vertices_dirty_ = true;
+  edges_dirty_ = true;
+  // Модель из памяти могла быть запечена при выборе
+  for (SceneBuffers& buffers : scene_buffers_) {
+    if (buffers.source == vertices) buffers.vertices_dirty = true;
+  }
+  setLodSet(s21::LodSet());  // Перерисовать
+}
+
+/**
+ * @brief Сообщает виджету, что координаты вершин изменились.
+ *
+ * Уровни детализации построены по старым вершинам и сбрасываются. Если
+ * модель есть в сцене, перезагружается и её вершинный буфер сцены.
+ */
+void GLWidget::updateVertices() {
+  vertices_dirty_ = true;
+  for (SceneBuffers& buffers : scene_buffers_) {
+    if (buffers.source == vertices_) buffers.vertices_dirty = true;
+  }
+  setLodSet(s21::LodSet());
+}
+
+/**
+ * @brief Устанавливает сцену из нескольких моделей
+ * @param scene Сцена или nullptr
+ *
+ * Буферы сцены загружаются при ближайшей отрисовке.
+ */
+void GLWidget::setScene(const s21::Scene* scene) {
+  scene_ = scene;
+  scene_uploaded_ = false;
+  update();
+}
+
+/**
+ * @brief Устанавливает матрицу модели
+ * @param matrix Матрица модели в порядке столбцов
+ */
+void GLWidget::setModelMatrix(const s21::Matrix4& matrix) {
+  model_matrix_ = matrix;
+  update();
+}
+
+/**
+ * @brief Устанавливает уровни детализации текущей модели
+ * @param lod Уровни, построенные по данным из setModelData()
+ */
+void GLWidget::setLodSet(s21::LodSet lod) {
+  lod_ = std::move(lod);
+  lod_dirty_ = true;
+  update();
+}
+
+/**
+ * @brief Выбирает уровень детализации по размеру модели на экране.
+ *
+ * Ортографическая проекция отображает [-1, 1] на ширину и высоту виджета;
+ * берётся большая из сторон, а масштаб матрицы модели - по длине её первого
+ * столбца. В центральной проекции модель на экране меньше этой оценки, так
+ * что выбранный уровень не грубее нужного.
+ */
+int GLWidget::selectLodLevel() const {
+  if (lod_buffers_.empty()) return -1;
+
+  const s21::Matrix4& m = model_matrix_;
+  const float matrix_scale =
+      std::sqrt(m(0, 0) * m(0, 0) + m(1, 0) * m(1, 0) + m(2, 0) * m(2, 0));
+  const float pixels_per_unit = static_cast<float>(
+      std::max(width(), height()) * devicePixelRatioF() / 2.0);
+  const float pixel_extent =
+      lod_.extent * scale_ * matrix_scale * pixels_per_unit;
+  return lod_.SelectLevel(pixel_extent, kLodMaxCellPixels);
+}
+
+/**
+ * @brief Освобождает буферы уровней детализации.
+ */
+void GLWidget::destroyLodBuffers() {
+  for (LodBuffers& buffers : lod_buffers_) {
+    buffers.vertices.destroy();
+    buffers.indices.destroy();
+  }
+  lod_buffers_.clear();
+}
+
+/**
+ * @brief Освобождает буферы моделей сцены.
+ */
+void GLWidget::destroySceneBuffers() {
+  for (SceneBuffers& buffers : scene_buffers_) {
+    buffers.vertices.destroy();
+    buffers.indices.destroy();
+    buffers.instances.destroy();
+  }
+  scene_buffers_.clear();
+}
+
+/**
+ * @brief Устанавливает режим перерисовки
+ * @param mode kOnDemand - по изменениям, kContinuous - по таймеру
+ */
+void GLWidget::setRenderMode(RenderMode mode) {
+  render_mode_ = mode;
+  if (mode == RenderMode::kContinuous) {
+    timer_->start();
+  } else {
+    timer_->stop();
+  }
+  update();
+}
+
+/**
+ * @brief Загружает изменившиеся данные модели в буферы OpenGL.
+ *
+ * Буфер пересоздаётся, только если изменился его размер; иначе данные
+ * перезаписываются на месте.
+ */
+void GLWidget::uploadBuffers() {
+  // Вершины, пересчитанные в фоне, приходят снимком. Пока пересчёт идёт,
+  // массив модели меняется в другом потоке и не читается
+  const bool busy = isModelBusy();
+  const s21::GeometrySnapshot* snapshot =
+      baker_ ? baker_->GetSnapshots().Consume() : nullptr;
+  if (snapshot && vertices_ && snapshot->vertices.size() == vertices_->size()) {
+    uploadVertexBuffer(snapshot->vertices.data(),
+                       static_cast<GLsizei>(snapshot->vertices.size()));
+    for (SceneBuffers& buffers : scene_buffers_) {
+      if (buffers.source == vertices_) buffers.vertices_dirty = true;
+    }
+  }
+
+  if (vertices_dirty_ && !busy) {
+    vertices_dirty_ = false;
+    uploadVertexBuffer(vertices_ ? vertices_->data() : nullptr,
+                       vertices_ ? static_cast<GLsizei>(vertices_->size())
+                                 : 0);
+  }
+
+  if (edges_dirty_ && !busy) {
+    edges_dirty_ = false;
+    index_count_ = edges_ ? static_cast<GLsizei>(edges_->size() * 2) : 0;
+    const int bytes = index_count_ * static_cast<int>(sizeof(GLuint));
+    bvh_order_ = bvh_ && edges_ && !bvh_->IsEmpty() &&
+                 bvh_->GetOrder().size() == edges_->size();
+
+    // Рёбра одного узла иерархии должны лежать в IBO подряд
+    std::vector<s21::Edge> ordered;
+    if (bvh_order_) {
+      ordered.reserve(edges_->size());
+      for (uint32_t index : bvh_->GetOrder()) {
+        ordered.push_back((*edges_)[index]);
+      }
+    }
+    const s21::Edge* data = bvh_order_ ? ordered.data()
+                            : edges_   ? edges_->data()
+                                       : nullptr;
+
+    upload_bytes_ += bytes;
+    if (!index_buffer_.isCreated()) index_buffer_.create();
+    index_buffer_.bind();
+    index_buffer_.allocate(index_count_ ? data : nullptr, bytes);
+    index_buffer_.release();
+  }
+
+  if (lod_dirty_) {
+    lod_dirty_ = false;
+    destroyLodBuffers();
+    lod_buffers_.resize(lod_.levels.size());
+    for (size_t i = 0; i < lod_.levels.size(); ++i) {
+      s21::LodLevel& level = lod_.levels[i];
+      LodBuffers& buffers = lod_buffers_[i];
+      buffers.vertex_count = static_cast<GLsizei>(level.vertices.size());
+      buffers.index_count = static_cast<GLsizei>(level.edges.size() * 2);
+      const int vertex_bytes =
+          buffers.vertex_count * static_cast<int>(sizeof(s21::Vertex));
+      const int index_bytes =
+          buffers.index_count * static_cast<int>(sizeof(GLuint));
+
+      buffers.vertices.create();
+      buffers.vertices.bind();
+      buffers.vertices.allocate(level.vertices.data(), vertex_bytes);
+      buffers.vertices.release();
+      buffers.indices.create();
+      buffers.indices.bind();
+      buffers.indices.allocate(level.edges.data(), index_bytes);
+      buffers.indices.release();
+      upload_bytes_ += vertex_bytes + index_bytes;
+
+      // Для выбора уровня достаточно grid, данные теперь в видеопамяти
+      level.vertices = std::vector<s21::Vertex>();
+      level.edges = std::vector<s21::Edge>();
+    }
+  }
+}
+
+/**
+ * @brief Загружает вершины текущей модели в VBO
+ * @param data Вершины
+ * @param count Количество вершин
+ *
+ * Буфер того же размера перезаписывается на месте.
+ */
+void GLWidget::uploadVertexBuffer(const s21::Vertex* data, GLsizei count) {
+  vertex_count_ = count;
+  const int bytes = vertex_count_ * static_cast<int>(sizeof(s21::Vertex));
+
+  if (!vertex_buffer_.isCreated()) vertex_buffer_.create();
+  vertex_buffer_.bind();
+  upload_bytes_ += bytes;
+  if (vertex_count_ > 0 && vertex_buffer_.size() == bytes) {
+    vertex_buffer_.write(0, data, bytes);
+  } else {
+    vertex_buffer_.allocate(vertex_count_ ? data : nullptr, bytes);
+  }
+  vertex_buffer_.release();
+}
+
+/**
+ * @brief Загружает в буферы модели сцены, изменившиеся с прошлого кадра.
+ *
+ * Буферы сопоставляются с моделями сцены по SceneModel::id: у модели,
+ * оставшейся в сцене, перезаписываются только матрицы экземпляров (или
+ * вершины после updateVertices), у новой загружается всё, а буферы
+ * удалённых моделей освобождаются.
+ */
+void GLWidget::uploadSceneBuffers() {
+  const bool changed = !scene_uploaded_ || !scene_ ||
+                       scene_->GetVersion() != scene_version_;
+  if (changed) {
+    scene_uploaded_ = true;
+    scene_version_ = scene_ ? scene_->GetVersion() : 0;
+
+    std::vector<SceneBuffers> previous = std::move(scene_buffers_);
+    scene_buffers_.clear();
+    const std::vector<s21::SceneModel> empty;
+    const auto& models = scene_ ? scene_->GetModels() : empty;
+    for (const s21::SceneModel& entry : models) {
+      auto it = std::find_if(
+          previous.begin(), previous.end(),
+          [&entry](const SceneBuffers& buffers) {
+            return buffers.id == entry.id;
+          });
+      if (it != previous.end()) {
+        scene_buffers_.push_back(*it);
+        it->id = 0;  // Буферы перешли в новый список
+      } else {
+        SceneBuffers buffers;
+        buffers.id = entry.id;
+        buffers.source = &entry.model->GetVertices();
+        const std::vector<s21::Edge>& edges = entry.model->GetEdges();
+        buffers.index_count = static_cast<GLsizei>(edges.size() * 2);
+        const int bytes =
+            buffers.index_count * static_cast<int>(sizeof(GLuint));
+        buffers.vertices.create();
+        buffers.instances.create();
+        buffers.indices.create();
+        buffers.indices.bind();
+        buffers.indices.allocate(edges.empty() ? nullptr : edges.data(),
+                                 bytes);
+        buffers.indices.release();
+        upload_bytes_ += bytes;
+        scene_buffers_.push_back(buffers);
+      }
+
+      // Расположение экземпляров меняется вместе с составом сцены
+      QOpenGLBuffer& instances = scene_buffers_.back().instances;
+      const int bytes = static_cast<int>(entry.instances.size() *
+                                         sizeof(s21::Matrix4));
+      instances.bind();
+      instances.allocate(entry.instances.data(), bytes);
+      instances.release();
+      upload_bytes_ += bytes;
+    }
+
+    for (SceneBuffers& buffers : previous) {
+      if (buffers.id == 0) continue;
+      buffers.vertices.destroy();
+      buffers.indices.destroy();
+      buffers.instances.destroy();
+    }
+  }
+
+  const bool busy = isModelBusy();
+  for (SceneBuffers& buffers : scene_buffers_) {
+    if (!buffers.vertices_dirty) continue;
+    if (busy && buffers.source == vertices_) continue;  // См. uploadBuffers
+    buffers.vertices_dirty = false;
+    buffers.vertex_count = static_cast<GLsizei>(buffers.source->size());
+    const int bytes =
+        buffers.vertex_count * static_cast<int>(sizeof(s21::Vertex));
+    buffers.vertices.bind();
+    buffers.vertices.allocate(
+        buffers.vertex_count ? buffers.source->data() : nullptr, bytes);
+    buffers.vertices.release();
+    upload_bytes_ += bytes;
+  }
 }
 
 /**
@@ -43,12 +413,82 @@ void GLWidget::initializeGL() {
   this->initializeOpenGLFunctions();  // Инициализация функций OpenGL
 
   // Устанавливаем цвет очистки буфера (фон)
-  glClearColor(settings_->value("background_red_").toFloat(),
-               settings_->value("background_green_").toFloat(),
-               settings_->value("background_blue_").toFloat(), 1.0f);
+  const Colors& background = state_.background_color;
+  glClearColor(background.r, background.g, background.b, 1.0f);
 
   glEnable(GL_DEPTH_TEST);  // Включаем буфер глубины
   glDepthFunc(GL_LESS);  // Глубина: чем меньше значение, тем ближе
+
+  // Время GPU (нужен GL 3.3 или GL_ARB_timer_query)
+  gpu_timing_ = true;
+  for (QOpenGLTimerQuery& query : gpu_queries_) {
+    gpu_timing_ = gpu_timing_ && query.create();
+  }
+
+  // Размер точки задаёт gl_PointSize; в профиле совместимости gl_PointCoord
+  // определён только для спрайтов точек
+  shaders_ = initShaders();
+  if (shaders_ && !context()->isOpenGLES()) {
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    if (context()->format().profile() != QSurfaceFormat::CoreProfile) {
+      glEnable(GL_POINT_SPRITE);
+    }
+  }
+
+  // Делитель атрибутов (glVertexAttribDivisor) - OpenGL 3.3 и OpenGL ES 3.0
+  const QSurfaceFormat format = context()->format();
+  instancing_ = shaders_ && (context()->isOpenGLES() ||
+                             format.majorVersion() > 3 ||
+                             (format.majorVersion() == 3 &&
+                              format.minorVersion() >= 3));
+
+  // Чтение кадров записи через PBO: glMapBufferRange - OpenGL 3.0 и
+  // OpenGL ES 3.0
+  pack_buffers_supported_ = format.majorVersion() >= 3;
+}
+
+/**
+ * @brief Собирает шейдерные программы вершин и рёбер.
+ */
+bool GLWidget::initShaders() {
+  const QOpenGLContext* gl = context();
+  const QSurfaceFormat format = gl->format();
+  QByteArray header;
+  if (gl->isOpenGLES()) {
+    if (format.majorVersion() < 3) return false;
+    header = "#version 300 es\nprecision highp float;\n";
+  } else if (format.profile() == QSurfaceFormat::CoreProfile) {
+    header = "#version 150\n";
+  } else {
+    if (format.majorVersion() < 3) return false;
+    header = "#version 130\n";
+  }
+
+  auto build = [&header](ShaderProgram& shader, const char* vertex,
+                         const char* fragment) {
+    QOpenGLShaderProgram& program = shader.program;
+    if (!program.addShaderFromSourceCode(QOpenGLShader::Vertex,
+                                         header + vertex) ||
+        !program.addShaderFromSourceCode(QOpenGLShader::Fragment,
+                                         header + fragment)) {
+      return false;
+    }
+    program.bindAttributeLocation("position", kPositionAttribute);
+    program.bindAttributeLocation("instance", kInstanceAttribute);
+    if (!program.link()) return false;
+
+    shader.mvp = program.uniformLocation("mvp");
+    shader.model = program.uniformLocation("model");
+    shader.color = program.uniformLocation("color");
+    shader.point_size = program.uniformLocation("point_size");
+    shader.round = program.uniformLocation("round_points");
+    shader.viewport = program.uniformLocation("viewport");
+    shader.dash = program.uniformLocation("dash");
+    return true;
+  };
+  return build(point_program_, shaders::kPointVertex,
+               shaders::kPointFragment) &&
+         build(line_program_, shaders::kLineVertex, shaders::kLineFragment);
 }
 
 /**
@@ -70,16 +510,257 @@ void GLWidget::resizeGL(int w, int h) {
                  100.0);  // Дальняя плоскость отсечения
 }
 
+/**
+ * @brief Отрисовка кадра
+ *
+ * Рисует сцену и записывает показатели кадра в s21::Metrics: интервал
+ * между кадрами, время CPU и GPU, число вызовов отрисовки и объём
+ * загруженных данных.
+ */
+void GLWidget::paintGL() {
+  ++frame_count_;
+  auto& metrics = s21::Metrics::GetInstance();
+  if (frame_interval_.isValid()) {
+    metrics.Record("frame.interval", frame_interval_.nsecsElapsed() / 1e6);
+  }
+  frame_interval_.restart();
+
+  draw_calls_ = 0;
+  upload_bytes_ = 0;
+  collectGpuTimes();
+
+  const size_t query = frame_count_ % kGpuQueries;
+  const bool time_gpu = gpu_timing_ && !gpu_pending_[query];
+  auto render = [&] {
+    if (time_gpu) gpu_queries_[query].begin();
+    {
+      s21::ScopedTimer timer("frame.cpu");
+      renderScene();
+    }
+    if (time_gpu) gpu_queries_[query].end();
+    // Кадр записи берётся до статистики поверх сцены
+    if (recorder_) captureFrame();
+  };
+
+  if (overlay_visible_) {
+    QPainter painter(this);
+    painter.beginNativePainting();
+    render();
+    painter.endNativePainting();
+    drawOverlay(painter);
+  } else {
+    render();
+  }
+  gpu_pending_[query] = gpu_pending_[query] || time_gpu;
+
+  metrics.Record("frame.draw_calls", draw_calls_);
+  metrics.Record("frame.upload_bytes", static_cast<double>(upload_bytes_));
+}
+
+/**
+ * @brief Записывает время GPU завершённых кадров.
+ */
+void GLWidget::collectGpuTimes() {
+  for (size_t i = 0; i < kGpuQueries; ++i) {
+    if (gpu_pending_[i] && gpu_queries_[i].isResultAvailable()) {
+      gpu_pending_[i] = false;
+      s21::Metrics::GetInstance().Record(
+          "frame.gpu", gpu_queries_[i].waitForResult() / 1e6);  // нс -> мс
+    }
+  }
+}
+
+/**
+ * @brief Выводит статистику отрисовки поверх сцены.
+ */
+void GLWidget::drawOverlay(QPainter& painter) {
+  auto& metrics = s21::Metrics::GetInstance();
+  s21::MetricSummary interval, cpu, gpu, uploads;
+  metrics.GetSummary("frame.interval", interval);
+  metrics.GetSummary("frame.cpu", cpu);
+  const bool has_gpu = metrics.GetSummary("frame.gpu", gpu);
+  metrics.GetSummary("frame.upload_bytes", uploads);
+
+  QStringList lines;
+  // В режиме kOnDemand интервал отражает паузы между изменениями сцены
+  lines << QString("FPS: %1").arg(interval.p50 > 0 ? 1000.0 / interval.p50 : 0,
+                                  0, 'f', 1);
+  lines << QString("CPU, мс: p50 %1  p99 %2")
+               .arg(cpu.p50, 0, 'f', 2)
+               .arg(cpu.p99, 0, 'f', 2);
+  if (has_gpu) {
+    lines << QString("GPU, мс: p50 %1  p99 %2")
+                 .arg(gpu.p50, 0, 'f', 2)
+                 .arg(gpu.p99, 0, 'f', 2);
+  }
+  lines << QString("Вызовов отрисовки: %1").arg(draw_calls_);
+  lines << QString("Конвейер: %1").arg(shaders_ ? "шейдеры GLSL"
+                                                : "фиксированный");
+  const bool scene = scene_ && !scene_->IsEmpty();
+  if (scene) {
+    lines << QString("Сцена: моделей %1, экземпляров %2, рёбер %3")
+                 .arg(static_cast<qint64>(scene_->GetModels().size()))
+                 .arg(static_cast<qint64>(scene_->GetTotalInstances()))
+                 .arg(static_cast<qint64>(visible_edges_));
+  } else if (lod_level_ >= 0) {
+    const LodBuffers& level = lod_buffers_[static_cast<size_t>(lod_level_)];
+    lines << QString("LOD: сетка %1, рёбер %2")
+                 .arg(static_cast<int>(lod_.levels[lod_level_].grid))
+                 .arg(static_cast<int>(level.index_count / 2));
+  } else {
+    lines << QString("LOD: полная детализация");
+  }
+  if (!scene && lod_level_ < 0 && bvh_order_) {
+    lines << QString("Отсечение: рёбер %1 из %2")
+                 .arg(static_cast<qint64>(visible_edges_))
+                 .arg(static_cast<qint64>(index_count_ / 2));
+  }
+  lines << QString("Загружено: %1 КБ (всего %2 КБ)")
+               .arg(upload_bytes_ / 1024)
+               .arg(static_cast<qint64>(uploads.total) / 1024);
+  lines << QString("Кадров: %1").arg(frame_count_);
+
+  QFont font("Monospace");
+  font.setStyleHint(QFont::TypeWriter);
+  painter.setFont(font);
+  const int line_height = painter.fontMetrics().height();
+  const int line_count = static_cast<int>(lines.size());
+  painter.fillRect(QRect(4, 4, 260, line_height * line_count + 8),
+                   QColor(0, 0, 0, 160));
+  painter.setPen(QColor(255, 255, 0));
+  for (int i = 0; i < line_count; ++i) {
+    painter.drawText(10, 8 + line_height * (i + 1) - 2, lines[i]);
+  }
+}
+
+/**
+ * @brief Показывает или скрывает статистику отрисовки
+ * @param visible true - показывать
+ */
+void GLWidget::setOverlayVisible(bool visible) {
+  overlay_visible_ = visible;
+  update();
+}
+
+/**
+ * @brief Начинает передавать кадры в запись
+ * @param recorder Запущенная запись
+ *
+ * Таймер записи запрашивает кадр раз в интервал записи; кадры между его
+ * срабатываниями (от взаимодействия с моделью) не записываются.
+ */
+void GLWidget::startCapture(s21::FrameRecorder* recorder) {
+  stopCapture();
+  if (!recorder) return;
+  recorder_ = recorder;
+  const int fps = std::max(1, recorder->GetOptions().fps);
+  capture_interval_ns_ = 1'000'000'000LL / fps;
+  next_capture_ns_ = 0;
+  capture_clock_.start();
+  capture_timer_->start(1000 / fps);
+  update();
+}
+
+/**
+ * @brief Прекращает передавать кадры в запись
+ */
+void GLWidget::stopCapture() {
+  if (!recorder_) return;
+  capture_timer_->stop();
+  if (isValid()) {
+    makeCurrent();
+    submitPackBuffer(pack_index_ ^ 1);  // Последний прочитанный кадр
+    doneCurrent();
+  }
+  pack_sizes_ = {};
+  recorder_ = nullptr;
+}
+
+/**
+ * @brief Копирует кадр записи
+ *
+ * Вызывается из paintGL сразу после отрисовки сцены. Кадр копируется в
+ * один PBO, а из второго забирается кадр, прочитанный интервал записи
+ * назад: к этому времени GPU давно его скопировал, и отображение буфера не
+ * ждёт конвейер.
+ */
+void GLWidget::captureFrame() {
+  const qint64 now = capture_clock_.nsecsElapsed();
+  // Таймер может сработать чуть раньше срока
+  if (now + capture_interval_ns_ / 4 < next_capture_ns_) return;
+  next_capture_ns_ = std::max(next_capture_ns_ + capture_interval_ns_, now);
+  if (!recorder_->IsRecording()) return;
+
+  s21::ScopedTimer timer("capture.readback");
+  const qreal ratio = devicePixelRatioF();
+  const QSize size(qRound(width() * ratio), qRound(height() * ratio));
+  if (size.isEmpty()) return;
+
+  if (!pack_buffers_supported_) {
+    s21::CaptureFrame frame = recorder_->AcquireFrame();
+    frame.Resize(static_cast<uint32_t>(size.width()),
+                 static_cast<uint32_t>(size.height()));
+    glReadPixels(0, 0, size.width(), size.height(), GL_RGBA,
+                 GL_UNSIGNED_BYTE, frame.pixels.data());
+    recorder_->Submit(std::move(frame));
+    return;
+  }
+
+  QOpenGLBuffer& buffer = pack_buffers_[pack_index_];
+  const int bytes = size.width() * size.height() * 4;
+  if (!buffer.isCreated()) {
+    buffer.create();
+    buffer.setUsagePattern(QOpenGLBuffer::StreamRead);
+  }
+  buffer.bind();
+  if (buffer.size() != bytes) buffer.allocate(bytes);
+  // С привязанным PBO glReadPixels не ждёт GPU: последний аргумент -
+  // смещение в буфере
+  glReadPixels(0, 0, size.width(), size.height(), GL_RGBA, GL_UNSIGNED_BYTE,
+               nullptr);
+  buffer.release();
+  pack_sizes_[pack_index_] = size;
+
+  pack_index_ ^= 1;
+  submitPackBuffer(pack_index_);
+}
+
+/**
+ * @brief Передаёт записи кадр из PBO
+ * @param index Номер PBO
+ *
+ * Вызывается при активном контексте OpenGL. После вызова PBO свободен.
+ */
+void GLWidget::submitPackBuffer(size_t index) {
+  const QSize size = pack_sizes_[index];
+  if (size.isEmpty()) return;
+  pack_sizes_[index] = QSize();
+
+  QOpenGLBuffer& buffer = pack_buffers_[index];
+  const int bytes = size.width() * size.height() * 4;
+  buffer.bind();
+  const void* pixels = buffer.mapRange(0, bytes, QOpenGLBuffer::RangeRead);
+  if (pixels) {
+    s21::CaptureFrame frame = recorder_->AcquireFrame();
+    frame.Resize(static_cast<uint32_t>(size.width()),
+                 static_cast<uint32_t>(size.height()));
+    std::memcpy(frame.pixels.data(), pixels, frame.pixels.size());
+    buffer.unmap();
+    recorder_->Submit(std::move(frame));
+  }
+  buffer.release();
+}
+
 /**
  * @brief Отрисовка сцены
  *
  * Очищает экран, устанавливает камеру, применяет трансформации и рисует рёбра
  * модели.
  */
-void GLWidget::paintGL() {
-  glClearColor(settings_->value("background_red_").toFloat(),
-               settings_->value("background_green_").toFloat(),
-               settings_->value("background_blue_").toFloat(), 1.0f);
+void GLWidget::renderScene() {
+  glEnable(GL_DEPTH_TEST);  // QPainter мог выключить тест глубины
+  const Colors& background = state_.background_color;
+  glClearColor(background.r, background.g, background.b, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
   glMatrixMode(GL_MODELVIEW);
@@ -94,128 +775,454 @@ void GLWidget::paintGL() {
   glRotatef(angle_y_, 0.0f, 1.0f, 0.0f);
 
   setupProjection();
-  drawLines();
-  drawVertex();
+
+  // Сцена из нескольких моделей рисуется вместо текущей модели
+  if (scene_ && !scene_->IsEmpty()) {
+    drawSceneModels();
+    releaseStyle();
+    return;
+  }
+
+  // Трансформации модели: один glMultMatrixf вместо пересчёта вершин
+  glMultMatrixf(model_matrix_.Data());
+
+  // Итоговая матрица нужна для отсечения и для выбора мышью
+  s21::Matrix4 modelview, projection;
+  glGetFloatv(GL_MODELVIEW_MATRIX, modelview.m.data());
+  glGetFloatv(GL_PROJECTION_MATRIX, projection.m.data());
+  mvp_ = projection * modelview;
+
+  uploadBuffers();
+
+  // Модель, занимающая на экране мало пикселей, рисуется упрощённой
+  lod_level_ = selectLodLevel();
+  QOpenGLBuffer* vertices = &vertex_buffer_;
+  QOpenGLBuffer* indices = &index_buffer_;
+  GLsizei vertex_count = vertex_count_;
+  GLsizei index_count = index_count_;
+  if (lod_level_ >= 0) {
+    LodBuffers& level = lod_buffers_[static_cast<size_t>(lod_level_)];
+    vertices = &level.vertices;
+    indices = &level.indices;
+    vertex_count = level.vertex_count;
+    index_count = level.index_count;
+  }
+
+  // Полная детализация рисуется по участкам узлов, попавших в пирамиду
+  // видимости; упрощённый уровень и так невелик
+  visible_ranges_.clear();
+  if (lod_level_ < 0 && bvh_order_ && !isModelBusy()) {
+    visible_edges_ = bvh_->CollectVisible(s21::Frustum::FromMatrix(mvp_),
+                                          visible_ranges_, kCullMinEdges);
+  } else if (vertex_count > 0 && index_count > 0) {
+    visible_ranges_.push_back({0, static_cast<uint32_t>(index_count / 2)});
+    visible_edges_ = static_cast<size_t>(index_count / 2);
+  } else {
+    visible_edges_ = 0;
+  }
+  s21::Metrics::GetInstance().Record("frame.edges",
+                                     static_cast<double>(visible_edges_));
+
+  // Вершины берутся из VBO: оба вызова отрисовки используют один буфер
+  vertices->bind();
+  enableVertexArray();
+
+  drawLines(*indices, visible_ranges_);
+  drawVertex(vertex_count);
+  vertices->release();
+
+  drawPick();
+  disableVertexArray();
+  releaseStyle();
 }
+
 /**
- * @brief Отрисовка линий.
+ * @brief Отрисовка моделей сцены.
+ *
+ * С поддержкой экземпляров каждая модель рисуется двумя вызовами (рёбра и
+ * вершины) на все экземпляры сразу. Иначе матрица экземпляра задаётся перед
+ * каждым вызовом: постоянным атрибутом в шейдерах или glMultMatrixf в
+ * фиксированном конвейере. Буферы при этом не перезагружаются.
  */
-void GLWidget::drawLines() {
-  if (settings_->value("dotted_facets_").toBool()) {
-    glEnable(GL_LINE_STIPPLE);
-    glLineStipple(2, 0x00FF);
-  } else {
-    glDisable(GL_LINE_STIPPLE);
-  }
-  // Стиль линий
-  glLineWidth(settings_->value("facets_size_").toFloat());
-  glColor3f(settings_->value("facets_red_").toFloat(),
-            settings_->value("facets_green_").toFloat(),
-            settings_->value("facets_blue_").toFloat());
-
-  // Рисуем, только если данные есть
-  if (vertices_ && !edges_.empty() && !vertices_->empty()) {
-    glBegin(GL_LINES);
-    for (const auto& edge : edges_) {
-      // Проверяем, что индексы в пределах
-      if (edge.first >= vertices_->size() || edge.second >= vertices_->size()) {
-        continue;
+void GLWidget::drawSceneModels() {
+  uploadSceneBuffers();
+
+  s21::Matrix4 modelview, projection;
+  glGetFloatv(GL_MODELVIEW_MATRIX, modelview.m.data());
+  glGetFloatv(GL_PROJECTION_MATRIX, projection.m.data());
+  mvp_ = projection * modelview;
+  lod_level_ = -1;
+  visible_ranges_.clear();
+  visible_edges_ = 0;
+
+  const std::vector<s21::SceneModel>& models = scene_->GetModels();
+  for (size_t i = 0; i < scene_buffers_.size(); ++i) {
+    SceneBuffers& buffers = scene_buffers_[i];
+    const s21::SceneModel& entry = models[i];
+    if (buffers.vertex_count == 0 || entry.instances.empty()) continue;
+
+    // Накопленная матрица модели общая для всех её экземпляров
+    draw_model_ = entry.model->GetTransform();
+    const auto instance_count = static_cast<GLsizei>(entry.instances.size());
+    buffers.vertices.bind();
+    enableVertexArray();
+    if (instancing_) {
+      enableInstanceArray(buffers.instances);
+      drawSceneModel(buffers.indices, buffers.index_count,
+                     buffers.vertex_count, instance_count);
+      disableInstanceArray();
+    } else {
+      for (const s21::Matrix4& instance : entry.instances) {
+        if (shaders_) {
+          setInstanceMatrix(instance);
+        } else {
+          glPushMatrix();
+          glMultMatrixf(instance.Data());
+          glMultMatrixf(draw_model_.Data());
+        }
+        drawSceneModel(buffers.indices, buffers.index_count,
+                       buffers.vertex_count, 1);
+        if (!shaders_) glPopMatrix();
       }
-      const auto& v1 = (*vertices_)[edge.first];
-      const auto& v2 = (*vertices_)[edge.second];
-      glVertex3f(v1.x, v1.y, v1.z);
-      glVertex3f(v2.x, v2.y, v2.z);
     }
-    glEnd();
+    disableVertexArray();
+    buffers.vertices.release();
+    visible_edges_ += static_cast<size_t>(buffers.index_count / 2) *
+                      entry.instances.size();
   }
+  draw_model_ = s21::Matrix4::Identity();
+  s21::Metrics::GetInstance().Record("frame.edges",
+                                     static_cast<double>(visible_edges_));
 }
+
 /**
- * @brief Отрисовка вершин.
+ * @brief Рисует рёбра и вершины экземпляров одной модели сцены.
+ */
+void GLWidget::drawSceneModel(QOpenGLBuffer& indices, GLsizei index_count,
+                              GLsizei vertex_count, GLsizei instances) {
+  setLineStyle(state_.line_color, state_.line_width, state_.dotted_facets);
+  if (index_count > 0) {
+    indices.bind();
+    if (instancing_) {
+      glDrawElementsInstanced(GL_LINES, index_count, GL_UNSIGNED_INT, nullptr,
+                              instances);
+    } else {
+      glDrawElements(GL_LINES, index_count, GL_UNSIGNED_INT, nullptr);
+    }
+    ++draw_calls_;
+    indices.release();
+  }
+
+  if (state_.display_vertex && state_.vertex_size > 0) {
+    setPointStyle(state_.vertex_color, state_.vertex_size,
+                  state_.round_vertex);
+    if (instancing_) {
+      glDrawArraysInstanced(GL_POINTS, 0, vertex_count, instances);
+    } else {
+      glDrawArrays(GL_POINTS, 0, vertex_count);
+    }
+    ++draw_calls_;
+  }
+}
+
+/**
+ * @brief Устанавливает постоянную матрицу экземпляра.
+ */
+void GLWidget::setInstanceMatrix(const s21::Matrix4& instance) {
+  for (int column = 0; column < 4; ++column) {
+    glVertexAttrib4fv(kInstanceAttribute + column,
+                      instance.Data() + column * 4);
+  }
+}
+
+/**
+ * @brief Включает массив матриц экземпляров: столбец матрицы - атрибут,
+ * который меняется раз на экземпляр.
+ */
+void GLWidget::enableInstanceArray(QOpenGLBuffer& instances) {
+  instances.bind();
+  for (int column = 0; column < 4; ++column) {
+    const GLuint location = kInstanceAttribute + column;
+    const size_t offset = column * 4 * sizeof(GLfloat);
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE,
+                          sizeof(s21::Matrix4),
+                          reinterpret_cast<const void*>(offset));
+    glVertexAttribDivisor(location, 1);
+  }
+  instances.release();
+}
+
+/**
+ * @brief Выключает массив матриц экземпляров.
+ */
+void GLWidget::disableInstanceArray() {
+  for (int column = 0; column < 4; ++column) {
+    const GLuint location = kInstanceAttribute + column;
+    glVertexAttribDivisor(location, 0);
+    glDisableVertexAttribArray(location);
+  }
+}
+
+/**
+ * @brief Включает массив вершин из привязанного VBO.
+ */
+void GLWidget::enableVertexArray() {
+  if (shaders_) {
+    glEnableVertexAttribArray(kPositionAttribute);
+    glVertexAttribPointer(kPositionAttribute, 3, GL_FLOAT, GL_FALSE,
+                          sizeof(s21::Vertex), nullptr);
+    setInstanceMatrix(s21::Matrix4::Identity());
+  } else {
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(s21::Vertex), nullptr);
+  }
+}
+
+/**
+ * @brief Выключает массив вершин.
+ */
+void GLWidget::disableVertexArray() {
+  if (shaders_) {
+    glDisableVertexAttribArray(kPositionAttribute);
+  } else {
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+}
+
+/**
+ * @brief Устанавливает цвет, толщину и пунктир рёбер.
+ *
+ * Толщина задаётся glLineWidth в обоих конвейерах.
  */
-void GLWidget::drawVertex() {
-  if (settings_->value("display_vertexes_").toBool() &&
-      settings_->value("vertexes_size_").toFloat() > 0) {
-    glPointSize(settings_->value("vertexes_size_").toFloat());
-    glColor3f(settings_->value("vertexes_red_").toFloat(),
-              settings_->value("vertexes_green_").toFloat(),
-              settings_->value("vertexes_blue_").toFloat());
+void GLWidget::setLineStyle(const Colors& color, float line_width,
+                            bool dashed) {
+  glLineWidth(line_width);
+  if (!shaders_) {
+    if (dashed) {
+      glEnable(GL_LINE_STIPPLE);
+      glLineStipple(2, 0x00FF);
+    } else {
+      glDisable(GL_LINE_STIPPLE);
+    }
+    glColor3f(color.r, color.g, color.b);
+    return;
+  }
 
-    if (settings_->value("round_vertexes_").toBool()) {
+  QOpenGLShaderProgram& program = line_program_.program;
+  program.bind();
+  glUniformMatrix4fv(line_program_.mvp, 1, GL_FALSE, mvp_.Data());
+  glUniformMatrix4fv(line_program_.model, 1, GL_FALSE, draw_model_.Data());
+  program.setUniformValue(line_program_.color, color.r, color.g, color.b,
+                          1.0f);
+  const float ratio = static_cast<float>(devicePixelRatioF());
+  program.setUniformValue(line_program_.viewport, width() * ratio,
+                          height() * ratio);
+  program.setUniformValue(line_program_.dash, dashed ? kDashPixels : 0.0f);
+}
+
+/**
+ * @brief Устанавливает цвет, размер и форму вершин.
+ *
+ * Края круглых вершин сглаживаются смешиванием по альфа-каналу.
+ */
+void GLWidget::setPointStyle(const Colors& color, float size, bool round) {
+  if (!shaders_) {
+    glPointSize(size);
+    glColor3f(color.r, color.g, color.b);
+    if (round) {
       glEnable(GL_POINT_SMOOTH);
       glEnable(GL_BLEND);
     } else {
       glDisable(GL_POINT_SMOOTH);
       glDisable(GL_BLEND);
     }
-    if (vertices_ && !vertices_->empty()) {
-      glColor3f(settings_->value("vertexes_red_").toFloat(),
-                settings_->value("vertexes_green_").toFloat(),
-                settings_->value("vertexes_blue_").toFloat());
-      glBegin(GL_POINTS);
-      for (const auto& vertex : *vertices_) {
-        glVertex3f(vertex.x, vertex.y, vertex.z);
-      }
-      glEnd();
+    return;
+  }
+
+  QOpenGLShaderProgram& program = point_program_.program;
+  program.bind();
+  glUniformMatrix4fv(point_program_.mvp, 1, GL_FALSE, mvp_.Data());
+  glUniformMatrix4fv(point_program_.model, 1, GL_FALSE, draw_model_.Data());
+  program.setUniformValue(point_program_.color, color.r, color.g, color.b,
+                          1.0f);
+  program.setUniformValue(point_program_.point_size, size);
+  program.setUniformValue(point_program_.round, round ? 1 : 0);
+  if (round) {
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  } else {
+    glDisable(GL_BLEND);
+  }
+}
+
+/**
+ * @brief Отключает шейдерную программу после отрисовки.
+ *
+ * QPainter статистики рисует поверх сцены своими средствами.
+ */
+void GLWidget::releaseStyle() {
+  if (shaders_) glUseProgram(0);
+  glDisable(GL_BLEND);
+}
+/**
+ * @brief Отрисовка линий.
+ */
+void GLWidget::drawLines(QOpenGLBuffer& indices,
+                         const std::vector<s21::EdgeRange>& ranges) {
+  setLineStyle(state_.line_color, state_.line_width, state_.dotted_facets);
+
+  // Рисуем, только если данные есть. Индексы рёбер проверены при загрузке
+  // модели, поэтому каждый участок IBO рисуется одним вызовом
+  if (ranges.empty()) return;
+  indices.bind();
+  for (const s21::EdgeRange& range : ranges) {
+    const size_t offset = size_t{range.first} * 2 * sizeof(GLuint);
+    glDrawElements(GL_LINES, static_cast<GLsizei>(range.count * 2),
+                   GL_UNSIGNED_INT, reinterpret_cast<const void*>(offset));
+    ++draw_calls_;
+  }
+  indices.release();
+}
+/**
+ * @brief Отрисовка вершин.
+ */
+void GLWidget::drawVertex(GLsizei vertex_count) {
+  if (state_.display_vertex && state_.vertex_size > 0) {
+    setPointStyle(state_.vertex_color, state_.vertex_size,
+                  state_.round_vertex);
+    if (vertex_count > 0) {
+      glDrawArrays(GL_POINTS, 0, vertex_count);
+      ++draw_calls_;
     }
   }
 }
 /**
- * @brief Получить признак отображения вершин.
+ * @brief Выделяет выбранную мышью вершину или ребро.
+ *
+ * Выделение рисуется без теста глубины, поэтому видно и сквозь модель.
  */
-bool GLWidget::getDisplayVertex() {
-  return settings_->value("display_vertexes_").toBool();
+void GLWidget::drawPick() {
+  if (pick_.kind == s21::PickResult::Kind::kNone || vertex_count_ == 0) {
+    return;
+  }
+
+  vertex_buffer_.bind();
+  enableVertexArray();
+  glDisable(GL_DEPTH_TEST);
+  if (pick_.kind == s21::PickResult::Kind::kVertex) {
+    setPointStyle(kPickColor, state_.vertex_size + 4.0f, state_.round_vertex);
+    glDrawArrays(GL_POINTS, static_cast<GLint>(pick_.vertex), 1);
+  } else {
+    // Два индекса ребра в своём маленьком IBO: в профиле Core индексы из
+    // памяти приложения недоступны
+    setLineStyle(kPickColor, state_.line_width + 2.0f, false);
+    if (!pick_buffer_.isCreated()) pick_buffer_.create();
+    pick_buffer_.bind();
+    pick_buffer_.allocate(&(*edges_)[pick_.edge], sizeof(s21::Edge));
+    glDrawElements(GL_LINES, 2, GL_UNSIGNED_INT, nullptr);
+    pick_buffer_.release();
+  }
+  ++draw_calls_;
+  glEnable(GL_DEPTH_TEST);
+  vertex_buffer_.release();
+}
+
+/**
+ * @brief Запоминает позицию нажатия левой кнопки мыши.
+ */
+void GLWidget::mousePressEvent(QMouseEvent* event) {
+  if (event->button() == Qt::LeftButton) {
+    last_mouse_pos_ = event->position().toPoint();
+  }
 }
+
+/**
+ * @brief Выбирает элемент под курсором при щелчке левой кнопкой.
+ */
+void GLWidget::mouseReleaseEvent(QMouseEvent* event) {
+  if (event->button() != Qt::LeftButton) return;
+  const QPoint delta = event->position().toPoint() - last_mouse_pos_;
+  if (delta.manhattanLength() <= kClickMaxDistance) pickAt(event->position());
+}
+
+/**
+ * @brief Выбирает вершину или ребро в точке виджета.
+ *
+ * Используется матрица последнего кадра, т.е. выбирается то, что видно на
+ * экране. Обходятся только узлы иерархии под курсором.
+ */
+void GLWidget::pickAt(const QPointF& pos) {
+  if (!bvh_ || !vertices_ || !edges_ || bvh_->IsEmpty()) return;
+  if (scene_ && !scene_->IsEmpty()) return;  // Иерархия только у одной модели
+  if (isModelBusy()) return;  // Иерархия пересчитывается в фоне
+
+  const s21::PickQuery query{static_cast<float>(pos.x()),
+                             static_cast<float>(pos.y()),
+                             static_cast<float>(width()),
+                             static_cast<float>(height()), kPickRadiusPixels};
+  pick_ = bvh_->Pick(*vertices_, *edges_, mvp_, query);
+  emit picked(pick_);
+  update();
+}
+
+/**
+ * @brief Получить признак отображения вершин.
+ */
+bool GLWidget::getDisplayVertex() { return state_.display_vertex; }
 /**
  * @brief Установить признак отображения вершин.
  *
  * @param val true если отображать.
  */
 void GLWidget::setDisplayVertex(bool val) {
-  settings_->setValue("display_vertexes_", val);
+  state_.display_vertex = val;
+  scheduleSave();
+  update();
 }
 /**
  * @brief Получить тип проекции.
  */
-bool GLWidget::getCentralProjection() {
-  return settings_->value("central_projection_").toBool();
-}
+bool GLWidget::getCentralProjection() { return state_.central_projection; }
 /**
  * @brief Установить тип проекции.
  *
  * @param val true - центральная, false - параллельная
  */
 void GLWidget::setCentralProjection(bool val) {
-  settings_->setValue("central_projection_", val);
+  state_.central_projection = val;
+  scheduleSave();
+  update();
 }
 /**
  * @brief Получить тип линии(сплошная/пунктирная).
  */
-bool GLWidget::getDottedFacets() {
-  return settings_->value("dotted_facets_").toBool();
-}
+bool GLWidget::getDottedFacets() { return state_.dotted_facets; }
 /**
  * @brief Установить тип линии(сплошная/пунктирная).
  *
  * @param val true если пунктирная.
  */
 void GLWidget::setDottedFacets(bool val) {
-  settings_->setValue("dotted_facets_", val);
+  state_.dotted_facets = val;
+  scheduleSave();
+  update();
 }
 /**
  * @brief Получить тип вершин модели.
  *
  * @param val true круглая, false квадрат.
  */
-bool GLWidget::getRoundVertex() {
-  return settings_->value("round_vertexes_").toBool();
-}
+bool GLWidget::getRoundVertex() { return state_.round_vertex; }
 /**
  * @brief Установить тип вершин модели.
  *
  * @param val true круглая, false квадрат.
  */
 void GLWidget::setRoundVertex(bool val) {
-  settings_->setValue("round_vertexes_", val);
+  state_.round_vertex = val;
+  scheduleSave();
+  update();
 }
 /**
  * @brief Установка проекции.
@@ -225,7 +1232,7 @@ void GLWidget::setupProjection() {
   glMatrixMode(GL_PROJECTION);
   glLoadIdentity();
 
-  if (!settings_->value("central_projection_").toBool()) {
+  if (!state_.central_projection) {
     glOrtho(-1, 1, -1, 1, -1, 10);
   } else {
     glFrustum(-1, 1, -1, 1, 0.5, 10);
@@ -237,11 +1244,10 @@ void GLWidget::setupProjection() {
 /**
  * @brief Обработчик таймера
  *
- * Вызывается каждые ~16 мс. Пока просто запрашивает перерисовку.
- * Можно использовать для анимации (например, автовращения).
+ * Вызывается каждые ~16 мс в режиме RenderMode::kContinuous и запрашивает
+ * перерисовку. Можно использовать для анимации (например, автовращения).
  */
 void GLWidget::onTimer() {
-  saveConfig();
   update();  // Перерисовка сцены
 }
 
@@ -249,13 +1255,7 @@ void GLWidget::onTimer() {
 /**
  * @brief Получить цвет линий модели.
  */
-Colors GLWidget::getLineColor() {
-  Colors col;
-  col.r = settings_->value("facets_red_").toFloat();
-  col.g = settings_->value("facets_green_").toFloat();
-  col.b = settings_->value("facets_blue_").toFloat();
-  return col;
-}
+Colors GLWidget::getLineColor() { return state_.line_color; }
 /**
  * @brief Устанавливает цвет линий
  * @param r Красный (0.0 — 1.0)
@@ -263,21 +1263,14 @@ Colors GLWidget::getLineColor() {
  * @param b Синий (0.0 — 1.0)
  */
 void GLWidget::setLineColor(float r, float g, float b) {
-  settings_->setValue("facets_red_", r);
-  settings_->setValue("facets_green_", g);
-  settings_->setValue("facets_blue_", b);
+  state_.line_color = {r, g, b};
+  scheduleSave();
   update();  // Применяем изменения
 }
 /**
  * @brief Получить цвет вершин модели.
  */
-Colors GLWidget::getVertexColor() {
-  Colors col;
-  col.r = settings_->value("vertexes_red_").toFloat();
-  col.g = settings_->value("vertexes_green_").toFloat();
-  col.b = settings_->value("vertexes_blue_").toFloat();
-  return col;
-}
+Colors GLWidget::getVertexColor() { return state_.vertex_color; }
 /**
  * @brief Устанавливает цвет вершин
  * @param r Красный (0.0 — 1.0)
@@ -285,51 +1278,40 @@ Colors GLWidget::getVertexColor() {
  * @param b Синий (0.0 — 1.0)
  */
 void GLWidget::setVertexColor(float r, float g, float b) {
-  settings_->setValue("vertexes_red_", r);
-  settings_->setValue("vertexes_green_", g);
-  settings_->setValue("vertexes_blue_", b);
+  state_.vertex_color = {r, g, b};
+  scheduleSave();
   update();  // Применяем изменения
 }
 /**
  * @brief Получить толщину линий модели.
  */
-float GLWidget::getLineWidth() {
-  return settings_->value("facets_size_").toFloat();
-}
+float GLWidget::getLineWidth() { return state_.line_width; }
 /**
  * @brief Устанавливает толщину линий
  * @param width Толщина (в пикселях)
  */
 void GLWidget::setLineWidth(float width) {
-  settings_->setValue("facets_size_",
-                      qBound(0.1f, width, 10.0f));  // Ограничиваем диапазон
+  state_.line_width = qBound(0.1f, width, 10.0f);  // Ограничиваем диапазон
+  scheduleSave();
   update();
 }
 /**
  * @brief Получить размер вершин модели.
  */
-float GLWidget::getVertexSize() {
-  return settings_->value("vertexes_size_").toFloat();
-}
+float GLWidget::getVertexSize() { return state_.vertex_size; }
 /**
  * @brief Устанавливает толщину вершин
  * @param width Толщина (в пикселях)
  */
 void GLWidget::setVertexSize(float width) {
-  settings_->setValue("vertexes_size_",
-                      qBound(0.1f, width, 10.0f));  // Ограничиваем диапазон
+  state_.vertex_size = qBound(0.1f, width, 10.0f);  // Ограничиваем диапазон
+  scheduleSave();
   update();
 }
 /**
  * @brief Получить цвет фона модели.
  */
-Colors GLWidget::getBackgroundColor() {
-  Colors col;
-  col.r = settings_->value("background_red_").toFloat();
-  col.g = settings_->value("background_green_").toFloat();
-  col.b = settings_->value("background_blue_").toFloat();
-  return col;
-}
+Colors GLWidget::getBackgroundColor() { return state_.background_color; }
 /**
  * @brief Устанавливает цвет фона
  * @param r Красный (0.0 — 1.0)
@@ -337,76 +1319,75 @@ Colors GLWidget::getBackgroundColor() {
  * @param b Синий (0.0 — 1.0)
  */
 void GLWidget::setBackgroundColor(float r, float g, float b) {
-  settings_->setValue("background_red_", r);
-  settings_->setValue("background_green_", g);
-  settings_->setValue("background_blue_", b);
-
+  state_.background_color = {r, g, b};
+  scheduleSave();
   update();
 }
 /**
  * @brief Загрузить данные из конфига.
+ *
+ * Отсутствующие ключи получают значения по умолчанию из RenderState.
  */
 void GLWidget::loadConfig() {
-  settings_->value("vertexes_size_", defaultSize_).toInt();
-  settings_->value("facets_size_", defaultSize_).toFloat();
-
-  settings_->value("vertexes_red_", defaultColor2_).toFloat();
-  settings_->value("vertexes_green_", defaultColor2_).toFloat();
-  settings_->value("vertexes_blue_", defaultColor2_).toFloat();
-
-  settings_->value("facets_red_", defaultColor2_).toFloat();
-  settings_->value("facets_green_", defaultColor2_).toFloat();
-  settings_->value("facets_blue_", defaultColor2_).toFloat();
+  const RenderState defaults;
+  auto readColor = [this](const QString& prefix, const Colors& fallback) {
+    return Colors{settings_->value(prefix + "red_", fallback.r).toFloat(),
+                  settings_->value(prefix + "green_", fallback.g).toFloat(),
+                  settings_->value(prefix + "blue_", fallback.b).toFloat()};
+  };
 
-  settings_->value("background_red_", defaultColor_).toFloat();
-  settings_->value("background_green_", defaultColor_).toFloat();
-  settings_->value("background_blue_", defaultColor_).toFloat();
+  state_.vertex_size =
+      settings_->value("vertexes_size_", defaults.vertex_size).toFloat();
+  state_.line_width =
+      settings_->value("facets_size_", defaults.line_width).toFloat();
 
-  settings_->value("dotted_facets_", false).toBool();
+  state_.vertex_color = readColor("vertexes_", defaults.vertex_color);
+  state_.line_color = readColor("facets_", defaults.line_color);
+  state_.background_color = readColor("background_", defaults.background_color);
 
-  settings_->value("round_vertexes_", true).toBool();
-
-  settings_->value("display_vertexes_", true).toBool();
-  settings_->value("central_projection_", false).toBool();
+  state_.dotted_facets =
+      settings_->value("dotted_facets_", defaults.dotted_facets).toBool();
+  state_.round_vertex =
+      settings_->value("round_vertexes_", defaults.round_vertex).toBool();
+  state_.display_vertex =
+      settings_->value("display_vertexes_", defaults.display_vertex).toBool();
+  state_.central_projection =
+      settings_->value("central_projection_", defaults.central_projection)
+          .toBool();
+}
+/**
+ * @brief Запланировать сохранение конфига после изменения настроек.
+ */
+void GLWidget::scheduleSave() {
+  config_dirty_ = true;
+  save_timer_->start();  // Перезапуск: сохраняем после последнего изменения
 }
 /**
  * @brief Сохранить данные в конфиг.
+ *
+ * Ничего не делает, если настройки не менялись после прошлого сохранения.
  */
 void GLWidget::saveConfig() {
-  settings_->setValue("vertexes_size_",
-                      settings_->value("vertexes_size_", defaultSize_));
-  settings_->setValue("facets_size_",
-                      settings_->value("facets_size_", defaultSize_));
-
-  settings_->setValue("vertexes_red_",
-                      settings_->value("vertexes_red_", defaultColor2_));
-  settings_->setValue("vertexes_green_",
-                      settings_->value("vertexes_green_", defaultColor2_));
-  settings_->setValue("vertexes_blue_",
-                      settings_->value("vertexes_blue_", defaultColor2_));
-
-  settings_->setValue("facets_red_",
-                      settings_->value("facets_red_", defaultColor2_));
-  settings_->setValue("facets_green_",
-                      settings_->value("facets_green_", defaultColor2_));
-  settings_->setValue("facets_blue_",
-                      settings_->value("facets_blue_", defaultColor2_));
-
-  settings_->setValue("background_red_",
-                      settings_->value("background_red_", defaultColor_));
-  settings_->setValue("background_green_",
-                      settings_->value("background_green_", defaultColor_));
-  settings_->setValue("background_blue_",
-                      settings_->value("background_blue_", defaultColor_));
-
-  settings_->setValue("dotted_facets_",
-                      settings_->value("dotted_facets_", false));
-  settings_->setValue("round_vertexes_",
-                      settings_->value("round_vertexes_", true));
-  settings_->setValue("display_vertexes_",
-                      settings_->value("display_vertexes_", true));
-  settings_->setValue("central_projection_",
-                      settings_->value("central_projection_", false));
+  if (!config_dirty_) return;
+  config_dirty_ = false;
+
+  auto writeColor = [this](const QString& prefix, const Colors& color) {
+    settings_->setValue(prefix + "red_", color.r);
+    settings_->setValue(prefix + "green_", color.g);
+    settings_->setValue(prefix + "blue_", color.b);
+  };
+
+  settings_->setValue("vertexes_size_", state_.vertex_size);
+  settings_->setValue("facets_size_", state_.line_width);
+
+  writeColor("vertexes_", state_.vertex_color);
+  writeColor("facets_", state_.line_color);
+  writeColor("background_", state_.background_color);
+
+  settings_->setValue("dotted_facets_", state_.dotted_facets);
+  settings_->setValue("round_vertexes_", state_.round_vertex);
+  settings_->setValue("display_vertexes_", state_.display_vertex);
+  settings_->setValue("central_projection_", state_.central_projection);
 
   settings_->sync();
-}
\ No newline at end of file
+}
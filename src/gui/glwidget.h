@@ -16,29 +16,73 @@
 
 #include <GL/glu.h>
 
-#include <QOpenGLFunctions>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QOpenGLBuffer>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTimerQuery>
 #include <QOpenGLWidget>
+#include <QPainter>
 #include <QSettings>
 #include <QString>
+#include <QStringList>
 #include <QTimer>
 #include <QWheelEvent>
 #include <QtMath>
+#include <array>
 #include <vector>
 
+#include "../model/bvh.hpp"
+#include "../model/lod.hpp"
 #include "../model/model.hpp"
+#include "../model/scene.hpp"
+#include "../patterns/frame_recorder.hpp"
+#include "../patterns/vertex_baker.hpp"
 
 struct Colors {
   float r, g, b;
 };
+
+/**
+ * @struct RenderState
+ * @brief Настройки отображения, которые читает отрисовка.
+ *
+ * Хранится в памяти виджета: сеттеры меняют поля напрямую, а paintGL читает
+ * их без обращения к QSettings. В conf.ini состояние записывается только
+ * после изменений (с задержкой) и при уничтожении виджета.
+ */
+struct RenderState {
+  Colors line_color{0.9f, 0.9f, 0.9f};        ///< Цвет рёбер
+  Colors vertex_color{0.9f, 0.9f, 0.9f};      ///< Цвет вершин
+  Colors background_color{0.1f, 0.1f, 0.1f};  ///< Цвет фона
+  float line_width = 5.0f;        ///< Толщина рёбер
+  float vertex_size = 5.0f;       ///< Размер вершин
+  bool dotted_facets = false;     ///< Пунктирные рёбра
+  bool round_vertex = true;       ///< Круглые вершины
+  bool display_vertex = true;     ///< Показывать вершины
+  bool central_projection = false;  ///< Центральная проекция
+};
+
+/**
+ * @enum RenderMode
+ * @brief Когда виджет перерисовывает сцену.
+ */
+enum class RenderMode {
+  kOnDemand,   ///< Только после изменения модели, камеры или настроек
+  kContinuous  ///< Постоянно, ~60 кадров в секунду (для анимации)
+};
+
 /**
  * @class GLWidget
  * @brief OpenGL виджет для отрисовки 3D-моделей.
  *
- * Наследуется от QOpenGLWidget и QOpenGLFunctions для реализации
- * отрисовки 3D-моделей в каркасном режиме. Поддерживает интерактивное
- * управление с помощью мыши: вращение, масштабирование.
+ * Наследуется от QOpenGLWidget и QOpenGLExtraFunctions для реализации
+ * отрисовки 3D-моделей в каркасном режиме. Щелчок мышью выбирает вершину
+ * или ребро под курсором (см. s21::Bvh::Pick). Вместо одной модели может
+ * рисоваться сцена из нескольких моделей и их экземпляров (см. setScene).
  */
-class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
+class GLWidget : public QOpenGLWidget, protected QOpenGLExtraFunctions {
   Q_OBJECT
 
  public:
@@ -51,17 +95,179 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
 
   /**
    * @brief Дуструктор виджета OpenGL.
+   *
+   * Сохраняет настройки и освобождает буферы OpenGL.
    */
-  ~GLWidget() { saveConfig(); }
+  ~GLWidget();
 
   /**
    * @brief Устанавливает данные модели для отрисовки.
    *
+   * Данные не копируются: виджет хранит указатели на массивы модели.
+   * С иерархией рёбра загружаются в видеопамять в её порядке: в каждом
+   * кадре рисуются только участки узлов, попавших в пирамиду видимости,
+   * а щелчок мышью выбирает вершину или ребро.
+   *
    * @param vertices Указатель на вектор вершин модели.
-   * @param edges Вектор рёбер модели (пары индексов вершин).
+   * @param edges Указатель на вектор рёбер модели (пары индексов вершин).
+   * @param bvh Иерархия над этими рёбрами (nullptr - без отсечения и
+   * выбора мышью).
    */
   void setModelData(const std::vector<s21::Vertex>* vertices,
-                    const std::vector<std::pair<size_t, size_t>> edges);
+                    const std::vector<s21::Edge>* edges,
+                    const s21::Bvh* bvh = nullptr);
+
+  /**
+   * @brief Сообщает виджету, что координаты вершин изменились.
+   *
+   * Вершинный буфер будет перезагружен в видеопамять перед следующей
+   * отрисовкой; индексный буфер рёбер при этом не трогается. AABB узлов
+   * иерархии к этому моменту должны быть обновлены (Model::GetBvh()).
+   */
+  void updateVertices();
+
+  /**
+   * @brief Устанавливает матрицу модели.
+   *
+   * Матрица применяется при отрисовке поверх вида камеры, поэтому изменение
+   * трансформации не требует перезагрузки вершинного буфера.
+   *
+   * @param matrix Матрица модели в порядке столбцов.
+   */
+  void setModelMatrix(const s21::Matrix4& matrix);
+
+  /**
+   * @brief Устанавливает уровни детализации текущей модели.
+   *
+   * Уровень выбирается в каждом кадре по размеру модели на экране: пока
+   * ячейка уровня не больше пикселя, рисуется упрощённый каркас, при
+   * приближении - полный. Уровни сбрасываются при смене модели и при
+   * изменении вершин (updateVertices). После загрузки в видеопамять массивы
+   * уровней освобождаются.
+   *
+   * @param lod Уровни для данных из последнего setModelData().
+   */
+  void setLodSet(s21::LodSet lod);
+
+  /**
+   * @brief Устанавливает сцену из нескольких моделей.
+   *
+   * Пока сцена не пуста, она рисуется вместо модели из setModelData():
+   * вершины и рёбра каждой модели сцены загружаются в видеопамять один раз,
+   * а все её экземпляры рисуются одним вызовом glDrawElementsInstanced с
+   * матрицами экземпляров в отдельном буфере. Изменения сцены (по
+   * Scene::GetVersion) и матрицы моделей (Model::GetTransform) читаются в
+   * каждом кадре; отсечение, уровни детализации и выбор мышью в сцене не
+   * работают.
+   *
+   * @param scene Сцена (nullptr - рисовать только текущую модель).
+   */
+  void setScene(const s21::Scene* scene);
+
+  /**
+   * @brief Подключает фоновый пересчёт вершин текущей модели.
+   *
+   * Перед каждым кадром виджет забирает последний снимок вершин
+   * (SnapshotBuffer::Consume) и загружает его в VBO. Пока пересчёт идёт,
+   * вершины и иерархия модели не читаются: кадр рисуется из VBO без
+   * отсечения, а выбор мышью не работает.
+   *
+   * @param baker Пересчёт вершин (nullptr - вершины меняются только в
+   * потоке GUI, см. updateVertices).
+   */
+  void setVertexBaker(s21::VertexBaker* baker) { baker_ = baker; }
+
+  /**
+   * @brief Проверяет, рисуются ли экземпляры сцены одним вызовом.
+   *
+   * Нужны шейдеры и OpenGL 3.3 (или OpenGL ES 3.0); иначе каждый
+   * экземпляр рисуется отдельным вызовом из тех же буферов.
+   */
+  bool isInstancing() const { return instancing_; }
+
+  /**
+   * @brief Возвращает уровень детализации последнего кадра.
+   *
+   * @return Индекс уровня в LodSet или -1 (полная детализация).
+   */
+  int getLodLevel() const { return lod_level_; }
+
+  /**
+   * @brief Проверяет, рисуются ли вершины и рёбра шейдерами GLSL.
+   *
+   * false, если шейдеры не собрались (старый контекст без GLSL 1.30): тогда
+   * используются glPointSize/GL_POINT_SMOOTH и glLineStipple.
+   */
+  bool isShaderPipeline() const { return shaders_; }
+
+  /**
+   * @brief Возвращает результат последнего выбора мышью.
+   */
+  const s21::PickResult& getPick() const { return pick_; }
+
+  /**
+   * @brief Устанавливает режим перерисовки.
+   *
+   * По умолчанию RenderMode::kOnDemand: неподвижная сцена не
+   * перерисовывается. В режиме kContinuous таймер запрашивает кадр
+   * каждые ~16 мс.
+   *
+   * @param mode Новый режим.
+   */
+  void setRenderMode(RenderMode mode);
+
+  /**
+   * @brief Возвращает режим перерисовки.
+   */
+  RenderMode getRenderMode() const { return render_mode_; }
+
+  /**
+   * @brief Возвращает количество отрисованных кадров.
+   */
+  quint64 getFrameCount() const { return frame_count_; }
+
+  /**
+   * @brief Показывает или скрывает статистику отрисовки поверх сцены.
+   *
+   * Выводятся FPS, время кадра (p50/p99, CPU и GPU), число вызовов
+   * отрисовки и объём загруженных в видеопамять данных. Сами показатели
+   * собираются в s21::Metrics независимо от видимости.
+   *
+   * @param visible true - показывать.
+   */
+  void setOverlayVisible(bool visible);
+
+  /**
+   * @brief Проверяет, показывается ли статистика отрисовки.
+   */
+  bool isOverlayVisible() const { return overlay_visible_; }
+
+  /**
+   * @brief Начинает передавать кадры в запись.
+   *
+   * Раз в 1000 / fps мс (RecordOptions::fps) виджет перерисовывается и
+   * копирует кадр без статистики поверх сцены. Копирование идёт через два
+   * буфера пикселей (PBO) по очереди: glReadPixels только ставит его в
+   * очередь GPU, а пиксели забираются из буфера при следующем записанном
+   * кадре, когда копирование давно завершено. Без OpenGL 3.0 (OpenGL ES
+   * 3.0) кадр читается сразу. Кодирование и запись файлов - в recorder.
+   *
+   * @param recorder Запущенная запись (FrameRecorder::Start); должна жить
+   * до stopCapture().
+   */
+  void startCapture(s21::FrameRecorder* recorder);
+
+  /**
+   * @brief Прекращает передавать кадры; кадр, ещё ждущий в PBO, передаётся.
+   *
+   * Саму запись завершает её владелец (FrameRecorder::Stop).
+   */
+  void stopCapture();
+
+  /**
+   * @brief Проверяет, передаются ли кадры в запись.
+   */
+  bool isCapturing() const { return recorder_ != nullptr; }
 
   // --- Настройки отображения ---
 
@@ -170,6 +376,14 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
    */
   void setCentralProjection(bool val);
 
+ signals:
+  /**
+   * @brief Щелчок мышью по модели.
+   *
+   * @param result Вершина или ребро под курсором (Kind::kNone - промах).
+   */
+  void picked(const s21::PickResult& result);
+
  protected:
   /**
    * @brief Инициализация OpenGL контекста.
@@ -194,55 +408,313 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
    */
   void paintGL() override;
 
+  /**
+   * @brief Запоминает позицию нажатия левой кнопки мыши.
+   */
+  void mousePressEvent(QMouseEvent* event) override;
+
+  /**
+   * @brief Выбирает элемент под курсором, если мышь почти не сдвинулась.
+   */
+  void mouseReleaseEvent(QMouseEvent* event) override;
+
  private slots:
   /**
    * @brief Обработчик таймера.
    *
-   * Вызывается регулярно для обновления отображения (60 FPS).
+   * Работает только в режиме RenderMode::kContinuous (60 FPS).
    */
   void onTimer();
 
+  /**
+   * @brief Сохранить данные в конфиг.
+   */
+  void saveConfig();
+
  private:
-  float defaultColor_ = 0.1;
-  float defaultColor2_ = 0.9;
-  float defaultSize_ = 5.0f;
   /**
    * @brief Загрузить данные из конфига.
    */
   void loadConfig();
   /**
-   * @brief Сохранить данные в конфиг.
+   * @brief Запланировать сохранение конфига после изменения настроек.
+   *
+   * Частые изменения (например, перетаскивание слайдера) объединяются
+   * в одну запись.
    */
-  void saveConfig();
+  void scheduleSave();
   /**
    * @brief Отрисовка линий.
+   *
+   * @param indices Индексный буфер рёбер.
+   * @param ranges Участки рёбер буфера; каждый - один вызов отрисовки.
    */
-  void drawLines();
+  void drawLines(QOpenGLBuffer& indices,
+                 const std::vector<s21::EdgeRange>& ranges);
   /**
    * @brief Отрисовка вершин.
+   *
+   * @param vertex_count Количество вершин в привязанном VBO.
+   */
+  void drawVertex(GLsizei vertex_count);
+  /**
+   * @brief Собирает шейдерные программы вершин и рёбер.
+   *
+   * Строка #version выбирается по контексту: GLSL ES 3.00 для OpenGL ES,
+   * 1.50 для профиля Core, иначе 1.30.
+   *
+   * @return false если контекст не поддерживает шейдеры.
+   */
+  bool initShaders();
+  /**
+   * @brief Включает массив вершин из привязанного VBO.
+   *
+   * В шейдерном конвейере это атрибут 0, иначе glVertexPointer.
+   */
+  void enableVertexArray();
+  /**
+   * @brief Выключает массив вершин, включённый enableVertexArray().
+   */
+  void disableVertexArray();
+  /**
+   * @brief Устанавливает цвет, толщину и пунктир рёбер.
+   */
+  void setLineStyle(const Colors& color, float line_width, bool dashed);
+  /**
+   * @brief Устанавливает цвет, размер и форму вершин.
+   */
+  void setPointStyle(const Colors& color, float size, bool round);
+  /**
+   * @brief Отключает шейдерную программу после отрисовки.
+   */
+  void releaseStyle();
+  /**
+   * @brief Устанавливает постоянную матрицу экземпляра (атрибуты 1-4).
+   *
+   * Используется, когда массив матриц экземпляров выключен.
+   */
+  void setInstanceMatrix(const s21::Matrix4& instance);
+  /**
+   * @brief Включает массив матриц экземпляров из буфера.
+   */
+  void enableInstanceArray(QOpenGLBuffer& instances);
+  /**
+   * @brief Выключает массив матриц экземпляров.
+   */
+  void disableInstanceArray();
+  /**
+   * @brief Выделяет выбранную мышью вершину или ребро.
+   *
+   * Рисуется поверх модели из полного вершинного буфера.
+   */
+  void drawPick();
+  /**
+   * @brief Копирует кадр в PBO и передаёт записи предыдущий, если подошло
+   * время следующего кадра записи.
+   */
+  void captureFrame();
+  /**
+   * @brief Передаёт записи кадр из PBO, если он там есть.
+   */
+  void submitPackBuffer(size_t index);
+  /**
+   * @brief Выбирает вершину или ребро в точке виджета.
+   *
+   * @param pos Позиция курсора в координатах виджета.
+   */
+  void pickAt(const QPointF& pos);
+  /**
+   * @brief Выбирает уровень детализации по размеру модели на экране.
+   *
+   * @return Индекс уровня или -1 (полная детализация).
+   */
+  int selectLodLevel() const;
+  /**
+   * @brief Освобождает буферы уровней детализации.
+   *
+   * Вызывается при активном контексте OpenGL.
    */
-  void drawVertex();
+  void destroyLodBuffers();
   /**
    * @brief Установка проекции.
    */
   void setupProjection();
+  /**
+   * @brief Отрисовка модели (без статистики поверх сцены).
+   */
+  void renderScene();
+  /**
+   * @brief Отрисовка моделей сцены вместо текущей модели.
+   *
+   * Вызывается из renderScene после установки камеры и проекции.
+   */
+  void drawSceneModels();
+  /**
+   * @brief Рисует рёбра и вершины экземпляров одной модели сцены.
+   *
+   * Вершинный буфер модели уже привязан.
+   *
+   * @param instances Число экземпляров (при instancing_) или 1.
+   */
+  void drawSceneModel(QOpenGLBuffer& indices, GLsizei index_count,
+                      GLsizei vertex_count, GLsizei instances);
+  /**
+   * @brief Загружает в буферы модели сцены, изменившиеся с прошлого кадра.
+   *
+   * Буферы моделей, оставшихся в сцене, не перезагружаются.
+   */
+  void uploadSceneBuffers();
+  /**
+   * @brief Освобождает буферы моделей сцены.
+   */
+  void destroySceneBuffers();
+  /**
+   * @brief Вывод статистики отрисовки поверх сцены.
+   *
+   * @param painter Активный QPainter виджета.
+   */
+  void drawOverlay(QPainter& painter);
+  /**
+   * @brief Записывает в s21::Metrics время GPU завершённых кадров.
+   *
+   * Результат запроса читается, только если он уже готов, поэтому отрисовка
+   * не ждёт видеокарту.
+   */
+  void collectGpuTimes();
+  /**
+   * @brief Загружает изменившиеся данные модели в буферы OpenGL.
+   *
+   * Вызывается из paintGL, когда контекст OpenGL уже активен.
+   */
+  void uploadBuffers();
+  /**
+   * @brief Загружает вершины текущей модели в VBO.
+   */
+  void uploadVertexBuffer(const s21::Vertex* data, GLsizei count);
+  /**
+   * @brief Проверяет, пересчитываются ли вершины модели в фоне.
+   */
+  bool isModelBusy() const { return baker_ && baker_->IsBusy(); }
   const std::vector<s21::Vertex>* vertices_ =
       nullptr;  ///< Указатель на вершины модели
-  std::vector<std::pair<size_t, size_t>> edges_;  ///< Рёбра модели
+  const std::vector<s21::Edge>* edges_ = nullptr;  ///< Рёбра модели
+  s21::Matrix4 model_matrix_;  ///< Матрица модели (отложенные трансформации)
+  const s21::Bvh* bvh_ = nullptr;  ///< Иерархия рёбер модели
+  s21::VertexBaker* baker_ = nullptr;  ///< Фоновый пересчёт вершин
+  s21::Matrix4 mvp_;  ///< Проекция * вид * модель (в сцене - проекция * вид)
+  s21::Matrix4 draw_model_;  ///< Матрица модели сцены в uniform model
+
+  // --- Буферы OpenGL ---
+  QOpenGLBuffer vertex_buffer_{QOpenGLBuffer::VertexBuffer};  ///< VBO вершин
+  QOpenGLBuffer index_buffer_{QOpenGLBuffer::IndexBuffer};  ///< IBO рёбер
+  bool edges_dirty_ = false;  ///< Рёбра нужно загрузить в IBO
+  bool vertices_dirty_ = false;  ///< Вершины нужно загрузить в VBO
+  GLsizei vertex_count_ = 0;  ///< Количество вершин в VBO
+  GLsizei index_count_ = 0;   ///< Количество индексов в IBO
+  bool bvh_order_ = false;    ///< IBO загружен в порядке иерархии
+
+  // --- Шейдеры ---
+  /**
+   * @brief Шейдерная программа и адреса её uniform-переменных.
+   *
+   * Переменные, которых в программе нет, имеют адрес -1 и пропускаются.
+   */
+  struct ShaderProgram {
+    QOpenGLShaderProgram program;  ///< Программа
+    int mvp = -1;         ///< Проекция * вид * модель
+    int model = -1;       ///< Матрица модели сцены
+    int color = -1;       ///< Цвет RGBA
+    int point_size = -1;  ///< Размер вершины в пикселях
+    int round = -1;       ///< Круглые вершины
+    int viewport = -1;    ///< Размер области вывода в пикселях
+    int dash = -1;        ///< Длина штриха пунктира в пикселях
+  };
+  ShaderProgram point_program_;  ///< Вершины (спрайты точек)
+  ShaderProgram line_program_;   ///< Рёбра (сплошные и пунктирные)
+  bool shaders_ = false;         ///< Программы собраны
+  QOpenGLBuffer pick_buffer_{QOpenGLBuffer::IndexBuffer};  ///< Выбранное ребро
+
+  // --- Сцена ---
+  /**
+   * @brief Буферы OpenGL одной модели сцены.
+   */
+  struct SceneBuffers {
+    uint64_t id = 0;  ///< SceneModel::id
+    const std::vector<s21::Vertex>* source = nullptr;  ///< Вершины модели
+    QOpenGLBuffer vertices{QOpenGLBuffer::VertexBuffer};   ///< VBO вершин
+    QOpenGLBuffer indices{QOpenGLBuffer::IndexBuffer};     ///< IBO рёбер
+    QOpenGLBuffer instances{QOpenGLBuffer::VertexBuffer};  ///< Матрицы
+    GLsizei vertex_count = 0;  ///< Количество вершин
+    GLsizei index_count = 0;   ///< Количество индексов
+    bool vertices_dirty = true;  ///< Вершины нужно загрузить в VBO
+  };
+  const s21::Scene* scene_ = nullptr;  ///< Сцена (nullptr - одна модель)
+  uint64_t scene_version_ = 0;  ///< Версия сцены в буферах
+  bool scene_uploaded_ = false;  ///< Буферы сцены соответствуют версии
+  std::vector<SceneBuffers> scene_buffers_;  ///< Буферы моделей сцены
+  bool instancing_ = false;  ///< Отрисовка с экземплярами поддерживается
+
+  // --- Отсечение и выбор ---
+  std::vector<s21::EdgeRange> visible_ranges_;  ///< Участки IBO кадра
+  size_t visible_edges_ = 0;  ///< Рёбер в участках последнего кадра
+  s21::PickResult pick_;      ///< Последний выбор мышью
+
+  // --- Уровни детализации ---
+  /**
+   * @brief Буферы OpenGL одного уровня детализации.
+   */
+  struct LodBuffers {
+    QOpenGLBuffer vertices{QOpenGLBuffer::VertexBuffer};  ///< VBO вершин
+    QOpenGLBuffer indices{QOpenGLBuffer::IndexBuffer};    ///< IBO рёбер
+    GLsizei vertex_count = 0;  ///< Количество вершин
+    GLsizei index_count = 0;   ///< Количество индексов
+  };
+  s21::LodSet lod_;  ///< Уровни (массивы пусты после загрузки в буферы)
+  std::vector<LodBuffers> lod_buffers_;  ///< Буферы уровней
+  bool lod_dirty_ = false;  ///< Уровни нужно загрузить в буферы
+  int lod_level_ = -1;      ///< Уровень последнего кадра
+
+  // --- Статистика отрисовки ---
+  static constexpr size_t kGpuQueries = 3;  ///< Запросов времени в обороте
+  std::array<QOpenGLTimerQuery, kGpuQueries> gpu_queries_;  ///< Время GPU
+  std::array<bool, kGpuQueries> gpu_pending_{};  ///< Запрос ждёт результата
+  bool gpu_timing_ = false;      ///< Запросы времени GPU поддерживаются
+  QElapsedTimer frame_interval_;  ///< Время с прошлого кадра
+  int draw_calls_ = 0;           ///< Вызовов отрисовки в текущем кадре
+  qint64 upload_bytes_ = 0;      ///< Байт загружено в текущем кадре
+  bool overlay_visible_ = false;  ///< Показывать статистику
+
+  // --- Запись кадров ---
+  s21::FrameRecorder* recorder_ = nullptr;  ///< Запись (nullptr - нет)
+  QTimer* capture_timer_;          ///< Запрашивает кадры записи
+  QElapsedTimer capture_clock_;    ///< Время с начала записи
+  qint64 capture_interval_ns_ = 0;  ///< Интервал кадров записи
+  qint64 next_capture_ns_ = 0;     ///< Время следующего кадра записи
+  std::array<QOpenGLBuffer, 2> pack_buffers_{
+      QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer),
+      QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer)};  ///< PBO кадров
+  std::array<QSize, 2> pack_sizes_;  ///< Кадр в PBO (пустой - PBO свободен)
+  size_t pack_index_ = 0;          ///< PBO для следующего кадра
+  bool pack_buffers_supported_ = false;  ///< Есть glMapBufferRange
 
   // --- Параметры вращения ---
   float angle_x_ = 0.0f;   ///< Угол вращения вокруг оси X
   float angle_y_ = 0.0f;   ///< Угол вращения вокруг оси Y
-  QPoint last_mouse_pos_;  ///< Последняя позиция мыши
+  QPoint last_mouse_pos_;  ///< Позиция нажатия левой кнопки мыши
 
   // --- Параметры масштабирования ---
   float scale_ = 1.0f;  ///< Коэффициент масштабирования
 
   // --- Настройки визуализации ---
+  RenderState state_;    ///< Текущие настройки отображения
   QSettings* settings_;  ///< Объект для работы с ini-файлом
   QString config_path_ = "conf.ini";  ///< Путь к конфигурационному файлу
+  QTimer* save_timer_;   ///< Отложенное сохранение настроек
+  bool config_dirty_ = false;  ///< Настройки изменились после сохранения
 
   QTimer* timer_;  ///< Таймер для регулярного обновления отображения
+  RenderMode render_mode_ = RenderMode::kOnDemand;  ///< Режим перерисовки
+  quint64 frame_count_ = 0;  ///< Отрисовано кадров
 };
 
 #endif  // GLWIDGET_H
\ No newline at end of file
@@ -1,7 +1,31 @@
 #include "mainwindow.h"
 
+#include "../model/metrics.hpp"
 #include "./ui_mainwindow.h"
 
+/// Наименьший интервал между применениями трансформации, мс (~60 FPS)
+constexpr int kTransformIntervalMs = 16;
+
+/// Кадров в секунду при записи
+constexpr int kCaptureFps = 10;
+
+/// Качество JPEG (0-100)
+constexpr int kJpegQuality = 90;
+
+/**
+ * @brief Формат записи по пункту captureFormatCombo.
+ */
+static s21::CaptureFormat CaptureFormatAt(int index) {
+  switch (index) {
+    case 1:
+      return s21::CaptureFormat::kJpeg;
+    case 2:
+      return s21::CaptureFormat::kGif;
+    default:
+      return s21::CaptureFormat::kBmp;
+  }
+}
+
 MainWindow::MainWindow(s21::Controller* controller, QWidget* parent)
     : QMainWindow(parent),
       ui(new Ui::MainWindow),
@@ -12,6 +36,11 @@ MainWindow::MainWindow(s21::Controller* controller, QWidget* parent)
 
   glWidget = new GLWidget(this);
   ui->visualizationLayout->addWidget(glWidget);
+  if (controller_) {
+    s21::VertexBaker& baker = controller_->GetVertexBaker();
+    baker.SetDoneCallback([this] { emit verticesBaked(); });
+    glWidget->setVertexBaker(&baker);
+  }
 
   // Устанавливаем соотношение: 1 часть — label, 9 частей — glWidget
   ui->visualizationLayout->setStretch(0, 1);  // visualizationLabel
@@ -29,6 +58,19 @@ MainWindow::MainWindow(s21::Controller* controller, QWidget* parent)
   ui->edgeColorButton->setText("");
   ui->vertexColorButton->setText("");
 
+  // Первое событие слайдера запускает таймер, следующие до его срабатывания
+  // только меняют состояние
+  transformTimer_ = new QTimer(this);
+  transformTimer_->setSingleShot(true);
+  transformTimer_->setInterval(kTransformIntervalMs);
+  connect(transformTimer_, &QTimer::timeout, this,
+          &MainWindow::onTransformTimeout);
+
+  loadProgressBar_ = new QProgressBar(this);
+  loadProgressBar_->setRange(0, 100);
+  loadProgressBar_->setVisible(false);
+  statusBar()->addPermanentWidget(loadProgressBar_);
+
   setupConnections();
   updateInfoPanel();
 
@@ -64,12 +106,53 @@ MainWindow::MainWindow(s21::Controller* controller, QWidget* parent)
                  QColor::fromRgbF(bgColor.r, bgColor.g, bgColor.b));
 }
 
-MainWindow::~MainWindow() { delete ui; }
+MainWindow::~MainWindow() {
+  // Фоновые потоки испускают сигналы этого окна: дожидаемся их до удаления
+  stopLodBuild();
+  glWidget->stopCapture();
+  frameRecorder_.Stop();
+  if (controller_) {
+    controller_->GetVertexBaker().Wait();
+    controller_->GetVertexBaker().SetDoneCallback(nullptr);
+  }
+  if (loading_ && controller_) {
+    controller_->CancelAsyncLoad();
+    std::string error;
+    controller_->FinishAsyncLoad(error);
+  }
+  delete ui;
+}
 
 void MainWindow::setupConnections() {
   // Кнопка загрузки
   connect(ui->loadButton, &QPushButton::clicked, this,
           &MainWindow::onLoadButtonClicked);
+  connect(ui->residentModelsCombo, QOverload<int>::of(&QComboBox::activated),
+          this, &MainWindow::onResidentModelActivated);
+  connect(ui->sceneInstancesSpinBox,
+          QOverload<int>::of(&QSpinBox::valueChanged), this,
+          &MainWindow::onSceneInstancesChanged);
+  connect(ui->clearSceneButton, &QPushButton::clicked, this,
+          &MainWindow::onClearSceneClicked);
+  connect(ui->overlayCheckBox, &QCheckBox::toggled, glWidget,
+          &GLWidget::setOverlayVisible);
+  connect(ui->exportMetricsButton, &QPushButton::clicked, this,
+          &MainWindow::onExportMetricsClicked);
+  connect(glWidget, &GLWidget::picked, this, &MainWindow::onPicked);
+  connect(this, &MainWindow::loadProgress, this, &MainWindow::onLoadProgress,
+          Qt::QueuedConnection);
+  connect(this, &MainWindow::loadFinished, this, &MainWindow::onLoadFinished,
+          Qt::QueuedConnection);
+  connect(this, &MainWindow::lodReady, this, &MainWindow::onLodReady,
+          Qt::QueuedConnection);
+  connect(this, &MainWindow::verticesBaked, this,
+          &MainWindow::onVerticesBaked, Qt::QueuedConnection);
+  connect(ui->screenshotButton, &QPushButton::clicked, this,
+          &MainWindow::onScreenshotClicked);
+  connect(ui->recordButton, &QPushButton::toggled, this,
+          &MainWindow::onRecordToggled);
+  connect(this, &MainWindow::captureFinished, this,
+          &MainWindow::onCaptureFinished, Qt::QueuedConnection);
 
   // Слайдеры перемещения
   connect(ui->translateXSlider, &QSlider::valueChanged, this,
@@ -168,6 +251,12 @@ void MainWindow::setupConnections() {
 }
 
 void MainWindow::onLoadButtonClicked() {
+  if (loading_) {
+    loadCancelled_ = true;
+    controller_->CancelAsyncLoad();
+    return;
+  }
+
   QString filePath =
       QFileDialog::getOpenFileName(this, tr("Открыть 3D-модель"), "",
 
@@ -175,31 +264,307 @@ void MainWindow::onLoadButtonClicked() {
 
   if (filePath.isEmpty()) return;
 
-  const bool ok = controller_->LoadModelFromFile(filePath.toStdString());
+  // Модель уже в памяти - переключаемся без чтения файла
+  stopLodBuild();
+  if (controller_->SelectResidentModel(filePath.toStdString())) {
+    showCurrentModel(filePath);
+    return;
+  }
+  startAsyncLoad(filePath);
+}
+
+void MainWindow::startAsyncLoad(const QString& filePath) {
+  loading_ = true;
+  loadCancelled_ = false;
+  loadTimer_.start();
+  loadingPath_ = filePath;
+  ui->loadButton->setText(tr("Отменить"));
+  loadProgressBar_->setValue(0);
+  loadProgressBar_->setVisible(true);
+  statusBar()->showMessage(tr("Загрузка ") + QFileInfo(filePath).fileName());
+
+  controller_->LoadModelFromFileAsync(
+      filePath.toStdString(),
+      [this](const s21::LoadProgress& progress) {
+        emit loadProgress(static_cast<qint64>(progress.bytes_parsed),
+                          static_cast<qint64>(progress.bytes_total),
+                          static_cast<qint64>(progress.vertices),
+                          static_cast<qint64>(progress.faces));
+      },
+      [this] { emit loadFinished(); });
+}
+
+void MainWindow::onLoadProgress(qint64 bytes, qint64 total, qint64 vertices,
+                                qint64 faces) {
+  if (!loading_) return;  // Запоздавшее событие уже завершённой загрузки
+
+  loadProgressBar_->setValue(total > 0 ? static_cast<int>(bytes * 100 / total)
+                                       : 0);
+  statusBar()->showMessage(tr("Загрузка %1: вершин %2, полигонов %3")
+                               .arg(QFileInfo(loadingPath_).fileName())
+                               .arg(vertices)
+                               .arg(faces));
+}
+
+void MainWindow::onLoadFinished() {
+  loading_ = false;
+  ui->loadButton->setText(tr("Выбрать файл..."));
+  loadProgressBar_->setVisible(false);
+  statusBar()->clearMessage();
+
+  // Новая модель может вытеснить из памяти ту, по которой строятся уровни
+  stopLodBuild();
+  std::string error;
+  if (controller_->FinishAsyncLoad(error)) {
+    const double elapsed = loadTimer_.nsecsElapsed() / 1e6;
+    s21::Metrics::GetInstance().Record("load.wall", elapsed);
+    showCurrentModel(loadingPath_);
+    statusBar()->showMessage(
+        tr("Загружено за %1 мс").arg(elapsed, 0, 'f', 1), 5000);
+    return;
+  }
+
+  // Модель не сменилась: достраиваем прерванные уровни
+  if (!lodApplied_) startLodBuild();
+  if (loadCancelled_) {
+    statusBar()->showMessage(tr("Загрузка отменена"), 3000);
+  } else {
+    // Предыдущая модель остаётся на экране
+    QMessageBox::warning(this, tr("Ошибка загрузки"),
+                         QString::fromStdString(error));
+  }
+}
+
+void MainWindow::onResidentModelActivated(int index) {
+  if (loading_ || index < 0) return;
+
+  const QString path = ui->residentModelsCombo->itemData(index).toString();
+  stopLodBuild();
+  if (controller_->SelectResidentModel(path.toStdString())) {
+    showCurrentModel(path);
+  } else {
+    // Файл изменился после загрузки - читаем заново
+    updateResidentModels();
+    startAsyncLoad(path);
+  }
+}
+
+void MainWindow::onExportMetricsClicked() {
+  QString path = QFileDialog::getSaveFileName(
+      this, tr("Сохранить метрики"), "metrics.json",
+      tr("JSON (*.json);;CSV (*.csv)"));
+  if (path.isEmpty()) return;
+
+  if (!s21::Metrics::GetInstance().WriteToFile(path.toStdString())) {
+    QMessageBox::warning(this, tr("Ошибка"),
+                         tr("Не удалось записать файл ") + path);
+  }
+}
+
+void MainWindow::onScreenshotClicked() {
+  const s21::CaptureFormat format =
+      CaptureFormatAt(ui->captureFormatCombo->currentIndex());
+  const QString extension = s21::CaptureExtension(format);
+  QString path = QFileDialog::getSaveFileName(
+      this, tr("Сохранить снимок"), "screenshot" + extension,
+      ui->captureFormatCombo->currentText() + " (*" + extension + ")");
+  if (path.isEmpty()) return;
+  if (QFileInfo(path).suffix().isEmpty()) path += extension;
+  startCapture(path, 1);
+}
+
+void MainWindow::onRecordToggled(bool checked) {
+  if (!checked) {
+    if (glWidget->isCapturing()) finishCapture();
+    return;
+  }
+
+  const s21::CaptureFormat format =
+      CaptureFormatAt(ui->captureFormatCombo->currentIndex());
+  const QString extension = s21::CaptureExtension(format);
+  const bool gif = format == s21::CaptureFormat::kGif;
+  QString path = QFileDialog::getSaveFileName(
+      this,
+      gif ? tr("Записать анимацию") : tr("Записать кадры (к имени "
+                                         "добавляется номер кадра)"),
+      "turntable" + extension,
+      ui->captureFormatCombo->currentText() + " (*" + extension + ")");
+  if (!path.isEmpty()) {
+    const QFileInfo info(path);
+    if (gif && info.suffix().isEmpty()) path += extension;
+    // Кадры: turntable_0000.bmp, turntable_0001.bmp, ...
+    if (!gif) path = info.path() + "/" + info.completeBaseName();
+  }
+  if (path.isEmpty() || !startCapture(path, 0)) {
+    const QSignalBlocker blocker(ui->recordButton);
+    ui->recordButton->setChecked(false);
+    return;
+  }
+  ui->screenshotButton->setEnabled(false);
+  ui->captureFormatCombo->setEnabled(false);
+  statusBar()->showMessage(tr("Идёт запись: ") + path);
+}
+
+void MainWindow::onCaptureFinished() {
+  // Запоздавшее уведомление о прошлом снимке не завершает новую запись
+  if (!glWidget->isCapturing() || frameRecorder_.IsRecording()) return;
+  finishCapture();
+}
+
+bool MainWindow::startCapture(const QString& path, size_t frameLimit) {
+  if (glWidget->isCapturing()) finishCapture();
+
+  s21::RecordOptions options;
+  options.format = CaptureFormatAt(ui->captureFormatCombo->currentIndex());
+  options.path = path.toStdString();
+  options.fps = kCaptureFps;
+  options.frame_limit = frameLimit;
+
+  s21::FrameRecorder::ImageWriter writer;
+  if (options.format == s21::CaptureFormat::kJpeg) {
+    // QImage можно использовать вне потока GUI; строки кадра снизу вверх
+    writer = [](const s21::CaptureFrame& frame, const std::string& file) {
+      const QImage image(frame.pixels.data(), static_cast<int>(frame.width),
+                         static_cast<int>(frame.height),
+                         static_cast<int>(frame.width * 4),
+                         QImage::Format_RGBA8888);
+      return image.mirrored().save(QString::fromStdString(file), "JPG",
+                                   kJpegQuality);
+    };
+  }
+  if (!frameRecorder_.Start(options, writer,
+                            [this] { emit captureFinished(); })) {
+    QMessageBox::warning(this, tr("Ошибка"),
+                         tr("Не удалось начать запись ") + path);
+    return false;
+  }
+  glWidget->startCapture(&frameRecorder_);
+  return true;
+}
+
+void MainWindow::finishCapture() {
+  glWidget->stopCapture();
+  const s21::RecordStats stats = frameRecorder_.Stop();
+  {
+    const QSignalBlocker blocker(ui->recordButton);
+    ui->recordButton->setChecked(false);
+  }
+  ui->screenshotButton->setEnabled(true);
+  ui->captureFormatCombo->setEnabled(true);
+
+  const QString path = QString::fromStdString(frameRecorder_.GetOptions().path);
+  if (stats.error || stats.frames_written == 0) {
+    QMessageBox::warning(this, tr("Ошибка"),
+                         tr("Не удалось записать файл ") + path);
+    return;
+  }
+  statusBar()->showMessage(tr("Записано кадров: %1, пропущено: %2 (%3)")
+                               .arg(static_cast<qint64>(stats.frames_written))
+                               .arg(static_cast<qint64>(stats.frames_dropped))
+                               .arg(path));
+}
+
+void MainWindow::showCurrentModel(const QString& path) {
+  auto* model = s21::ModelManager::GetInstance().GetModel();
+  if (!model) return;
+
+  ui->filePathEdit->setText(path);
+  ui->visualizationLabel->setText("Модель загружена:\n" +
+                                  QFileInfo(path).fileName());
+  glWidget->setModelData(&model->GetVertices(), &model->GetEdges(),
+                         &model->GetBvh());
+  // Модель уже в своём положении: слайдеры только показывают его
+  transformTimer_->stop();
+  updateTransformControls();
+  onModelTransformed();
+  startLodBuild();
+
+  updateInfoPanelFromModel();
+  updateResidentModels();
+  updateSceneControls();
+}
+
+void MainWindow::updateTransformControls() {
+  if (!controller_) return;
+  const s21::TransformState& state = controller_->GetTransformState();
+  // Без сигналов: значения слайдеров не должны менять состояние модели
+  auto setSlider = [](QSlider* slider, float value) {
+    slider->blockSignals(true);
+    slider->setValue(qRound(value));
+    slider->blockSignals(false);
+  };
+  setSlider(ui->translateXSlider, state.translate_x * 10.0f);
+  setSlider(ui->translateYSlider, state.translate_y * 10.0f);
+  setSlider(ui->translateZSlider, state.translate_z * 10.0f);
+  setSlider(ui->rotateXSlider, state.rotate_x);
+  setSlider(ui->rotateYSlider, state.rotate_y);
+  setSlider(ui->rotateZSlider, state.rotate_z);
+  setSlider(ui->scaleFactorSlider, state.scale * 100.0f);
+
+  ui->translateXEdit->setText(QString::number(state.translate_x, 'f', 1));
+  ui->translateYEdit->setText(QString::number(state.translate_y, 'f', 1));
+  ui->translateZEdit->setText(QString::number(state.translate_z, 'f', 1));
+  ui->rotateXEdit->setText(QString::number(qRound(state.rotate_x)));
+  ui->rotateYEdit->setText(QString::number(qRound(state.rotate_y)));
+  ui->rotateZEdit->setText(QString::number(qRound(state.rotate_z)));
+  ui->scaleFactorEdit->setText(QString::number(state.scale, 'f', 2));
+}
+
+void MainWindow::onSceneInstancesChanged(int value) {
+  if (!controller_) return;
+  controller_->SetSceneInstances(static_cast<uint32_t>(value));
+  glWidget->setScene(&controller_->GetScene());
+}
 
-  if (ok) {
-    auto* model = s21::ModelManager::GetInstance().GetModel();
+void MainWindow::onClearSceneClicked() {
+  if (!controller_) return;
+  controller_->ClearScene();
+  updateSceneControls();
+}
 
-    if (model) {
-      ui->filePathEdit->setText(filePath);
-      ui->visualizationLabel->setText("Модель загружена:\n" +
-                                      QFileInfo(filePath).fileName());
-      //   glWidget->setModelData(model->GetVertices(), model->GetEdges());
-      glWidget->setModelData(&model->GetVertices(), model->GetEdges());
+void MainWindow::updateSceneControls() {
+  if (!controller_) return;
+  // Загрузка могла заменить модель сцены: виджет сверит состав сам
+  glWidget->setScene(&controller_->GetScene());
+  ui->sceneInstancesSpinBox->blockSignals(true);
+  ui->sceneInstancesSpinBox->setValue(
+      static_cast<int>(controller_->GetSceneInstances()));
+  ui->sceneInstancesSpinBox->blockSignals(false);
+}
 
-      updateInfoPanelFromModel();
-    } else {
-      auto* model = s21::ModelManager::GetInstance().GetModel();
-      const QString err =
-          model ? QString::fromStdString(model->GetLastErrorString())
-                : tr("Не удалось загрузить модель");
-      QMessageBox::warning(this, tr("Ошибка загрузки"), err);
-      // очистим инфо-панель
-      ui->filePathEdit->clear();
+void MainWindow::startLodBuild() {
+  auto& manager = s21::ModelManager::GetInstance();
+  auto* model = manager.GetModel();
+  lodApplied_ = false;
+  // В режиме kBake команды меняют вершины, и уровни сразу бы устарели
+  if (!model || manager.GetTransformMode() != s21::TransformMode::kMatrix) {
+    return;
+  }
+  lodBuilder_.Start(*model, [this] { emit lodReady(); });
+}
 
-      updateInfoPanel();
-    }
+void MainWindow::stopLodBuild() { lodBuilder_.Stop(); }
+
+void MainWindow::onLodReady() {
+  auto* model = s21::ModelManager::GetInstance().GetModel();
+  s21::LodSet lod;
+  // Запоздавшее уведомление отменённого построения ничего не отдаёт
+  if (!model || !lodBuilder_.TakeResult(model->GetPathFile(), lod)) return;
+
+  lodApplied_ = true;
+  if (!lod.levels.empty()) glWidget->setLodSet(std::move(lod));
+}
+
+void MainWindow::updateResidentModels() {
+  ui->residentModelsCombo->blockSignals(true);
+  ui->residentModelsCombo->clear();
+  for (const std::string& path : controller_->GetResidentModels()) {
+    const QString qpath = QString::fromStdString(path);
+    ui->residentModelsCombo->addItem(QFileInfo(qpath).fileName(), qpath);
   }
+  ui->residentModelsCombo->setCurrentIndex(0);
+  ui->residentModelsCombo->setEnabled(ui->residentModelsCombo->count() > 1);
+  ui->residentModelsCombo->blockSignals(false);
 }
 
 void MainWindow::updateInfoPanel() {
@@ -208,6 +573,49 @@ void MainWindow::updateInfoPanel() {
   ui->infoEdges->setText("0");
 }
 
+void MainWindow::onModelTransformed() {
+  auto& manager = s21::ModelManager::GetInstance();
+  auto* model = manager.GetModel();
+  if (!model) return;
+
+  if (manager.GetTransformMode() == s21::TransformMode::kMatrix) {
+    glWidget->setModelMatrix(model->GetTransform());
+  } else if (controller_ && controller_->GetVertexBaker().IsBusy()) {
+    // Вершины пересчитываются в фоне: кадр придёт снимком (onVerticesBaked)
+    glWidget->update();
+  } else {
+    // AABB иерархии пересчитываются здесь, если команда содержала поворот
+    model->GetBvh();
+    glWidget->updateVertices();
+  }
+}
+
+void MainWindow::onVerticesBaked() { glWidget->update(); }
+
+void MainWindow::onPicked(const s21::PickResult& result) {
+  auto* model = s21::ModelManager::GetInstance().GetModel();
+  if (!model || result.kind == s21::PickResult::Kind::kNone) {
+    statusBar()->clearMessage();
+    return;
+  }
+
+  if (result.kind == s21::PickResult::Kind::kVertex) {
+    // Координаты в системе модели, без накопленной матрицы
+    const s21::Vertex& v = model->GetVertices()[result.vertex];
+    statusBar()->showMessage(tr("Вершина %1: (%2, %3, %4)")
+                                 .arg(result.vertex)
+                                 .arg(v.x, 0, 'f', 4)
+                                 .arg(v.y, 0, 'f', 4)
+                                 .arg(v.z, 0, 'f', 4));
+  } else {
+    const s21::Edge& edge = model->GetEdges()[result.edge];
+    statusBar()->showMessage(tr("Ребро %1: вершины %2 - %3")
+                                 .arg(result.edge)
+                                 .arg(edge.first)
+                                 .arg(edge.second));
+  }
+}
+
 void MainWindow::updateInfoPanelFromModel() {
   if (!controller_) return;
 
@@ -225,100 +633,52 @@ void MainWindow::updateInfoPanelFromModel() {
   }
 }
 
+void MainWindow::onTransformTimeout() {
+  if (controller_ && controller_->ApplyTransformStateAsync()) {
+    onModelTransformed();
+  }
+}
+
 // --- Перемещение: слайдер -> поле ---
 void MainWindow::onTranslateXSliderChanged(int value) {
-  double val = value / 10.0;
+  const float val = value / 10.0f;
   ui->translateXEdit->setText(QString::number(val, 'f', 1));
-  double temp = val;
-  val -= res_sdvigX_;
-  res_sdvigX_ = temp;
-  if (controller_) {
-    controller_->TranslateModel(val, 0.0, 0.0);  // делаем через контроллер
-    glWidget->update();                          // перерисовать
-  }
+  updateTransformState([val](s21::TransformState& s) { s.translate_x = val; });
 }
 
 void MainWindow::onTranslateYSliderChanged(int value) {
-  double val = value / 10.0;
+  const float val = value / 10.0f;
   ui->translateYEdit->setText(QString::number(val, 'f', 1));
-  double temp = val;
-  val -= res_sdvigY_;
-  res_sdvigY_ = temp;
-
-  if (controller_) {
-    controller_->TranslateModel(0.0, val, 0.0);
-    glWidget->update();
-  }
+  updateTransformState([val](s21::TransformState& s) { s.translate_y = val; });
 }
 
 void MainWindow::onTranslateZSliderChanged(int value) {
-  double val = value / 10.0;
+  const float val = value / 10.0f;
   ui->translateZEdit->setText(QString::number(val, 'f', 1));
-
-  double temp = val;
-  val -= res_sdvigZ_;
-  res_sdvigZ_ = temp;
-  if (controller_) {
-    controller_->TranslateModel(0.0, 0.0, val);
-    glWidget->update();
-  }
+  updateTransformState([val](s21::TransformState& s) { s.translate_z = val; });
 }
 
 // --- Поворот ---
 void MainWindow::onRotateXSliderChanged(int value) {
   ui->rotateXEdit->setText(QString::number(value));
-
-  double temp = value;
-  value -= res_virtX_;
-  res_virtX_ = temp;
-
-  if (controller_) {
-    controller_->RotateModel(value, 0.0, 0.0);
-    glWidget->update();
-  }
+  updateTransformState([value](s21::TransformState& s) { s.rotate_x = value; });
 }
 
 void MainWindow::onRotateYSliderChanged(int value) {
   ui->rotateYEdit->setText(QString::number(value));
-
-  double temp = value;
-  value -= res_virtY_;
-  res_virtY_ = temp;
-
-  if (controller_) {
-    controller_->RotateModel(0.0, value, 0.0);
-    glWidget->update();
-  }
+  updateTransformState([value](s21::TransformState& s) { s.rotate_y = value; });
 }
 
 void MainWindow::onRotateZSliderChanged(int value) {
   ui->rotateZEdit->setText(QString::number(value));
-
-  double temp = value;
-  value -= res_virtZ_;
-  res_virtZ_ = temp;
-
-  if (controller_) {
-    controller_->RotateModel(0.0, 0.0, value);
-    glWidget->update();
-  }
+  updateTransformState([value](s21::TransformState& s) { s.rotate_z = value; });
 }
 
 // --- Масштаб ---
 void MainWindow::onScaleSliderChanged(int value) {
-  double val = value / 100.0;  // абсолютное значение слайдера
+  const float val = value / 100.0f;  // абсолютное значение слайдера
   ui->scaleFactorEdit->setText(QString::number(val, 'f', 2));
-
-  double factor = 1.0;
-  if (res_scale_ != 0.0) {
-    factor = val / res_scale_;  // вычисляем приращение
-  }
-  res_scale_ = val;  // сохраняем новое состояние
-
-  if (controller_) {
-    controller_->ScaleModel(factor);  // масштабируем на приращение
-    glWidget->update();
-  }
+  updateTransformState([val](s21::TransformState& s) { s.scale = val; });
 }
 
 // --- Редактирование текста: поле -> слайдер ---
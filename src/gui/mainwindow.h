@@ -13,19 +13,27 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
+#include <QCheckBox>
 #include <QColorDialog>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QImage>
 #include <QLineEdit>
 #include <QMainWindow>
 #include <QMessageBox>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QSlider>
+#include <QStatusBar>
 #include <QTextStream>
+#include <QTimer>
 
 #include "../controller/controller.hpp"
+#include "../patterns/frame_recorder.hpp"
+#include "../patterns/lod_builder.hpp"
 #include "glwidget.h"
 
 QT_BEGIN_NAMESPACE
@@ -61,14 +69,130 @@ class MainWindow : public QMainWindow {
    */
   ~MainWindow();
 
+ signals:
+  /**
+   * @brief Прогресс фоновой загрузки (испускается из фонового потока).
+   *
+   * @param bytes Обработано байт файла.
+   * @param total Размер файла.
+   * @param vertices Прочитано вершин.
+   * @param faces Прочитано полигонов.
+   */
+  void loadProgress(qint64 bytes, qint64 total, qint64 vertices,
+                    qint64 faces);
+
+  /**
+   * @brief Фоновая загрузка завершена (испускается из фонового потока).
+   */
+  void loadFinished();
+
+  /**
+   * @brief Уровни детализации построены (испускается из фонового потока).
+   */
+  void lodReady();
+
+  /**
+   * @brief Вершины пересчитаны в фоне (испускается из фонового потока).
+   */
+  void verticesBaked();
+
+  /**
+   * @brief Записано заданное число кадров (испускается из фонового
+   * потока).
+   */
+  void captureFinished();
+
  private slots:
   /**
    * @brief Обработчик нажатия кнопки загрузки модели.
    *
-   * Открывает диалог выбора файла и загружает выбранную модель.
+   * Открывает диалог выбора файла и запускает фоновую загрузку выбранной
+   * модели. Во время загрузки кнопка отменяет её.
    */
   void onLoadButtonClicked();
 
+  /**
+   * @brief Показывает прогресс фоновой загрузки.
+   */
+  void onLoadProgress(qint64 bytes, qint64 total, qint64 vertices,
+                      qint64 faces);
+
+  /**
+   * @brief Завершает фоновую загрузку в потоке GUI.
+   *
+   * При успехе подменяет текущую модель и передаёт её в виджет отрисовки;
+   * до этого момента отображается предыдущая модель.
+   */
+  void onLoadFinished();
+
+  /**
+   * @brief Делает текущей модель, выбранную в списке загруженных.
+   *
+   * Модель берётся из памяти без чтения файла; если файл изменился, он
+   * загружается заново.
+   *
+   * @param index Индекс в списке residentModelsCombo.
+   */
+  void onResidentModelActivated(int index);
+
+  /**
+   * @brief Передаёт построенные уровни детализации в виджет отрисовки.
+   */
+  void onLodReady();
+
+  /**
+   * @brief Перерисовывает модель по снимку вершин, пересчитанных в фоне.
+   */
+  void onVerticesBaked();
+
+  /**
+   * @brief Сохраняет текущий кадр в файл выбранного формата.
+   */
+  void onScreenshotClicked();
+
+  /**
+   * @brief Начинает или завершает запись кадров.
+   *
+   * @param checked true - выбрать файл и начать запись.
+   */
+  void onRecordToggled(bool checked);
+
+  /**
+   * @brief Завершает снимок или запись, записавшую все кадры.
+   */
+  void onCaptureFinished();
+  /**
+   * @brief Задаёт число экземпляров текущей модели в сцене.
+   *
+   * @param value Значение sceneInstancesSpinBox (0 - убрать из сцены).
+   */
+  void onSceneInstancesChanged(int value);
+  /**
+   * @brief Убирает из сцены все модели.
+   */
+  void onClearSceneClicked();
+
+  /**
+   * @brief Показывает в строке состояния вершину или ребро под курсором.
+   *
+   * @param result Результат выбора мышью в виджете отрисовки.
+   */
+  void onPicked(const s21::PickResult& result);
+
+  /**
+   * @brief Сохраняет собранные показатели производительности в файл.
+   *
+   * Формат выбирается по расширению: .csv или .json.
+   */
+  void onExportMetricsClicked();
+
+  /**
+   * @brief Применяет накопленное состояние трансформации к модели.
+   *
+   * Вызывается таймером не чаще раза за кадр, сколько бы событий
+   * слайдеров ни пришло за это время.
+   */
+  void onTransformTimeout();
   /**
    * @brief Обработчик изменения значения слайдера перемещения по X.
    *
@@ -182,18 +306,19 @@ class MainWindow : public QMainWindow {
 
   GLWidget* glWidget;  ///< Виджет для отрисовки 3D модели
 
-  double res_sdvigX_{0.0};  ///< Текущее значение перемещения по X
-  double res_sdvigY_{0.0};  ///< Текущее значение перемещения по Y
-  double res_sdvigZ_{0.0};  ///< Текущее значение перемещения по Z
-
-  double res_virtX_{0.0};  ///< Текущее значение поворота вокруг X
-  double res_virtY_{0.0};  ///< Текущее значение поворота вокруг Y
-  double res_virtZ_{0.0};  ///< Текущее значение поворота вокруг Z
-
-  double res_scale_ = 1.0;  ///< Текущее значение масштаба
+  QTimer* transformTimer_;  ///< Объединяет изменения слайдеров по кадрам
 
   s21::Controller* controller_;  ///< Указатель на контроллер приложения
 
+  QProgressBar* loadProgressBar_;  ///< Прогресс фоновой загрузки
+  QString loadingPath_;      ///< Файл, который сейчас загружается
+  bool loading_ = false;     ///< Идёт фоновая загрузка
+  bool loadCancelled_ = false;  ///< Пользователь отменил загрузку
+  QElapsedTimer loadTimer_;  ///< Время фоновой загрузки
+  s21::LodBuilder lodBuilder_;  ///< Фоновое построение уровней детализации
+  bool lodApplied_ = false;  ///< Уровни текущей модели переданы в glWidget
+  s21::FrameRecorder frameRecorder_;  ///< Фоновая запись кадров glWidget
+
   /**
    * @brief Настраивает соединения сигналов и слотов.
    *
@@ -214,6 +339,83 @@ class MainWindow : public QMainWindow {
    * Заполняет панель информацией о количестве вершин и рёбер модели.
    */
   void updateInfoPanelFromModel();
+
+  /**
+   * @brief Начинает передавать кадры glWidget в frameRecorder_.
+   *
+   * @param path Файл GIF или путь без расширения для кадров BMP и JPEG
+   * (при frameLimit == 1 - файл снимка).
+   * @param frameLimit Записать не больше кадров (0 - до остановки).
+   * @return false если запись не началась (сообщение уже показано).
+   */
+  bool startCapture(const QString& path, size_t frameLimit);
+
+  /**
+   * @brief Завершает запись и выводит её итоги в строке состояния.
+   */
+  void finishCapture();
+
+  /**
+   * @brief Изменяет абсолютное состояние трансформации и планирует его
+   * применение.
+   *
+   * @param change Изменяет копию текущего состояния.
+   */
+  template <typename Change>
+  void updateTransformState(Change change) {
+    if (!controller_) return;
+    s21::TransformState state = controller_->GetTransformState();
+    change(state);
+    controller_->SetTransformState(state);
+    if (!transformTimer_->isActive()) transformTimer_->start();
+  }
+  /**
+   * @brief Передаёт результат трансформации в виджет отрисовки.
+   *
+   * В режиме TransformMode::kMatrix виджет получает новую матрицу модели,
+   * иначе перезагружает изменённые вершины.
+   */
+  void onModelTransformed();
+
+  /**
+   * @brief Передаёт текущую модель в виджет отрисовки и обновляет панели.
+   *
+   * @param path Путь к файлу текущей модели.
+   */
+  void showCurrentModel(const QString& path);
+
+  /**
+   * @brief Выставляет слайдеры и поля по положению текущей модели.
+   */
+  void updateTransformControls();
+
+  /**
+   * @brief Запускает построение уровней детализации текущей модели.
+   */
+  void startLodBuild();
+
+  /**
+   * @brief Останавливает построение уровней детализации.
+   *
+   * Вызывается перед любой сменой текущей модели: построитель читает её
+   * вершины и рёбра без копирования.
+   */
+  void stopLodBuild();
+
+  /**
+   * @brief Заполняет список загруженных моделей.
+   */
+  void updateResidentModels();
+  /**
+   * @brief Передаёт сцену в виджет отрисовки и показывает число
+   * экземпляров текущей модели.
+   */
+  void updateSceneControls();
+
+  /**
+   * @brief Запускает фоновую загрузку файла.
+   */
+  void startAsyncLoad(const QString& filePath);
 };
 
 #endif  // MAINWINDOW_H
\ No newline at end of file
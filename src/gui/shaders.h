@@ -0,0 +1,96 @@
+/**
+ * @file shaders.h
+ * @brief Исходные тексты шейдеров GLSL для отрисовки каркаса.
+ *
+ * Тексты не содержат строки #version: её вместе с точностью для OpenGL ES
+ * добавляет GLWidget в зависимости от контекста (GLSL 1.30, 1.50 core или
+ * ES 3.00). Вершина модели передаётся в атрибуте 0 (position), матрица
+ * экземпляра - в атрибутах 1-4 (instance, по столбцу в каждом): при
+ * отрисовке с экземплярами это массив с делителем 1, иначе постоянное
+ * значение атрибута. Итоговое преобразование - mvp * instance * model.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef SHADERS_H
+#define SHADERS_H
+
+namespace shaders {
+
+/// Вершины модели: размер точки задаётся uniform-переменной
+inline constexpr const char* kPointVertex = R"(
+in vec3 position;
+in mat4 instance;
+uniform mat4 mvp;
+uniform mat4 model;
+uniform float point_size;
+
+void main() {
+  gl_Position = mvp * instance * model * vec4(position, 1.0);
+  gl_PointSize = point_size;
+}
+)";
+
+/// Круглые вершины - отбрасывание фрагментов за окружностью со сглаженным
+/// на один пиксель краем, квадратные - весь спрайт
+inline constexpr const char* kPointFragment = R"(
+uniform vec4 color;
+uniform float point_size;
+uniform int round_points;
+out vec4 frag_color;
+
+void main() {
+  float alpha = 1.0;
+  if (round_points != 0) {
+    float r = length(gl_PointCoord * 2.0 - 1.0);
+    if (r > 1.0) discard;
+    float edge = 2.0 / max(point_size, 1.0);
+    alpha = 1.0 - smoothstep(1.0 - edge, 1.0, r);
+  }
+  frag_color = vec4(color.rgb, color.a * alpha);
+}
+)";
+
+/// Рёбра: экранные координаты одного из концов отрезка (flat берёт
+/// значение последней вершины) для пунктира. Область вывода начинается в
+/// (0, 0), поэтому они совпадают с gl_FragCoord
+inline constexpr const char* kLineVertex = R"(
+in vec3 position;
+in mat4 instance;
+uniform mat4 mvp;
+uniform mat4 model;
+uniform vec2 viewport;
+flat out vec2 line_start;
+
+void main() {
+  vec4 clip = mvp * instance * model * vec4(position, 1.0);
+  gl_Position = clip;
+  line_start = (clip.xy / clip.w * 0.5 + 0.5) * viewport;
+}
+)";
+
+/// Пунктир как у glLineStipple: dash пикселей штрих, dash пикселей пропуск,
+/// отсчёт от конца отрезка; dash = 0 - сплошная линия. Расстояние берётся
+/// по gl_FragCoord, а не по интерполированной координате: в перспективе
+/// та интерполируется с поправкой на глубину и штрихи неравны, а
+/// noperspective нет в GLSL ES 3.00
+inline constexpr const char* kLineFragment = R"(
+uniform vec4 color;
+uniform float dash;
+flat in vec2 line_start;
+out vec4 frag_color;
+
+void main() {
+  if (dash > 0.0 &&
+      mod(length(gl_FragCoord.xy - line_start), 2.0 * dash) >= dash) {
+    discard;
+  }
+  frag_color = color;
+}
+)";
+
+}  // namespace shaders
+
+#endif  // SHADERS_H
@@ -0,0 +1,80 @@
+#include "thumbnail.h"
+
+#include <QColor>
+#include <QLineF>
+#include <QPainter>
+#include <QPen>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace {
+
+/// Поля вокруг модели в долях размера изображения
+constexpr float kMargin = 0.05f;
+/// Сколько рёбер передаётся в QPainter за один вызов
+constexpr size_t kLinesPerBatch = 4096;
+
+}  // namespace
+
+QImage RenderThumbnail(const s21::Model& model, int size) {
+  QImage image(size, size, QImage::Format_RGB32);
+  image.fill(QColor(30, 30, 30));
+
+  const auto& vertices = model.GetVertices();
+  if (vertices.empty()) return image;
+
+  // Изометрический вид: поворот вокруг X на 30°, вокруг Y на 45°
+  const s21::Matrix4 view =
+      s21::Matrix4::Rotation(30.0f, 45.0f, 0.0f) * model.GetTransform();
+
+  std::vector<QPointF> points(vertices.size());
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = min_x;
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = max_x;
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    float x = vertices[i].x, y = vertices[i].y, z = vertices[i].z;
+    view.Apply(x, y, z);
+    points[i] = QPointF(x, y);
+    min_x = std::min(min_x, x);
+    max_x = std::max(max_x, x);
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+  }
+
+  // Вписываем модель с сохранением пропорций, ось Y направлена вверх
+  const float extent = std::max({max_x - min_x, max_y - min_y, 1e-6f});
+  const float scale = static_cast<float>(size) * (1.0f - 2.0f * kMargin) /
+                      extent;
+  const float cx = (min_x + max_x) / 2.0f;
+  const float cy = (min_y + max_y) / 2.0f;
+  const float half = static_cast<float>(size) / 2.0f;
+  for (QPointF& p : points) {
+    p = QPointF(half + (p.x() - cx) * scale, half - (p.y() - cy) * scale);
+  }
+
+  QPainter painter(&image);
+  painter.setRenderHint(QPainter::Antialiasing);
+  painter.setPen(QPen(QColor(230, 230, 230), 1.0));
+
+  const auto& edges = model.GetEdges();
+  std::vector<QLineF> lines;
+  lines.reserve(std::min(edges.size(), kLinesPerBatch));
+  for (const s21::Edge& edge : edges) {
+    lines.emplace_back(points[edge.first], points[edge.second]);
+    if (lines.size() == kLinesPerBatch) {
+      painter.drawLines(lines.data(), static_cast<int>(lines.size()));
+      lines.clear();
+    }
+  }
+  if (!lines.empty()) {
+    painter.drawLines(lines.data(), static_cast<int>(lines.size()));
+  }
+  painter.end();
+  return image;
+}
+
+bool SaveThumbnail(const s21::Model& model, int size, const QString& path) {
+  return RenderThumbnail(model, size).save(path, "PNG");
+}
@@ -0,0 +1,40 @@
+/**
+ * @file thumbnail.h
+ * @brief Отрисовка миниатюры каркаса модели в PNG без окна.
+ *
+ * Рисует рёбра модели в QImage растровым QPainter: не нужны ни дисплей, ни
+ * контекст OpenGL, поэтому миниатюры можно создавать параллельно в рабочих
+ * потоках пакетной обработки.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef THUMBNAIL_H
+#define THUMBNAIL_H
+
+#include <QImage>
+#include <QString>
+
+#include "../model/model.hpp"
+
+/**
+ * @brief Рисует каркас модели в изометрической проекции.
+ *
+ * Модель вписывается в изображение с полями; учитывается матрица модели.
+ *
+ * @param model Модель.
+ * @param size Ширина и высота изображения в пикселях.
+ * @return Изображение (белые рёбра на тёмном фоне).
+ */
+QImage RenderThumbnail(const s21::Model& model, int size);
+
+/**
+ * @brief Рисует миниатюру и сохраняет её в PNG.
+ *
+ * @return true если файл записан.
+ */
+bool SaveThumbnail(const s21::Model& model, int size, const QString& path);
+
+#endif  // THUMBNAIL_H
@@ -8,7 +8,14 @@ int main(int argc, char* argv[]) {
   QApplication app(argc, argv);
 
   s21::ModelManager& model_manager = s21::ModelManager::GetInstance();
+  // Повторно открываемые модели читаются из двоичного кэша
+  model_manager.SetMeshCache(
+      s21::MeshCache(s21::MeshCache::DefaultDirectory()));
+  // Окно рисует только каркас: полигоны после разбора не нужны
+  model_manager.SetLoadMode(s21::LoadMode::kEdgesOnly);
   s21::Controller controller(model_manager);
+  // Слайдеры меняют только матрицу модели, вершины не пересчитываются
+  controller.SetTransformMode(s21::TransformMode::kMatrix);
 
   MainWindow window(&controller);
   window.setWindowTitle("3D Model Viewer");
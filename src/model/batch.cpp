@@ -0,0 +1,199 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#include "metrics.hpp"
+#include "thread_pool.hpp"
+
+namespace s21 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool IsObjFile(const std::filesystem::path& path) {
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(),
+                 [](unsigned char ch) { return std::tolower(ch); });
+  return ext == ".obj";
+}
+
+std::string FormatFixed(double value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+  return buffer;
+}
+
+/**
+ * @brief Загружает файл files[index] и заполняет result.
+ */
+void ProcessFile(const std::vector<std::string>& files, size_t index,
+                 const BatchOptions& options, bool parallel,
+                 BatchResult& result) {
+  const std::string& path = files[index];
+  result.path = path;
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  result.bytes = ec ? 0 : static_cast<size_t>(size);
+
+  // В режиме kEdgesOnly полигоны не хранятся, их число берётся из прогресса.
+  // Последний отчёт каждого куска учитывает все его полигоны, поэтому
+  // максимум по отчётам равен итоговому числу.
+  size_t parsed_faces = 0;
+  LoadOptions load;
+  load.parallel = parallel;
+  load.mode = options.mode;
+  load.weld = options.weld;
+  if (options.mode == LoadMode::kEdgesOnly) {
+    load.progress = [&parsed_faces](const LoadProgress& progress) {
+      parsed_faces = std::max(parsed_faces, progress.faces);
+    };
+  }
+
+  Model model;
+  const auto start = Clock::now();
+  const bool loaded = model.LoadFromFile(path, load);
+  const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+  result.load_ms = elapsed.count();
+
+  // Файл с пропущенными строками загружается, а ошибка остаётся в отчёте
+  result.error = model.GetLastError();
+  if (result.error != Model::ErrorCode::kSuccess) {
+    result.message = model.GetLastErrorString();
+  }
+  if (!loaded) return;
+  result.welded = options.weld;
+  result.weld = model.GetWeldStats();
+  result.vertices = model.GetVertexCount();
+  result.edges = model.GetEdgeCount();
+  result.faces = options.mode == LoadMode::kEdgesOnly
+                     ? parsed_faces
+                     : model.GetPolygonCount();
+  if (options.on_loaded) options.on_loaded(index, model, result);
+}
+
+}  // namespace
+
+size_t BatchReport::GetFailedCount() const {
+  return static_cast<size_t>(
+      std::count_if(results.begin(), results.end(), [](const BatchResult& r) {
+        return r.error != Model::ErrorCode::kSuccess;
+      }));
+}
+
+double BatchReport::GetFilesPerSecond() const {
+  return seconds > 0 ? static_cast<double>(results.size()) / seconds : 0;
+}
+
+std::vector<std::string> CollectModelFiles(
+    const std::vector<std::string>& inputs, bool recursive) {
+  namespace fs = std::filesystem;
+  std::vector<std::string> files;
+  for (const std::string& input : inputs) {
+    std::error_code ec;
+    if (!fs::is_directory(input, ec)) {
+      // Несуществующий файл попадёт в отчёт с ошибкой kFileOpenError
+      files.push_back(input);
+      continue;
+    }
+
+    std::vector<std::string> found;
+    auto add = [&found](const fs::directory_entry& entry) {
+      std::error_code entry_ec;
+      if (entry.is_regular_file(entry_ec) && IsObjFile(entry.path())) {
+        found.push_back(entry.path().string());
+      }
+    };
+    if (recursive) {
+      for (const auto& entry : fs::recursive_directory_iterator(
+               input, fs::directory_options::skip_permission_denied, ec)) {
+        add(entry);
+      }
+    } else {
+      for (const auto& entry : fs::directory_iterator(input, ec)) add(entry);
+    }
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+  }
+  return files;
+}
+
+BatchReport RunBatch(const std::vector<std::string>& files,
+                     const BatchOptions& options) {
+  ScopedTimer timer("batch.total");
+  ThreadPool& pool = ThreadPool::GetInstance();
+
+  BatchReport report;
+  report.results.resize(files.size());
+  report.threads = pool.GetThreadCount();
+  const bool parallel_parse = files.size() < report.threads;
+
+  const auto start = Clock::now();
+  pool.ParallelFor(files.size(), [&](size_t i) {
+    ProcessFile(files, i, options, parallel_parse, report.results[i]);
+  });
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  report.seconds = elapsed.count();
+  return report;
+}
+
+const char* ErrorCodeName(Model::ErrorCode code) {
+  switch (code) {
+    case Model::ErrorCode::kSuccess:
+      return "success";
+    case Model::ErrorCode::kFileOpenError:
+      return "file_open_error";
+    case Model::ErrorCode::kInvalidData:
+      return "invalid_data";
+    case Model::ErrorCode::kNoValidData:
+      return "no_valid_data";
+    case Model::ErrorCode::kCancelled:
+      return "cancelled";
+  }
+  return "unknown";
+}
+
+std::string BatchReportToJson(const BatchReport& report) {
+  std::string json = "{\"files\": " + std::to_string(report.results.size()) +
+                     ", \"failed\": " + std::to_string(report.GetFailedCount()) +
+                     ", \"threads\": " + std::to_string(report.threads) +
+                     ", \"seconds\": " + FormatFixed(report.seconds) +
+                     ", \"files_per_second\": " +
+                     FormatFixed(report.GetFilesPerSecond()) +
+                     ", \"results\": [";
+  bool first = true;
+  for (const BatchResult& r : report.results) {
+    json += first ? "\n" : ",\n";
+    first = false;
+    json += "  {\"path\": " + JsonString(r.path) +
+            ", \"status\": \"" + ErrorCodeName(r.error) + "\"" +
+            ", \"code\": " + std::to_string(static_cast<int>(r.error));
+    if (!r.message.empty()) json += ", \"message\": " + JsonString(r.message);
+    json += ", \"bytes\": " + std::to_string(r.bytes) +
+            ", \"vertices\": " + std::to_string(r.vertices) +
+            ", \"edges\": " + std::to_string(r.edges) +
+            ", \"faces\": " + std::to_string(r.faces) +
+            ", \"load_ms\": " + FormatFixed(r.load_ms);
+    if (r.welded) {
+      json += ", \"welded_vertices\": " +
+              std::to_string(r.weld.vertices_removed) +
+              ", \"welded_edges\": " + std::to_string(r.weld.edges_removed) +
+              ", \"welded_faces\": " +
+              std::to_string(r.weld.polygons_removed);
+    }
+    if (!r.thumbnail.empty()) {
+      json += ", \"thumbnail\": " + JsonString(r.thumbnail);
+    }
+    json += "}";
+  }
+  json += first ? "]}\n" : "\n]}\n";
+  return json;
+}
+
+}  // namespace s21
@@ -0,0 +1,126 @@
+/**
+ * @file batch.hpp
+ * @brief Пакетная обработка моделей без графического интерфейса.
+ *
+ * Загружает список файлов параллельно в ThreadPool (по файлу на задачу),
+ * собирает количество вершин, рёбер и полигонов и коды ошибок и выводит
+ * отчёт в JSON. Используется консольной программой 3DViewer_batch для
+ * проверки и обработки загруженных пользователями моделей.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "model.hpp"
+
+namespace s21 {
+
+/**
+ * @struct BatchResult
+ * @brief Результат обработки одного файла.
+ */
+struct BatchResult {
+  std::string path;  ///< Путь к файлу
+  Model::ErrorCode error = Model::ErrorCode::kSuccess;  ///< Код ошибки
+  std::string message;    ///< Текст ошибки (пустой при kSuccess)
+  size_t bytes = 0;       ///< Размер файла
+  size_t vertices = 0;    ///< Количество вершин
+  size_t edges = 0;       ///< Количество рёбер
+  size_t faces = 0;       ///< Количество полигонов
+  double load_ms = 0;     ///< Время загрузки
+  bool welded = false;    ///< Вершины сливались (BatchOptions::weld)
+  WeldStats weld;         ///< Сколько вершин, рёбер и полигонов удалено
+  std::string thumbnail;  ///< Путь к миниатюре (пустой - не создавалась)
+};
+
+/**
+ * @struct BatchOptions
+ * @brief Параметры пакетной обработки.
+ */
+struct BatchOptions {
+  /// Режим загрузки: kEdgesOnly экономит память, полигоны только считаются
+  LoadMode mode = LoadMode::kFull;
+  /// Слить совпадающие вершины после загрузки (LoadOptions::weld); vertices
+  /// и edges в результатах - после слияния
+  bool weld = false;
+  /// Вызывается после успешной загрузки файла в рабочем потоке пула
+  /// (например, для миниатюры) с номером файла в списке. Вызовы для разных
+  /// файлов идут параллельно.
+  std::function<void(size_t, const Model&, BatchResult&)> on_loaded;
+};
+
+/**
+ * @struct BatchReport
+ * @brief Итоги пакетной обработки.
+ */
+struct BatchReport {
+  std::vector<BatchResult> results;  ///< Результаты в порядке входных файлов
+  size_t threads = 0;                ///< Число потоков обработки
+  double seconds = 0;                ///< Общее время обработки
+
+  /**
+   * @brief Количество файлов, загруженных с ошибкой.
+   */
+  size_t GetFailedCount() const;
+
+  /**
+   * @brief Пропускная способность в файлах в секунду.
+   */
+  double GetFilesPerSecond() const;
+};
+
+/**
+ * @brief Составляет список файлов моделей.
+ *
+ * Файлы из inputs берутся как есть, каталоги заменяются отсортированным
+ * списком файлов .obj (без учёта регистра расширения).
+ *
+ * @param inputs Пути к файлам и каталогам.
+ * @param recursive Обходить вложенные каталоги.
+ * @return Пути к файлам.
+ */
+std::vector<std::string> CollectModelFiles(
+    const std::vector<std::string>& inputs, bool recursive);
+
+/**
+ * @brief Загружает файлы параллельно и собирает результаты.
+ *
+ * Если файлов не меньше, чем потоков в пуле, каждый файл разбирается в одном
+ * потоке: параллелизм по файлам не требует синхронизации внутри разбора.
+ * Иначе каждый файл дополнительно разбирается многопоточно.
+ *
+ * @param files Пути к файлам.
+ * @param options Параметры обработки.
+ * @return Отчёт.
+ */
+BatchReport RunBatch(const std::vector<std::string>& files,
+                     const BatchOptions& options = BatchOptions());
+
+/**
+ * @brief Имя кода ошибки для отчёта ("success", "file_open_error", ...).
+ */
+const char* ErrorCodeName(Model::ErrorCode code);
+
+/**
+ * @brief Отчёт в формате JSON.
+ *
+ * {"files": N, "failed": N, "threads": N, "seconds": S, "files_per_second": F,
+ *  "results": [{"path": ..., "status": ..., "vertices": ..., ...}, ...]}
+ *
+ * При слиянии вершин в результат добавляются "welded_vertices",
+ * "welded_edges" и "welded_faces".
+ */
+std::string BatchReportToJson(const BatchReport& report);
+
+}  // namespace s21
+
+#endif  // BATCH_HPP
@@ -0,0 +1,346 @@
+#include "bvh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "metrics.hpp"
+#include "radix_sort.hpp"
+#include "thread_pool.hpp"
+
+namespace s21 {
+
+namespace {
+
+/// Ячеек сетки кода Мортона по каждой оси (10 бит на ось)
+constexpr float kMortonCells = 1023.0f;
+
+/// Листьев в одной задаче пула при пересчёте AABB
+constexpr size_t kRefitLeavesPerTask = 64;
+
+/// Перемежает 10 младших бит числа двумя нулевыми битами
+uint32_t SpreadBits(uint32_t v) {
+  v &= 0x3ff;
+  v = (v | v << 16) & 0x030000ff;
+  v = (v | v << 8) & 0x0300f00f;
+  v = (v | v << 4) & 0x030c30c3;
+  v = (v | v << 2) & 0x09249249;
+  return v;
+}
+
+void Include(BoundingBox& box, const Vertex& v) {
+  box.min = {std::min(box.min.x, v.x), std::min(box.min.y, v.y),
+             std::min(box.min.z, v.z)};
+  box.max = {std::max(box.max.x, v.x), std::max(box.max.y, v.y),
+             std::max(box.max.z, v.z)};
+}
+
+BoundingBox Union(const BoundingBox& a, const BoundingBox& b) {
+  BoundingBox box = a;
+  Include(box, b.min);
+  Include(box, b.max);
+  return box;
+}
+
+/**
+ * @brief Точка после проекции в пиксели области вывода.
+ */
+struct ScreenPoint {
+  float x = 0, y = 0;    ///< Координаты в пикселях
+  float z = 0, w = 0;    ///< Глубина и w в координатах отсечения
+  bool visible = false;  ///< Перед камерой и внутри глубины отсечения
+};
+
+ScreenPoint Project(const Matrix4& m, const Vertex& v, const PickQuery& q) {
+  ScreenPoint p;
+  const float cx = m(0, 0) * v.x + m(0, 1) * v.y + m(0, 2) * v.z + m(0, 3);
+  const float cy = m(1, 0) * v.x + m(1, 1) * v.y + m(1, 2) * v.z + m(1, 3);
+  p.z = m(2, 0) * v.x + m(2, 1) * v.y + m(2, 2) * v.z + m(2, 3);
+  p.w = m(3, 0) * v.x + m(3, 1) * v.y + m(3, 2) * v.z + m(3, 3);
+  if (p.w <= 1e-6f) return p;
+
+  p.x = (cx / p.w * 0.5f + 0.5f) * q.width;
+  p.y = (0.5f - cy / p.w * 0.5f) * q.height;
+  p.visible = p.z >= -p.w && p.z <= p.w;
+  return p;
+}
+
+float SegmentDistance(float px, float py, const ScreenPoint& a,
+                      const ScreenPoint& b) {
+  const float dx = b.x - a.x, dy = b.y - a.y;
+  const float length2 = dx * dx + dy * dy;
+  float t = length2 > 0 ? ((px - a.x) * dx + (py - a.y) * dy) / length2 : 0;
+  t = std::clamp(t, 0.0f, 1.0f);
+  return std::hypot(px - (a.x + t * dx), py - (a.y + t * dy));
+}
+
+/**
+ * @brief Может ли курсор попасть в элементы внутри параллелепипеда.
+ *
+ * Если часть углов позади камеры, проекция не ограничена - узел
+ * раскрывается.
+ */
+bool MayContain(const BoundingBox& box, const Matrix4& mvp,
+                const PickQuery& q) {
+  float min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+  bool all_near = true, all_far = true;
+  for (int corner = 0; corner < 8; ++corner) {
+    const Vertex v{corner & 1 ? box.max.x : box.min.x,
+                   corner & 2 ? box.max.y : box.min.y,
+                   corner & 4 ? box.max.z : box.min.z};
+    const ScreenPoint p = Project(mvp, v, q);
+    if (p.w <= 1e-6f) return true;
+    all_near = all_near && p.z < -p.w;
+    all_far = all_far && p.z > p.w;
+    if (corner == 0) {
+      min_x = max_x = p.x;
+      min_y = max_y = p.y;
+    } else {
+      min_x = std::min(min_x, p.x);
+      max_x = std::max(max_x, p.x);
+      min_y = std::min(min_y, p.y);
+      max_y = std::max(max_y, p.y);
+    }
+  }
+  if (all_near || all_far) return false;
+  return q.x >= min_x - q.radius && q.x <= max_x + q.radius &&
+         q.y >= min_y - q.radius && q.y <= max_y + q.radius;
+}
+
+}  // namespace
+
+Frustum Frustum::FromMatrix(const Matrix4& mvp) {
+  // Плоскости отсечения -w <= x, y, z <= w, выраженные через строки матрицы
+  Frustum frustum;
+  for (int axis = 0; axis < 3; ++axis) {
+    for (int col = 0; col < 4; ++col) {
+      frustum.planes[axis * 2][col] = mvp(3, col) + mvp(axis, col);
+      frustum.planes[axis * 2 + 1][col] = mvp(3, col) - mvp(axis, col);
+    }
+  }
+  return frustum;
+}
+
+Frustum::Side Frustum::Classify(const BoundingBox& box) const {
+  Side side = Side::kInside;
+  for (const auto& p : planes) {
+    // Ближайший к плоскости и самый дальний от неё углы параллелепипеда
+    const float far = p[0] * (p[0] >= 0 ? box.max.x : box.min.x) +
+                      p[1] * (p[1] >= 0 ? box.max.y : box.min.y) +
+                      p[2] * (p[2] >= 0 ? box.max.z : box.min.z) + p[3];
+    if (far < 0) return Side::kOutside;
+    const float near = p[0] * (p[0] >= 0 ? box.min.x : box.max.x) +
+                       p[1] * (p[1] >= 0 ? box.min.y : box.max.y) +
+                       p[2] * (p[2] >= 0 ? box.min.z : box.max.z) + p[3];
+    if (near < 0) side = Side::kIntersect;
+  }
+  return side;
+}
+
+void Bvh::Build(const std::vector<Vertex>& vertices,
+                const std::vector<Edge>& edges, uint32_t leaf_size) {
+  Clear();
+  if (edges.empty() || vertices.empty()) return;
+
+  ScopedTimer timer("bvh.build");
+  BoundingBox bounds;
+  bounds.min = bounds.max = vertices.front();
+  for (const Vertex& v : vertices) Include(bounds, v);
+
+  // Ключ ребра: код Мортона середины в старших битах, номер в младших
+  auto scale = [](float min, float max) {
+    return max > min ? kMortonCells / (max - min) : 0.0f;
+  };
+  const float sx = scale(bounds.min.x, bounds.max.x);
+  const float sy = scale(bounds.min.y, bounds.max.y);
+  const float sz = scale(bounds.min.z, bounds.max.z);
+  auto cell = [](float value, float min, float to_cell) {
+    const float c = (value - min) * to_cell;
+    return static_cast<uint32_t>(std::clamp(c, 0.0f, kMortonCells));
+  };
+
+  std::vector<uint64_t> keys(edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    const Vertex& a = vertices[edges[i].first];
+    const Vertex& b = vertices[edges[i].second];
+    const uint32_t code =
+        SpreadBits(cell((a.x + b.x) * 0.5f, bounds.min.x, sx)) << 2 |
+        SpreadBits(cell((a.y + b.y) * 0.5f, bounds.min.y, sy)) << 1 |
+        SpreadBits(cell((a.z + b.z) * 0.5f, bounds.min.z, sz));
+    keys[i] = uint64_t{code} << 32 | i;
+  }
+  ParallelRadixSort(keys);
+
+  order_.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    order_[i] = static_cast<uint32_t>(keys[i]);
+  }
+  keys = std::vector<uint64_t>();
+
+  leaf_size = std::max<uint32_t>(leaf_size, 1);
+  const size_t leaves = (edges.size() + leaf_size - 1) / leaf_size;
+  nodes_.reserve(leaves * 2);
+  BuildNode(0, static_cast<uint32_t>(edges.size()), leaf_size);
+  ComputeBoxes(vertices, edges);
+}
+
+uint32_t Bvh::BuildNode(uint32_t first, uint32_t count, uint32_t leaf_size) {
+  const auto index = static_cast<uint32_t>(nodes_.size());
+  nodes_.push_back({BoundingBox(), first, count, 0});
+  if (count <= leaf_size) return index;
+
+  // Левая половина - целое число листов, поэтому листья заполнены полностью
+  const uint32_t half = count / 2;
+  const uint32_t left = (half + leaf_size - 1) / leaf_size * leaf_size;
+  BuildNode(first, left, leaf_size);
+  const uint32_t right = BuildNode(first + left, count - left, leaf_size);
+  nodes_[index].right = right;
+  return index;
+}
+
+void Bvh::Refit(const std::vector<Vertex>& vertices,
+                const std::vector<Edge>& edges) {
+  if (nodes_.empty()) return;
+  ScopedTimer timer("bvh.refit");
+  ComputeBoxes(vertices, edges);
+}
+
+void Bvh::ComputeBoxes(const std::vector<Vertex>& vertices,
+                       const std::vector<Edge>& edges) {
+  std::vector<uint32_t> leaves;
+  for (uint32_t i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i].right == 0) leaves.push_back(i);
+  }
+
+  // Листья независимы и пересчитываются параллельно
+  const size_t tasks =
+      (leaves.size() + kRefitLeavesPerTask - 1) / kRefitLeavesPerTask;
+  ThreadPool::GetInstance().ParallelFor(tasks, [&](size_t task) {
+    const size_t end =
+        std::min(leaves.size(), (task + 1) * kRefitLeavesPerTask);
+    for (size_t l = task * kRefitLeavesPerTask; l < end; ++l) {
+      Node& node = nodes_[leaves[l]];
+      const Edge& front = edges[order_[node.first]];
+      node.box.min = node.box.max = vertices[front.first];
+      for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+        const Edge& edge = edges[order_[k]];
+        Include(node.box, vertices[edge.first]);
+        Include(node.box, vertices[edge.second]);
+      }
+    }
+  });
+
+  // Потомки лежат после родителя, поэтому обратный проход идёт снизу вверх
+  for (size_t i = nodes_.size(); i-- > 0;) {
+    Node& node = nodes_[i];
+    if (node.right != 0) {
+      node.box = Union(nodes_[i + 1].box, nodes_[node.right].box);
+    }
+  }
+}
+
+bool Bvh::Transform(const Matrix4& transform) {
+  const Matrix4& m = transform;
+  const bool axis_aligned = m(0, 1) == 0 && m(0, 2) == 0 && m(1, 0) == 0 &&
+                            m(1, 2) == 0 && m(2, 0) == 0 && m(2, 1) == 0 &&
+                            m(3, 0) == 0 && m(3, 1) == 0 && m(3, 2) == 0 &&
+                            m(3, 3) == 1;
+  if (!axis_aligned) return false;
+
+  auto apply = [&m](float& min, float& max, int axis) {
+    min = m(axis, axis) * min + m(axis, 3);
+    max = m(axis, axis) * max + m(axis, 3);
+    if (min > max) std::swap(min, max);
+  };
+  for (Node& node : nodes_) {
+    apply(node.box.min.x, node.box.max.x, 0);
+    apply(node.box.min.y, node.box.max.y, 1);
+    apply(node.box.min.z, node.box.max.z, 2);
+  }
+  return true;
+}
+
+void Bvh::Clear() {
+  order_ = std::vector<uint32_t>();
+  nodes_ = std::vector<Node>();
+}
+
+size_t Bvh::CollectVisible(const Frustum& frustum,
+                           std::vector<EdgeRange>& ranges,
+                           uint32_t min_range) const {
+  ranges.clear();
+  if (nodes_.empty()) return 0;
+
+  size_t total = 0;
+  auto emit = [&](const Node& node) {
+    total += node.count;
+    if (!ranges.empty() &&
+        ranges.back().first + ranges.back().count == node.first) {
+      ranges.back().count += node.count;
+    } else {
+      ranges.push_back({node.first, node.count});
+    }
+  };
+
+  // Правый потомок кладётся в стек раньше левого: участки идут по порядку
+  std::vector<uint32_t> stack{0};
+  while (!stack.empty()) {
+    const uint32_t index = stack.back();
+    stack.pop_back();
+    const Node& node = nodes_[index];
+    const Frustum::Side side = frustum.Classify(node.box);
+    if (side == Frustum::Side::kOutside) continue;
+    if (side == Frustum::Side::kInside || node.right == 0 ||
+        node.count <= min_range) {
+      emit(node);
+    } else {
+      stack.push_back(node.right);
+      stack.push_back(index + 1);
+    }
+  }
+  return total;
+}
+
+PickResult Bvh::Pick(const std::vector<Vertex>& vertices,
+                     const std::vector<Edge>& edges, const Matrix4& mvp,
+                     const PickQuery& query) const {
+  PickResult vertex_hit, edge_hit;
+  float vertex_best = query.radius, edge_best = query.radius;
+  if (nodes_.empty()) return vertex_hit;
+
+  std::vector<uint32_t> stack{0};
+  while (!stack.empty()) {
+    const uint32_t index = stack.back();
+    stack.pop_back();
+    const Node& node = nodes_[index];
+    if (!MayContain(node.box, mvp, query)) continue;
+    if (node.right != 0) {
+      stack.push_back(node.right);
+      stack.push_back(index + 1);
+      continue;
+    }
+
+    for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+      const Edge& edge = edges[order_[k]];
+      const ScreenPoint a = Project(mvp, vertices[edge.first], query);
+      const ScreenPoint b = Project(mvp, vertices[edge.second], query);
+      for (const auto& [point, vertex] :
+           {std::pair{a, edge.first}, std::pair{b, edge.second}}) {
+        if (!point.visible) continue;
+        const float d = std::hypot(query.x - point.x, query.y - point.y);
+        if (d <= vertex_best) {
+          vertex_best = d;
+          vertex_hit = {PickResult::Kind::kVertex, vertex, 0, d};
+        }
+      }
+      if (!a.visible || !b.visible) continue;
+      const float d = SegmentDistance(query.x, query.y, a, b);
+      if (d <= edge_best) {
+        edge_best = d;
+        edge_hit = {PickResult::Kind::kEdge, 0, order_[k], d};
+      }
+    }
+  }
+  return vertex_hit.kind != PickResult::Kind::kNone ? vertex_hit : edge_hit;
+}
+
+}  // namespace s21
@@ -0,0 +1,245 @@
+/**
+ * @file bvh.hpp
+ * @brief Иерархия ограничивающих объёмов (BVH) над рёбрами модели.
+ *
+ * Рёбра упорядочиваются по коду Мортона своих середин, поэтому близкие в
+ * пространстве рёбра идут подряд, и каждый узел иерархии покрывает
+ * непрерывный участок этого порядка. Индексный буфер, загруженный в том же
+ * порядке, рисуется по участкам видимых узлов (отсечение по пирамиде
+ * видимости), а выбор мышью обходит только узлы под курсором.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "model.hpp"
+
+namespace s21 {
+
+/**
+ * @struct Frustum
+ * @brief Пирамида видимости: шесть плоскостей в координатах модели.
+ */
+struct Frustum {
+  /**
+   * @enum Side
+   * @brief Положение параллелепипеда относительно пирамиды.
+   */
+  enum class Side {
+    kOutside,    ///< Целиком снаружи
+    kIntersect,  ///< Пересекает границу
+    kInside      ///< Целиком внутри
+  };
+
+  /// Плоскости a*x + b*y + c*z + d >= 0 для точек внутри
+  std::array<std::array<float, 4>, 6> planes{};
+
+  /**
+   * @brief Строит пирамиду по матрице проекции, вида и модели.
+   *
+   * @param mvp Произведение проекции, вида и модели (как в OpenGL).
+   */
+  static Frustum FromMatrix(const Matrix4& mvp);
+
+  /**
+   * @brief Определяет положение параллелепипеда относительно пирамиды.
+   *
+   * Проверка консервативна: параллелепипед у угла пирамиды может оказаться
+   * kIntersect, хотя лежит снаружи.
+   */
+  Side Classify(const BoundingBox& box) const;
+};
+
+/**
+ * @struct EdgeRange
+ * @brief Участок рёбер в порядке Bvh::GetOrder().
+ */
+struct EdgeRange {
+  uint32_t first = 0;  ///< Первое ребро участка
+  uint32_t count = 0;  ///< Количество рёбер
+};
+
+/**
+ * @struct PickQuery
+ * @brief Положение курсора для выбора вершины или ребра.
+ */
+struct PickQuery {
+  float x = 0;       ///< Координата X в пикселях (слева направо)
+  float y = 0;       ///< Координата Y в пикселях (сверху вниз)
+  float width = 1;   ///< Ширина области вывода в пикселях
+  float height = 1;  ///< Высота области вывода в пикселях
+  float radius = 6;  ///< Наибольшее расстояние до курсора в пикселях
+};
+
+/**
+ * @struct PickResult
+ * @brief Результат выбора мышью.
+ */
+struct PickResult {
+  /**
+   * @enum Kind
+   * @brief Что оказалось под курсором.
+   */
+  enum class Kind { kNone, kVertex, kEdge };
+
+  Kind kind = Kind::kNone;  ///< Тип найденного элемента
+  uint32_t vertex = 0;      ///< Индекс вершины (для kVertex)
+  uint32_t edge = 0;        ///< Индекс ребра в Model::GetEdges() (для kEdge)
+  float distance = 0;       ///< Расстояние до курсора в пикселях
+};
+
+/**
+ * @class Bvh
+ * @brief Двоичная иерархия AABB над участками рёбер.
+ *
+ * Узлы хранятся в порядке обхода в глубину: левый потомок идёт сразу за
+ * родителем, поэтому при обратном проходе потомки обновляются раньше
+ * родителей. Иерархия не хранит ни вершин, ни рёбер - их передаёт
+ * вызывающий код, и это должны быть те же массивы, что при Build().
+ */
+class Bvh {
+ public:
+  /// Рёбер в листе по умолчанию
+  static constexpr uint32_t kLeafSize = 256;
+
+  /**
+   * @struct Node
+   * @brief Узел иерархии.
+   */
+  struct Node {
+    BoundingBox box;     ///< AABB рёбер узла
+    uint32_t first = 0;  ///< Первое ребро в порядке GetOrder()
+    uint32_t count = 0;  ///< Количество рёбер
+    uint32_t right = 0;  ///< Правый потомок (0 - лист)
+  };
+
+  /**
+   * @brief Строит иерархию.
+   *
+   * @param vertices Вершины модели.
+   * @param edges Рёбра модели.
+   * @param leaf_size Наибольшее число рёбер в листе.
+   */
+  void Build(const std::vector<Vertex>& vertices,
+             const std::vector<Edge>& edges, uint32_t leaf_size = kLeafSize);
+
+  /**
+   * @brief Пересчитывает AABB узлов после изменения вершин.
+   *
+   * Порядок рёбер и форма дерева не меняются: после сильной деформации
+   * узлы перекрываются больше, но остаются корректными.
+   *
+   * @param vertices Вершины с новыми координатами.
+   * @param edges Рёбра модели (те же, что при Build()).
+   */
+  void Refit(const std::vector<Vertex>& vertices,
+             const std::vector<Edge>& edges);
+
+  /**
+   * @brief Применяет к AABB узлов преобразование, уже применённое к вершинам.
+   *
+   * Перенос и масштабирование по осям переводят AABB в AABB, поэтому узлы
+   * обновляются без обращения к вершинам.
+   *
+   * @param transform Преобразование вершин.
+   * @return false если матрица содержит поворот или сдвиг - тогда нужен
+   * Refit().
+   */
+  bool Transform(const Matrix4& transform);
+
+  /**
+   * @brief Удаляет иерархию.
+   */
+  void Clear();
+
+  /**
+   * @brief Проверяет, пуста ли иерархия.
+   */
+  bool IsEmpty() const { return nodes_.empty(); }
+
+  /**
+   * @brief Возвращает порядок рёбер: i-е ребро иерархии - edges[order[i]].
+   */
+  const std::vector<uint32_t>& GetOrder() const { return order_; }
+
+  /**
+   * @brief Возвращает узлы (корень - первый).
+   */
+  const std::vector<Node>& GetNodes() const { return nodes_; }
+
+  /**
+   * @brief Возвращает AABB всех рёбер (нулевой, если иерархия пуста).
+   */
+  BoundingBox GetBounds() const {
+    return nodes_.empty() ? BoundingBox() : nodes_.front().box;
+  }
+
+  /**
+   * @brief Возвращает объём памяти, занятый иерархией, в байтах.
+   */
+  size_t GetMemoryUsage() const {
+    return order_.capacity() * sizeof(uint32_t) +
+           nodes_.capacity() * sizeof(Node);
+  }
+
+  /**
+   * @brief Собирает участки рёбер, видимые в пирамиде.
+   *
+   * Узел целиком внутри пирамиды даёт один участок без обхода потомков;
+   * узел на границе раскрывается, пока в нём больше min_range рёбер.
+   * Соседние участки сливаются, поэтому их число - число вызовов отрисовки.
+   *
+   * @param frustum Пирамида видимости в координатах модели.
+   * @param ranges Сюда записываются участки (по возрастанию first).
+   * @param min_range Узлы не больше этого размера не раскрываются.
+   * @return Суммарное число рёбер в участках.
+   */
+  size_t CollectVisible(const Frustum& frustum, std::vector<EdgeRange>& ranges,
+                        uint32_t min_range = 0) const;
+
+  /**
+   * @brief Ищет вершину или ребро под курсором.
+   *
+   * Обходятся только узлы, проекция AABB которых (с запасом radius)
+   * накрывает курсор. Вершина в пределах radius предпочитается ребру;
+   * точки позади камеры и за пределами глубины отсечения не выбираются.
+   *
+   * @param vertices Вершины модели.
+   * @param edges Рёбра модели (в исходном порядке).
+   * @param mvp Матрица, которой модель выводилась на экран.
+   * @param query Положение курсора.
+   */
+  PickResult Pick(const std::vector<Vertex>& vertices,
+                  const std::vector<Edge>& edges, const Matrix4& mvp,
+                  const PickQuery& query) const;
+
+ private:
+  std::vector<uint32_t> order_;  ///< Рёбра в порядке кода Мортона
+  std::vector<Node> nodes_;      ///< Узлы в порядке обхода в глубину
+
+  /**
+   * @brief Создаёт поддерево над участком [first, first + count).
+   *
+   * @return Индекс корня поддерева.
+   */
+  uint32_t BuildNode(uint32_t first, uint32_t count, uint32_t leaf_size);
+
+  /**
+   * @brief Пересчитывает AABB всех узлов по вершинам.
+   */
+  void ComputeBoxes(const std::vector<Vertex>& vertices,
+                    const std::vector<Edge>& edges);
+};
+
+}  // namespace s21
+
+#endif  // BVH_HPP
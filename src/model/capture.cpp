@@ -0,0 +1,344 @@
+#include "capture.hpp"
+
+#include <array>
+#include <cstdio>
+
+namespace s21 {
+
+namespace {
+
+/// Уровней красного, зелёного и синего в палитре GIF (6 * 7 * 6 = 252)
+constexpr uint32_t kRedLevels = 6;
+constexpr uint32_t kGreenLevels = 7;
+constexpr uint32_t kBlueLevels = 6;
+
+/// Наибольший размер стороны кадра GIF
+constexpr uint32_t kGifMaxSide = 0xFFFF;
+
+/// Размер заголовков BMP: файла (14 байт) и изображения (40 байт)
+constexpr uint32_t kBmpHeaderSize = 54;
+
+/**
+ * @brief Дописывает 16-битное число в порядке little-endian.
+ */
+void PutU16(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back(static_cast<uint8_t>(value));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+/**
+ * @brief Дописывает 32-битное число в порядке little-endian.
+ */
+void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+  PutU16(out, value & 0xFFFF);
+  PutU16(out, value >> 16);
+}
+
+/**
+ * @struct ColorLut
+ * @brief Номер уровня палитры для каждого значения канала.
+ */
+struct ColorLut {
+  std::array<uint8_t, 256> red{};    ///< Вклад красного в индекс
+  std::array<uint8_t, 256> green{};  ///< Вклад зелёного в индекс
+  std::array<uint8_t, 256> blue{};   ///< Вклад синего в индекс
+
+  ColorLut() {
+    for (uint32_t v = 0; v < 256; ++v) {
+      const auto level = [v](uint32_t levels) {
+        return (v * (levels - 1) + 127) / 255;
+      };
+      red[v] = static_cast<uint8_t>(level(kRedLevels) * kGreenLevels *
+                                    kBlueLevels);
+      green[v] = static_cast<uint8_t>(level(kGreenLevels) * kBlueLevels);
+      blue[v] = static_cast<uint8_t>(level(kBlueLevels));
+    }
+  }
+};
+
+/**
+ * @class LzwEncoder
+ * @brief Сжатие индексов палитры по LZW в подблоки GIF.
+ *
+ * Словарь - таблица с открытой адресацией на 8192 ячейки: при не более
+ * 4096 кодах заполнена меньше чем наполовину, а её очистка после каждого
+ * кода очистки стоит 48 КБ, а не 2 МБ полного дерева (4096 x 256).
+ */
+class LzwEncoder {
+ public:
+  explicit LzwEncoder(std::vector<uint8_t>& out) : out_(out) {}
+
+  /**
+   * @brief Сжимает кадр: строки сверху вниз, данные и пустой подблок.
+   */
+  void Encode(const CaptureFrame& frame) {
+    static const ColorLut lut;
+    ResetTable();
+    Emit(kClearCode);
+
+    bool first = true;
+    uint32_t prefix = 0;
+    for (uint32_t row = frame.height; row-- > 0;) {
+      const uint8_t* pixel =
+          frame.pixels.data() + static_cast<size_t>(row) * frame.width * 4;
+      for (uint32_t x = 0; x < frame.width; ++x, pixel += 4) {
+        const uint32_t index =
+            lut.red[pixel[0]] + lut.green[pixel[1]] + lut.blue[pixel[2]];
+        if (first) {
+          prefix = index;
+          first = false;
+          continue;
+        }
+        const uint32_t key = (prefix << 8) | index;
+        size_t slot = Find(key);
+        if (keys_[slot] == key + 1) {
+          prefix = codes_[slot];
+          continue;
+        }
+        Emit(prefix);
+        Add(slot, key);
+        prefix = index;
+      }
+    }
+    if (!first) Emit(prefix);
+    Emit(kEndCode);
+    Finish();
+  }
+
+ private:
+  static constexpr uint32_t kMinCodeSize = 8;   ///< Бит на индекс палитры
+  static constexpr uint32_t kClearCode = 256;   ///< Код очистки словаря
+  static constexpr uint32_t kEndCode = 257;     ///< Код конца данных
+  static constexpr uint32_t kMaxCode = 4095;    ///< Наибольший код (12 бит)
+  static constexpr size_t kTableSize = 8192;    ///< Ячеек словаря
+
+  std::vector<uint8_t>& out_;  ///< Блок кадра
+  std::array<uint32_t, kTableSize> keys_;  ///< (префикс << 8 | индекс) + 1
+  std::array<uint16_t, kTableSize> codes_;  ///< Код цепочки ячейки
+  uint32_t next_code_ = 0;     ///< Следующий свободный код
+  uint32_t code_size_ = 0;     ///< Текущая ширина кода, бит
+  uint64_t bits_ = 0;          ///< Ещё не записанные биты
+  uint32_t bit_count_ = 0;     ///< Число бит в bits_
+  std::array<uint8_t, 255> block_;  ///< Текущий подблок
+  size_t block_size_ = 0;      ///< Заполнено байт подблока
+
+  void ResetTable() {
+    keys_.fill(0);
+    next_code_ = kEndCode + 1;
+    code_size_ = kMinCodeSize + 1;
+  }
+
+  /**
+   * @brief Ячейка с ключом или первая пустая ячейка на его пути.
+   */
+  size_t Find(uint32_t key) const {
+    size_t slot = (key * 2654435761u) >> 19;  // 13 старших бит
+    while (keys_[slot] != 0 && keys_[slot] != key + 1) {
+      slot = (slot + 1) & (kTableSize - 1);
+    }
+    return slot;
+  }
+
+  /**
+   * @brief Заносит цепочку в словарь; после кода kMaxCode - очистка.
+   *
+   * Ширина кода растёт, как только новый код перестаёт в неё помещаться:
+   * декодер, отстающий на один код, расширяет её к чтению того же кода.
+   */
+  void Add(size_t slot, uint32_t key) {
+    const uint32_t code = next_code_++;
+    keys_[slot] = key + 1;
+    codes_[slot] = static_cast<uint16_t>(code);
+    if (code >= (1u << code_size_)) ++code_size_;
+    if (code == kMaxCode) {
+      Emit(kClearCode);
+      ResetTable();
+    }
+  }
+
+  void Emit(uint32_t code) {
+    bits_ |= static_cast<uint64_t>(code) << bit_count_;
+    bit_count_ += code_size_;
+    while (bit_count_ >= 8) {
+      PutByte(static_cast<uint8_t>(bits_));
+      bits_ >>= 8;
+      bit_count_ -= 8;
+    }
+  }
+
+  void PutByte(uint8_t byte) {
+    block_[block_size_++] = byte;
+    if (block_size_ == block_.size()) FlushBlock();
+  }
+
+  void FlushBlock() {
+    if (block_size_ == 0) return;
+    out_.push_back(static_cast<uint8_t>(block_size_));
+    out_.insert(out_.end(), block_.begin(), block_.begin() + block_size_);
+    block_size_ = 0;
+  }
+
+  void Finish() {
+    if (bit_count_ > 0) PutByte(static_cast<uint8_t>(bits_));
+    bits_ = 0;
+    bit_count_ = 0;
+    FlushBlock();
+    out_.push_back(0);  // Конец данных изображения
+  }
+};
+
+}  // namespace
+
+const char* CaptureExtension(CaptureFormat format) {
+  switch (format) {
+    case CaptureFormat::kBmp:
+      return ".bmp";
+    case CaptureFormat::kJpeg:
+      return ".jpg";
+    case CaptureFormat::kGif:
+      return ".gif";
+  }
+  return "";
+}
+
+std::string CaptureFramePath(const std::string& prefix, size_t index,
+                             CaptureFormat format) {
+  char number[32];
+  std::snprintf(number, sizeof(number), "_%04zu", index);
+  return prefix + number + CaptureExtension(format);
+}
+
+bool WriteBmp(const CaptureFrame& frame, const std::string& path) {
+  if (frame.width == 0 || frame.height == 0 ||
+      frame.pixels.size() < static_cast<size_t>(frame.width) * frame.height * 4)
+    return false;
+
+  // Строки BMP идут снизу вверх, как у glReadPixels, и выровнены до 4 байт
+  const uint32_t row_bytes = (frame.width * 3 + 3) & ~3u;
+  const uint32_t image_bytes = row_bytes * frame.height;
+  std::vector<uint8_t> header;
+  header.reserve(kBmpHeaderSize);
+  header.push_back('B');
+  header.push_back('M');
+  PutU32(header, kBmpHeaderSize + image_bytes);
+  PutU32(header, 0);
+  PutU32(header, kBmpHeaderSize);
+  PutU32(header, 40);
+  PutU32(header, frame.width);
+  PutU32(header, frame.height);
+  PutU16(header, 1);   // Плоскостей
+  PutU16(header, 24);  // Бит на пиксель
+  PutU32(header, 0);   // Без сжатия
+  PutU32(header, image_bytes);
+  PutU32(header, 2835);  // 72 точки на дюйм
+  PutU32(header, 2835);
+  PutU32(header, 0);
+  PutU32(header, 0);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) return false;
+  out.write(reinterpret_cast<const char*>(header.data()),
+            static_cast<std::streamsize>(header.size()));
+
+  std::vector<uint8_t> row(row_bytes, 0);
+  const uint8_t* pixel = frame.pixels.data();
+  for (uint32_t y = 0; y < frame.height; ++y) {
+    for (uint32_t x = 0; x < frame.width; ++x, pixel += 4) {
+      row[x * 3] = pixel[2];
+      row[x * 3 + 1] = pixel[1];
+      row[x * 3 + 2] = pixel[0];
+    }
+    out.write(reinterpret_cast<const char*>(row.data()),
+              static_cast<std::streamsize>(row.size()));
+  }
+  return static_cast<bool>(out);
+}
+
+const std::vector<uint8_t>& GifPalette() {
+  static const std::vector<uint8_t> palette = [] {
+    std::vector<uint8_t> colors(256 * 3, 0);
+    size_t i = 0;
+    for (uint32_t r = 0; r < kRedLevels; ++r) {
+      for (uint32_t g = 0; g < kGreenLevels; ++g) {
+        for (uint32_t b = 0; b < kBlueLevels; ++b) {
+          colors[i++] = static_cast<uint8_t>(r * 255 / (kRedLevels - 1));
+          colors[i++] = static_cast<uint8_t>(g * 255 / (kGreenLevels - 1));
+          colors[i++] = static_cast<uint8_t>(b * 255 / (kBlueLevels - 1));
+        }
+      }
+    }
+    return colors;
+  }();
+  return palette;
+}
+
+std::vector<uint8_t> EncodeGifFrame(const CaptureFrame& frame,
+                                    uint16_t delay) {
+  std::vector<uint8_t> block;
+  if (frame.width == 0 || frame.height == 0 || frame.width > kGifMaxSide ||
+      frame.height > kGifMaxSide ||
+      frame.pixels.size() < static_cast<size_t>(frame.width) * frame.height * 4)
+    return block;
+  block.reserve(static_cast<size_t>(frame.width) * frame.height / 2 + 64);
+
+  // Управление показом: кадр не стирается, без прозрачности
+  block.insert(block.end(), {0x21, 0xF9, 0x04, 0x04});
+  PutU16(block, delay);
+  block.insert(block.end(), {0x00, 0x00});
+
+  // Описание изображения: весь экран, общая палитра, без чересстрочности
+  block.push_back(0x2C);
+  PutU16(block, 0);
+  PutU16(block, 0);
+  PutU16(block, frame.width);
+  PutU16(block, frame.height);
+  block.push_back(0x00);
+
+  block.push_back(8);  // Минимальная ширина кода LZW
+  LzwEncoder(block).Encode(frame);
+  return block;
+}
+
+bool GifWriter::Open(const std::string& path, uint32_t width,
+                     uint32_t height) {
+  if (out_.is_open()) Close();
+  frames_ = 0;
+  if (width == 0 || height == 0 || width > kGifMaxSide ||
+      height > kGifMaxSide)
+    return false;
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) return false;
+
+  std::vector<uint8_t> header = {'G', 'I', 'F', '8', '9', 'a'};
+  PutU16(header, width);
+  PutU16(header, height);
+  header.insert(header.end(), {0xF7, 0x00, 0x00});  // Палитра на 256 цветов
+  const std::vector<uint8_t>& palette = GifPalette();
+  header.insert(header.end(), palette.begin(), palette.end());
+  // NETSCAPE2.0: бесконечный повтор
+  header.insert(header.end(), {0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C',
+                               'A', 'P', 'E', '2', '.', '0', 0x03, 0x01,
+                               0x00, 0x00, 0x00});
+  out_.write(reinterpret_cast<const char*>(header.data()),
+             static_cast<std::streamsize>(header.size()));
+  return static_cast<bool>(out_);
+}
+
+bool GifWriter::AddFrame(const std::vector<uint8_t>& block) {
+  if (!out_.is_open() || block.empty()) return false;
+  out_.write(reinterpret_cast<const char*>(block.data()),
+             static_cast<std::streamsize>(block.size()));
+  if (!out_) return false;
+  ++frames_;
+  return true;
+}
+
+bool GifWriter::Close() {
+  if (!out_.is_open()) return false;
+  out_.put(0x3B);
+  const bool ok = static_cast<bool>(out_);
+  out_.close();
+  return ok;
+}
+
+}  // namespace s21
@@ -0,0 +1,150 @@
+/**
+ * @file capture.hpp
+ * @brief Кодирование кадров окна отрисовки: BMP и анимированный GIF.
+ *
+ * Кадр - пиксели RGBA в том виде, в каком их отдаёт glReadPixels (строки
+ * снизу вверх). Кодировщики не зависят от Qt и OpenGL и не имеют общего
+ * состояния, поэтому кадры можно кодировать параллельно: у GIF палитра
+ * общая и постоянная, и сжатый кадр не зависит от соседних.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef CAPTURE_HPP
+#define CAPTURE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @enum CaptureFormat
+ * @brief Формат записи кадров.
+ */
+enum class CaptureFormat {
+  kBmp,   ///< Последовательность файлов BMP (24 бита)
+  kJpeg,  ///< Последовательность файлов JPEG (кодировщик задаёт GUI)
+  kGif    ///< Один анимированный файл GIF
+};
+
+/**
+ * @struct CaptureFrame
+ * @brief Пиксели одного кадра.
+ */
+struct CaptureFrame {
+  uint32_t width = 0;   ///< Ширина в пикселях
+  uint32_t height = 0;  ///< Высота в пикселях
+  /// RGBA по 8 бит, строки снизу вверх (порядок glReadPixels)
+  std::vector<uint8_t> pixels;
+
+  /**
+   * @brief Задаёт размер кадра; память прежнего размера переиспользуется.
+   */
+  void Resize(uint32_t w, uint32_t h) {
+    width = w;
+    height = h;
+    pixels.resize(static_cast<size_t>(w) * h * 4);
+  }
+};
+
+/**
+ * @brief Расширение файла формата (".bmp", ".jpg", ".gif").
+ */
+const char* CaptureExtension(CaptureFormat format);
+
+/**
+ * @brief Имя файла кадра последовательности: prefix_0007.bmp.
+ *
+ * @param prefix Путь без расширения.
+ * @param index Номер кадра, с нуля.
+ * @param format Формат (задаёт расширение).
+ */
+std::string CaptureFramePath(const std::string& prefix, size_t index,
+                             CaptureFormat format);
+
+/**
+ * @brief Записывает кадр в файл BMP (24 бита, без сжатия).
+ *
+ * @param frame Кадр.
+ * @param path Путь к файлу (перезаписывается).
+ * @return true если файл записан.
+ */
+bool WriteBmp(const CaptureFrame& frame, const std::string& path);
+
+/**
+ * @brief Сжимает кадр в блок анимированного GIF.
+ *
+ * Цвета приводятся к общей палитре GifPalette() (6 уровней красного, 7
+ * зелёного, 6 синего) без смешения, поэтому однотонные линии и фон
+ * остаются однотонными. Блок содержит задержку кадра, описание
+ * изображения и данные LZW; в файл его записывает GifWriter::AddFrame.
+ *
+ * @param frame Кадр.
+ * @param delay Задержка перед следующим кадром, сотые доли секунды.
+ * @return Блок кадра; пустой, если размер кадра не помещается в GIF.
+ */
+std::vector<uint8_t> EncodeGifFrame(const CaptureFrame& frame,
+                                    uint16_t delay);
+
+/**
+ * @brief Общая палитра GIF: 256 цветов RGB подряд.
+ */
+const std::vector<uint8_t>& GifPalette();
+
+/**
+ * @class GifWriter
+ * @brief Файл анимированного GIF из заранее сжатых кадров.
+ *
+ * Анимация повторяется бесконечно. Все кадры должны быть размера,
+ * заданного в Open().
+ */
+class GifWriter {
+ public:
+  /**
+   * @brief Создаёт файл и записывает заголовок с палитрой.
+   *
+   * @param path Путь к файлу (перезаписывается).
+   * @param width Ширина кадров.
+   * @param height Высота кадров.
+   * @return true если файл создан.
+   */
+  bool Open(const std::string& path, uint32_t width, uint32_t height);
+
+  /**
+   * @brief Дописывает кадр из EncodeGifFrame.
+   *
+   * @return false если файл не открыт, блок пуст или запись не удалась.
+   */
+  bool AddFrame(const std::vector<uint8_t>& block);
+
+  /**
+   * @brief Завершает файл.
+   *
+   * @return true если все данные записаны.
+   */
+  bool Close();
+
+  /**
+   * @brief Проверяет, открыт ли файл.
+   */
+  bool IsOpen() const { return out_.is_open(); }
+
+  /**
+   * @brief Возвращает число записанных кадров.
+   */
+  size_t GetFrameCount() const { return frames_; }
+
+ private:
+  std::ofstream out_;  ///< Файл
+  size_t frames_ = 0;  ///< Записано кадров
+};
+
+}  // namespace s21
+
+#endif  // CAPTURE_HPP
@@ -0,0 +1,158 @@
+#include "lod.hpp"
+
+#include <algorithm>
+
+#include "metrics.hpp"
+#include "radix_sort.hpp"
+
+namespace s21 {
+
+namespace {
+
+/// Наибольшая сетка: номер ячейки (30 бит) и номер вершины (32 бита)
+/// помещаются в один 64-битный ключ
+constexpr uint32_t kMaxGrid = 1024;
+
+BoundingBox ComputeBox(const std::vector<Vertex>& vertices) {
+  BoundingBox box;
+  if (vertices.empty()) return box;
+  box.min = box.max = vertices.front();
+  for (const Vertex& v : vertices) {
+    box.min = {std::min(box.min.x, v.x), std::min(box.min.y, v.y),
+               std::min(box.min.z, v.z)};
+    box.max = {std::max(box.max.x, v.x), std::max(box.max.y, v.y),
+               std::max(box.max.z, v.z)};
+  }
+  return box;
+}
+
+float Extent(const BoundingBox& box) {
+  return std::max({box.max.x - box.min.x, box.max.y - box.min.y,
+                   box.max.z - box.min.z});
+}
+
+}  // namespace
+
+int LodSet::SelectLevel(float pixel_extent, float max_cell_pixels) const {
+  for (size_t i = levels.size(); i-- > 0;) {
+    if (pixel_extent <= max_cell_pixels * static_cast<float>(levels[i].grid)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+LodLevel BuildLodLevel(const std::vector<Vertex>& vertices,
+                       const std::vector<Edge>& edges, const BoundingBox& box,
+                       uint32_t grid) {
+  LodLevel level;
+  level.grid = std::clamp<uint32_t>(grid, 1, kMaxGrid);
+  if (vertices.empty()) return level;
+
+  // Кубические ячейки: сторона - наибольшая сторона AABB, делённая на grid
+  const float extent = Extent(box);
+  const float to_cell = extent > 0 ? static_cast<float>(level.grid) / extent : 0;
+  const uint32_t last = level.grid - 1;
+  auto cell = [&](float value, float min) {
+    const auto c = static_cast<int64_t>((value - min) * to_cell);
+    return static_cast<uint64_t>(std::clamp<int64_t>(c, 0, last));
+  };
+
+  // Ключ вершины: номер ячейки в старших битах, номер вершины в младших.
+  // После сортировки вершины одной ячейки идут подряд
+  std::vector<uint64_t> keys(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const Vertex& v = vertices[i];
+    const uint64_t id =
+        (cell(v.x, box.min.x) * level.grid + cell(v.y, box.min.y)) *
+            level.grid +
+        cell(v.z, box.min.z);
+    keys[i] = id << 32 | i;
+  }
+  ParallelRadixSort(keys);
+
+  // Вершина уровня - среднее вершин ячейки
+  std::vector<uint32_t> remap(vertices.size());
+  for (size_t begin = 0; begin < keys.size();) {
+    const uint64_t id = keys[begin] >> 32;
+    double x = 0, y = 0, z = 0;
+    size_t end = begin;
+    for (; end < keys.size() && keys[end] >> 32 == id; ++end) {
+      const uint32_t index = static_cast<uint32_t>(keys[end]);
+      const Vertex& v = vertices[index];
+      x += v.x;
+      y += v.y;
+      z += v.z;
+      remap[index] = static_cast<uint32_t>(level.vertices.size());
+    }
+    const auto count = static_cast<double>(end - begin);
+    level.vertices.push_back({static_cast<float>(x / count),
+                              static_cast<float>(y / count),
+                              static_cast<float>(z / count)});
+    begin = end;
+  }
+  keys = std::vector<uint64_t>();
+
+  // Рёбра внутри одной ячейки вырождаются, одинаковые рёбра сливаются
+  std::vector<uint64_t> edge_keys;
+  edge_keys.reserve(edges.size());
+  for (const Edge& edge : edges) {
+    const uint64_t a = remap[edge.first];
+    const uint64_t b = remap[edge.second];
+    if (a != b) edge_keys.push_back(a < b ? (a << 32 | b) : (b << 32 | a));
+  }
+  SortUnique(edge_keys);
+
+  level.edges.resize(edge_keys.size());
+  for (size_t i = 0; i < edge_keys.size(); ++i) {
+    level.edges[i] = {static_cast<uint32_t>(edge_keys[i] >> 32),
+                      static_cast<uint32_t>(edge_keys[i])};
+  }
+  return level;
+}
+
+LodSet BuildLodSet(const std::vector<Vertex>& vertices,
+                   const std::vector<Edge>& edges, const LodOptions& options) {
+  LodSet set;
+  if (edges.size() < options.min_edges) return set;
+
+  ScopedTimer timer("lod.build");
+  const BoundingBox box = ComputeBox(vertices);
+  set.extent = Extent(box);
+
+  auto cancelled = [&options] {
+    return options.cancel && options.cancel->load(std::memory_order_relaxed);
+  };
+
+  // Каждый уровень строится из предыдущего: ячейка вдвое более крупной сетки
+  // состоит ровно из 8 ячеек предыдущей, а вершина уровня лежит внутри своей
+  // ячейки, поэтому вершины распределяются по ячейкам так же, как при
+  // построении из полной модели
+  const std::vector<Vertex>* source_vertices = &vertices;
+  const std::vector<Edge>* source_edges = &edges;
+  LodLevel previous;  // Последний построенный, но не сохранённый уровень
+  set.levels.reserve(11);  // Сетки 1024, 512, ..., 1
+  size_t finer_edges = edges.size();
+  for (uint32_t grid = std::min(options.max_grid, kMaxGrid);
+       grid >= std::max<uint32_t>(options.min_grid, 1); grid /= 2) {
+    if (cancelled()) return LodSet();
+
+    LodLevel level =
+        BuildLodLevel(*source_vertices, *source_edges, box, grid);
+    const bool keep = static_cast<float>(level.edges.size()) <=
+                      options.max_edge_ratio * static_cast<float>(finer_edges);
+    if (keep) {
+      finer_edges = level.edges.size();
+      set.levels.push_back(std::move(level));
+      source_vertices = &set.levels.back().vertices;
+      source_edges = &set.levels.back().edges;
+    } else {
+      previous = std::move(level);
+      source_vertices = &previous.vertices;
+      source_edges = &previous.edges;
+    }
+  }
+  return set;
+}
+
+}  // namespace s21
@@ -0,0 +1,109 @@
+/**
+ * @file lod.hpp
+ * @brief Упрощённые уровни детализации (LOD) каркаса модели.
+ *
+ * Уровни строятся кластеризацией вершин: ограничивающий параллелепипед
+ * делится на grid^3 ячеек, вершины одной ячейки сливаются в их среднее, а
+ * рёбра, оба конца которых попали в одну ячейку, исчезают. Алгоритм работает
+ * только с вершинами и рёбрами, поэтому подходит и для моделей, загруженных
+ * в режиме LoadMode::kEdgesOnly.
+ *
+ * Если ячейка на экране не больше пикселя, упрощённый каркас визуально не
+ * отличается от полного, а рёбер в нём в разы меньше.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef LOD_HPP
+#define LOD_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "model.hpp"
+
+namespace s21 {
+
+/**
+ * @struct LodLevel
+ * @brief Один уровень детализации.
+ */
+struct LodLevel {
+  uint32_t grid = 0;             ///< Ячеек по каждой оси
+  std::vector<Vertex> vertices;  ///< Вершины (по одной на непустую ячейку)
+  std::vector<Edge> edges;       ///< Рёбра между вершинами уровня
+};
+
+/**
+ * @struct LodOptions
+ * @brief Параметры построения уровней детализации.
+ */
+struct LodOptions {
+  /// Уровни строятся только для моделей с большим числом рёбер
+  size_t min_edges = size_t{1} << 18;
+  /// Самая мелкая сетка кластеризации (не больше 1024)
+  uint32_t max_grid = 1024;
+  /// Самая крупная сетка кластеризации
+  uint32_t min_grid = 32;
+  /// Уровень сохраняется, только если рёбер в нём не больше этой доли от
+  /// следующего более подробного уровня
+  float max_edge_ratio = 0.5f;
+  /// Флаг отмены: проверяется между уровнями
+  const std::atomic<bool>* cancel = nullptr;
+};
+
+/**
+ * @struct LodSet
+ * @brief Уровни детализации одной модели, от подробного к грубому.
+ */
+struct LodSet {
+  std::vector<LodLevel> levels;  ///< Уровни; grid убывает
+  float extent = 0;  ///< Наибольшая сторона AABB модели (размер сетки)
+
+  /**
+   * @brief Выбирает уровень для отрисовки.
+   *
+   * Берётся самый грубый уровень, ячейка которого на экране не больше
+   * max_cell_pixels.
+   *
+   * @param pixel_extent Размер extent на экране в пикселях.
+   * @param max_cell_pixels Допустимый размер ячейки в пикселях.
+   * @return Индекс уровня или -1, если нужна полная детализация.
+   */
+  int SelectLevel(float pixel_extent, float max_cell_pixels = 1.0f) const;
+};
+
+/**
+ * @brief Строит один уровень кластеризацией вершин.
+ *
+ * @param vertices Вершины исходного каркаса.
+ * @param edges Рёбра исходного каркаса.
+ * @param box Параллелепипед, который делится на ячейки.
+ * @param grid Ячеек по каждой оси (1..1024).
+ */
+LodLevel BuildLodLevel(const std::vector<Vertex>& vertices,
+                       const std::vector<Edge>& edges, const BoundingBox& box,
+                       uint32_t grid);
+
+/**
+ * @brief Строит уровни детализации каркаса.
+ *
+ * Сетки уменьшаются вдвое от max_grid до min_grid; каждый уровень строится
+ * из предыдущего, поэтому общая стоимость близка к стоимости первого.
+ *
+ * @param vertices Вершины модели.
+ * @param edges Рёбра модели.
+ * @param options Параметры построения.
+ * @return Уровни; пустой набор, если модель мала или построение отменено.
+ */
+LodSet BuildLodSet(const std::vector<Vertex>& vertices,
+                   const std::vector<Edge>& edges,
+                   const LodOptions& options = LodOptions());
+
+}  // namespace s21
+
+#endif  // LOD_HPP
@@ -0,0 +1,70 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace s21 {
+
+bool MappedFile::Open(const std::string& path) {
+  Close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  if (S_ISREG(st.st_mode)) {
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) {
+      // Пустой файл отобразить нельзя, но это корректная ситуация
+      ::close(fd);
+      return true;
+    }
+
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      ::madvise(addr, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(addr);
+      mapped_ = true;
+      ::close(fd);  // Отображение остаётся валидным после закрытия
+      return true;
+    }
+    size_ = 0;
+  }
+
+  // Запасной путь: читаем файл целиком в собственный буфер
+  char chunk[1 << 16];
+  ssize_t n = 0;
+  while ((n = ::read(fd, chunk, sizeof(chunk))) > 0) {
+    fallback_.insert(fallback_.end(), chunk, chunk + n);
+  }
+  ::close(fd);
+  if (n < 0) {
+    fallback_.clear();
+    return false;
+  }
+
+  data_ = fallback_.data();
+  size_ = fallback_.size();
+  return true;
+}
+
+void MappedFile::Close() {
+  if (mapped_) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  fallback_.clear();
+}
+
+}  // namespace s21
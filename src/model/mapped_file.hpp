@@ -0,0 +1,81 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Заголовочный файл для класса MappedFile - отображения файла в память.
+ *
+ * Позволяет читать содержимое файла модели без построчного копирования:
+ * файл отображается в адресное пространство процесса через mmap, а парсер
+ * работает напрямую с полученным буфером.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @class MappedFile
+ * @brief RAII-обёртка над файлом, отображённым в память только для чтения.
+ *
+ * Если отобразить файл не удалось (например, это канал или специальный
+ * файл), содержимое целиком читается в собственный буфер, так что вызывающий
+ * код всегда получает непрерывный диапазон байт.
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  /**
+   * @brief Деструктор. Снимает отображение и закрывает файл.
+   */
+  ~MappedFile() { Close(); }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Открывает файл и отображает его в память.
+   *
+   * @param path Путь к файлу.
+   * @return true если содержимое файла доступно через Data()/Size().
+   */
+  bool Open(const std::string& path);
+
+  /**
+   * @brief Снимает отображение и освобождает ресурсы.
+   */
+  void Close();
+
+  /**
+   * @brief Возвращает указатель на начало содержимого файла.
+   */
+  const char* Data() const { return data_; }
+
+  /**
+   * @brief Возвращает размер содержимого в байтах.
+   */
+  size_t Size() const { return size_; }
+
+  /**
+   * @brief Возвращает содержимое файла в виде string_view.
+   */
+  std::string_view View() const { return {data_, size_}; }
+
+ private:
+  const char* data_ = nullptr;  ///< Начало содержимого файла
+  size_t size_ = 0;             ///< Размер содержимого в байтах
+  bool mapped_ = false;  ///< true, если data_ получен через mmap
+  std::vector<char> fallback_;  ///< Буфер на случай, если mmap недоступен
+};
+
+}  // namespace s21
+
+#endif  // MAPPED_FILE_HPP
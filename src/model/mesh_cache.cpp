@@ -0,0 +1,235 @@
+#include "mesh_cache.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#include "mapped_file.hpp"
+#include "metrics.hpp"
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'E', 'S', 'H', '\0'};
+constexpr uint32_t kVersion = 1;
+/// Записывается как есть: при другом порядке байт не совпадёт при чтении
+constexpr uint32_t kByteOrder = 0x01020304;
+constexpr size_t kAlignment = 8;
+
+/**
+ * @brief Заголовок файла кэша.
+ */
+struct Header {
+  char magic[8];          ///< kMagic
+  uint32_t version;       ///< kVersion
+  uint32_t byte_order;    ///< kByteOrder
+  uint64_t source_size;   ///< Размер исходного файла
+  int64_t source_mtime;   ///< Время модификации исходного файла
+  uint64_t path_size;     ///< Длина пути к исходному файлу
+  uint64_t vertex_count;  ///< Количество вершин
+  uint64_t index_count;   ///< Количество индексов полигонов
+  uint64_t offset_count;  ///< Количество смещений полигонов
+  uint64_t edge_count;    ///< Количество рёбер
+};
+
+static_assert(sizeof(Header) % kAlignment == 0);
+static_assert(sizeof(Vertex) == 3 * sizeof(float));
+static_assert(sizeof(Edge) == 2 * sizeof(uint32_t));
+
+size_t AlignUp(size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/**
+ * @brief Последовательное чтение выровненных секций файла кэша.
+ */
+class SectionReader {
+ public:
+  SectionReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  /**
+   * @brief Возвращает начало очередной секции из count элементов.
+   *
+   * @return nullptr, если секция выходит за конец файла.
+   */
+  const char* Next(uint64_t count, size_t element_size) {
+    if (count > (size_ - offset_) / element_size) return nullptr;
+    const char* begin = data_ + offset_;
+    offset_ = std::min(size_, AlignUp(offset_ + count * element_size));
+    return begin;
+  }
+
+  /**
+   * @brief Проверяет, что все данные файла прочитаны.
+   */
+  bool AtEnd() const { return offset_ == size_; }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_ = sizeof(Header);
+};
+
+template <typename T>
+std::vector<T> ReadArray(const char* data, uint64_t count) {
+  std::vector<T> result(count);
+  if (count > 0) std::memcpy(result.data(), data, count * sizeof(T));
+  return result;
+}
+
+template <typename T>
+void WriteArray(std::ofstream& out, const T* data, size_t count) {
+  static const char kZeros[kAlignment] = {};
+  const size_t bytes = count * sizeof(T);
+  if (bytes > 0) out.write(reinterpret_cast<const char*>(data), bytes);
+  out.write(kZeros, AlignUp(bytes) - bytes);
+}
+
+}  // namespace
+
+bool ReadSourceStamp(const std::string& source, SourceStamp& stamp) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  const fs::path absolute = fs::absolute(source, ec);
+  if (ec) return false;
+  stamp.path = absolute.lexically_normal().string();
+
+  stamp.size = fs::file_size(absolute, ec);
+  if (ec) return false;
+  const auto mtime = fs::last_write_time(absolute, ec);
+  if (ec) return false;
+  stamp.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+  return true;
+}
+
+std::string MeshCache::DefaultDirectory() {
+  if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+    return std::string(xdg) + "/3DViewer";
+  }
+  if (const char* home = std::getenv("HOME"); home && *home) {
+    return std::string(home) + "/.cache/3DViewer";
+  }
+  return {};
+}
+
+std::string MeshCache::CachePath(const std::string& source) const {
+  std::error_code ec;
+  std::filesystem::path absolute = std::filesystem::absolute(source, ec);
+  const std::string key = ec ? source : absolute.lexically_normal().string();
+
+  // FNV-1a: имя файла кэша зависит только от пути к исходному файлу
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned char ch : key) {
+    hash = (hash ^ ch) * 1099511628211ull;
+  }
+
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx",
+                static_cast<unsigned long long>(hash));
+  return directory_ + "/" + name + ".mesh";
+}
+
+bool MeshCache::Load(const std::string& source, Model& model) const {
+  if (!IsEnabled()) return false;
+  ScopedTimer timer("cache.load");
+
+  SourceStamp stamp;
+  if (!ReadSourceStamp(source, stamp)) return false;
+
+  MappedFile file;
+  if (!file.Open(CachePath(source)) || file.Size() < sizeof(Header)) {
+    return false;
+  }
+
+  Header header;
+  std::memcpy(&header, file.Data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.byte_order != kByteOrder ||
+      header.source_size != stamp.size || header.source_mtime != stamp.mtime) {
+    return false;
+  }
+
+  SectionReader reader(file.Data(), file.Size());
+  const char* path = reader.Next(header.path_size, 1);
+  const char* vertices = reader.Next(header.vertex_count, sizeof(Vertex));
+  const char* indices = reader.Next(header.index_count, sizeof(uint32_t));
+  const char* offsets = reader.Next(header.offset_count, sizeof(uint32_t));
+  const char* edges = reader.Next(header.edge_count, sizeof(Edge));
+  if (!path || !vertices || !indices || !offsets || !edges ||
+      !reader.AtEnd() ||
+      std::string_view(path, header.path_size) != stamp.path) {
+    return false;
+  }
+
+  Model loaded;
+  if (!loaded.SetMeshData(
+          source, ReadArray<Vertex>(vertices, header.vertex_count),
+          ReadArray<uint32_t>(indices, header.index_count),
+          ReadArray<uint32_t>(offsets, header.offset_count),
+          ReadArray<Edge>(edges, header.edge_count))) {
+    return false;
+  }
+  model = std::move(loaded);
+  return true;
+}
+
+bool MeshCache::Store(const std::string& source, const Model& model) const {
+  if (!IsEnabled()) return false;
+  ScopedTimer timer("cache.store");
+
+  SourceStamp stamp;
+  if (!ReadSourceStamp(source, stamp)) return false;
+
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  if (ec) return false;
+
+  const std::vector<Edge>& edges = model.GetEdges();
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.source_size = stamp.size;
+  header.source_mtime = stamp.mtime;
+  header.path_size = stamp.path.size();
+  header.vertex_count = model.GetVertexCount();
+  header.index_count = model.GetFaceIndices().size();
+  header.offset_count = model.GetFaceOffsets().size();
+  header.edge_count = edges.size();
+
+  // Уникальное имя временного файла на случай одновременной записи из
+  // нескольких потоков
+  const std::string path = CachePath(source);
+  const std::string tmp =
+      path + ".tmp" +
+      std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteArray(out, stamp.path.data(), stamp.path.size());
+    WriteArray(out, model.GetVertices().data(), model.GetVertexCount());
+    WriteArray(out, model.GetFaceIndices().data(), header.index_count);
+    WriteArray(out, model.GetFaceOffsets().data(), header.offset_count);
+    WriteArray(out, edges.data(), edges.size());
+    out.close();
+    if (!out) {
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tmp, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace s21
@@ -0,0 +1,129 @@
+/**
+ * @file mesh_cache.hpp
+ * @brief Двоичный кэш загруженных моделей.
+ *
+ * Для каждого исходного .obj хранится файл с уже нормализованными вершинами,
+ * полигонами (CSR) и списком рёбер. Повторная загрузка того же файла читает
+ * кэш через MappedFile и копирует массивы целиком, без разбора текста,
+ * нормализации и выделения рёбер.
+ *
+ * Формат файла (все числа в порядке байт машины, массивы выровнены на 8):
+ * заголовок (версия формата, размер и время модификации исходного файла,
+ * размеры массивов), путь к исходному файлу, вершины (3 float), индексы
+ * полигонов (uint32), смещения полигонов (uint32), рёбра (2 uint32).
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef MESH_CACHE_HPP
+#define MESH_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "model.hpp"
+
+namespace s21 {
+
+/**
+ * @struct SourceStamp
+ * @brief Признаки версии исходного файла модели.
+ *
+ * Если у файла не изменились путь, размер и время модификации, загруженная
+ * из него модель считается актуальной.
+ */
+struct SourceStamp {
+  std::string path;   ///< Абсолютный путь
+  uint64_t size = 0;  ///< Размер в байтах
+  int64_t mtime = 0;  ///< Время модификации
+
+  bool operator==(const SourceStamp&) const = default;
+};
+
+/**
+ * @brief Читает признаки версии файла.
+ *
+ * @param source Путь к файлу.
+ * @param stamp Сюда записываются признаки.
+ * @return false если файл недоступен.
+ */
+bool ReadSourceStamp(const std::string& source, SourceStamp& stamp);
+
+/**
+ * @class MeshCache
+ * @brief Каталог с двоичными копиями загруженных моделей.
+ *
+ * Запись кэша действительна, пока у исходного файла не изменились путь,
+ * размер и время модификации. Кэш с пустым каталогом выключен.
+ */
+class MeshCache {
+ public:
+  /**
+   * @brief Создаёт выключенный кэш.
+   */
+  MeshCache() = default;
+
+  /**
+   * @brief Создаёт кэш в заданном каталоге (каталог создаётся при записи).
+   *
+   * @param directory Каталог для файлов кэша.
+   */
+  explicit MeshCache(std::string directory) : directory_(std::move(directory)) {}
+
+  /**
+   * @brief Каталог кэша по умолчанию.
+   *
+   * @return $XDG_CACHE_HOME/3DViewer, ~/.cache/3DViewer или пустая строка,
+   * если домашний каталог неизвестен.
+   */
+  static std::string DefaultDirectory();
+
+  /**
+   * @brief Проверяет, включён ли кэш.
+   */
+  bool IsEnabled() const { return !directory_.empty(); }
+
+  /**
+   * @brief Возвращает каталог кэша.
+   */
+  const std::string& GetDirectory() const { return directory_; }
+
+  /**
+   * @brief Путь к файлу кэша для исходного файла.
+   *
+   * @param source Путь к исходному .obj.
+   * @return Путь к файлу кэша (файл может не существовать).
+   */
+  std::string CachePath(const std::string& source) const;
+
+  /**
+   * @brief Загружает модель из кэша.
+   *
+   * @param source Путь к исходному .obj.
+   * @param model Модель, которая заполняется при успехе; при неудаче
+   * не изменяется.
+   * @return true если найдена действительная запись кэша.
+   */
+  bool Load(const std::string& source, Model& model) const;
+
+  /**
+   * @brief Сохраняет модель в кэш.
+   *
+   * Файл записывается во временный и затем переименовывается, поэтому
+   * читатели никогда не видят частично записанный кэш.
+   *
+   * @param source Путь к исходному .obj, из которого загружена модель.
+   * @param model Загруженная (и, как правило, нормализованная) модель.
+   * @return true если кэш записан.
+   */
+  bool Store(const std::string& source, const Model& model) const;
+
+ private:
+  std::string directory_;  ///< Каталог кэша (пустой - кэш выключен)
+};
+
+}  // namespace s21
+
+#endif  // MESH_CACHE_HPP
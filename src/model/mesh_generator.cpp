@@ -0,0 +1,449 @@
+#include "mesh_generator.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace s21 {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/// Радиус многоугольника kSoup
+constexpr float kSoupRadius = 0.02f;
+
+/// Размер буфера записи файла OBJ
+constexpr size_t kWriteBuffer = size_t{1} << 20;
+
+/**
+ * @brief Хэш splitmix64: случайное число по номеру без общего состояния.
+ */
+uint64_t SplitMix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/**
+ * @brief Число из [-1, 1) из старших 24 бит хэша.
+ */
+float UnitFloat(uint64_t hash) {
+  return static_cast<float>(hash >> 40) / static_cast<float>(1 << 23) - 1.0f;
+}
+
+size_t CeilDiv(size_t a, size_t b) { return (a + b - 1) / b; }
+
+size_t CeilSqrt(size_t value) {
+  auto root = static_cast<size_t>(std::sqrt(static_cast<double>(value)));
+  while (root * root < value) ++root;
+  while (root > 0 && (root - 1) * (root - 1) >= value) --root;
+  return root;
+}
+
+/**
+ * @class ObjWriter
+ * @brief Буферизованная запись строк OBJ через std::to_chars.
+ */
+class ObjWriter {
+ public:
+  explicit ObjWriter(const std::string& path)
+      : out_(path, std::ios::binary | std::ios::trunc) {
+    buffer_.reserve(kWriteBuffer + 256);
+  }
+
+  ~ObjWriter() { Flush(); }
+
+  bool IsOpen() const { return static_cast<bool>(out_); }
+
+  bool Close() {
+    Flush();
+    out_.close();
+    return !out_.fail();
+  }
+
+  void Text(std::string_view text) {
+    buffer_.append(text);
+    if (buffer_.size() >= kWriteBuffer) Flush();
+  }
+
+  void Number(float value) {
+    char digits[32];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr);
+  }
+
+  void Number(uint64_t value) {
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr);
+  }
+
+  void Triple(std::string_view prefix, const Vertex& v) {
+    buffer_.append(prefix);
+    Number(v.x);
+    buffer_ += ' ';
+    Number(v.y);
+    buffer_ += ' ';
+    Number(v.z);
+    Text("\n");
+  }
+
+ private:
+  std::ofstream out_;
+  std::string buffer_;
+
+  void Flush() {
+    if (buffer_.empty()) return;
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+};
+
+const char* ShapeName(MeshShape shape) {
+  switch (shape) {
+    case MeshShape::kGrid:
+      return "grid";
+    case MeshShape::kSphere:
+      return "sphere";
+    case MeshShape::kSoup:
+      return "soup";
+  }
+  return "grid";
+}
+
+const char* FormatName(FaceFormat format) {
+  switch (format) {
+    case FaceFormat::kIndex:
+      return "index";
+    case FaceFormat::kTexture:
+      return "texture";
+    case FaceFormat::kNormal:
+      return "normal";
+    case FaceFormat::kFull:
+      return "full";
+  }
+  return "index";
+}
+
+bool ParseCount(std::string_view text, size_t& out) {
+  size_t value = 0;
+  const auto result =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+  if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+    return false;
+  }
+  out = value;
+  return true;
+}
+
+}  // namespace
+
+MeshGenerator::MeshGenerator(const MeshSpec& spec) : spec_(spec) {
+  const size_t faces = std::max<size_t>(spec.faces, 1);
+  size_t& sides = spec_.sides;
+  sides = std::clamp<size_t>(sides, 3, kMaxSides);
+
+  switch (spec_.shape) {
+    case MeshShape::kGrid:
+      if (sides == 3) {
+        // Две треугольные грани на клетку
+        const size_t cells = CeilDiv(faces, 2);
+        columns_ = CeilSqrt(cells);
+        rows_ = CeilDiv(cells, columns_);
+      } else {
+        // Полигон - полоса из cells_per_face_ клеток одной строки
+        sides &= ~size_t{1};
+        cells_per_face_ = (sides - 2) / 2;
+        const size_t per_row =
+            std::max<size_t>(CeilSqrt(CeilDiv(faces, cells_per_face_)), 1);
+        columns_ = per_row * cells_per_face_;
+        rows_ = CeilDiv(faces, per_row);
+      }
+      vertex_count_ = (columns_ + 1) * (rows_ + 1);
+      face_count_ = faces;
+      index_count_ = faces * sides;
+      break;
+
+    case MeshShape::kSphere: {
+      // rows_ поясов по columns_ = 2 * rows_ сегментов
+      sides = std::min<size_t>(sides, 4);
+      // Полигонов примерно density * rows_^2
+      const size_t density = sides == 3 ? 4 : 2;
+      rows_ = std::max<size_t>(CeilSqrt(faces / density), 2);
+      columns_ = rows_ * 2;
+      const size_t middle = (rows_ - 2) * columns_;
+      vertex_count_ = 2 + (rows_ - 1) * columns_;
+      face_count_ = 2 * columns_ + middle * (sides == 3 ? 2 : 1);
+      index_count_ = 2 * columns_ * 3 + middle * (sides == 3 ? 6 : 4);
+      break;
+    }
+
+    case MeshShape::kSoup:
+      vertex_count_ = faces * sides;
+      face_count_ = faces;
+      index_count_ = faces * sides;
+      break;
+  }
+}
+
+bool MeshGenerator::IsValid() const {
+  return vertex_count_ <= std::numeric_limits<uint32_t>::max();
+}
+
+Vertex MeshGenerator::GetVertex(size_t index) const {
+  switch (spec_.shape) {
+    case MeshShape::kGrid:
+      return {static_cast<float>(index % (columns_ + 1)),
+              static_cast<float>(index / (columns_ + 1)), 0.0f};
+
+    case MeshShape::kSphere: {
+      if (index == 0) return {0.0f, 1.0f, 0.0f};
+      if (index + 1 == vertex_count_) return {0.0f, -1.0f, 0.0f};
+      const size_t ring = (index - 1) / columns_ + 1;
+      const size_t segment = (index - 1) % columns_;
+      const float theta = kPi * static_cast<float>(ring) /
+                          static_cast<float>(rows_);
+      const float phi = 2.0f * kPi * static_cast<float>(segment) /
+                        static_cast<float>(columns_);
+      return {std::sin(theta) * std::cos(phi), std::cos(theta),
+              -std::sin(theta) * std::sin(phi)};
+    }
+
+    case MeshShape::kSoup: {
+      const size_t face = index / spec_.sides;
+      const size_t corner = index % spec_.sides;
+      const uint64_t hash = SplitMix64((uint64_t{spec_.seed} << 40) ^ face);
+      const float angle = 2.0f * kPi * static_cast<float>(corner) /
+                          static_cast<float>(spec_.sides);
+      return {UnitFloat(hash) + kSoupRadius * std::cos(angle),
+              UnitFloat(SplitMix64(hash)) + kSoupRadius * std::sin(angle),
+              UnitFloat(SplitMix64(hash + 1))};
+    }
+  }
+  return {};
+}
+
+Vertex MeshGenerator::GetNormal(size_t index) const {
+  // Точки сферы единичной длины - сами себе нормали
+  return spec_.shape == MeshShape::kSphere ? GetVertex(index)
+                                           : Vertex{0.0f, 0.0f, 1.0f};
+}
+
+size_t MeshGenerator::GetFace(size_t face, uint32_t* out) const {
+  switch (spec_.shape) {
+    case MeshShape::kGrid:
+      return GetGridFace(face, out);
+    case MeshShape::kSphere:
+      return GetSphereFace(face, out);
+    case MeshShape::kSoup:
+      for (size_t i = 0; i < spec_.sides; ++i) {
+        out[i] = static_cast<uint32_t>(face * spec_.sides + i);
+      }
+      return spec_.sides;
+  }
+  return 0;
+}
+
+size_t MeshGenerator::GetGridFace(size_t face, uint32_t* out) const {
+  const size_t width = columns_ + 1;
+  if (spec_.sides == 3) {
+    const size_t cell = face / 2;
+    const size_t v00 = cell / columns_ * width + cell % columns_;
+    const size_t v11 = v00 + width + 1;
+    out[0] = static_cast<uint32_t>(v00);
+    out[1] = static_cast<uint32_t>(face % 2 == 0 ? v00 + 1 : v11);
+    out[2] = static_cast<uint32_t>(face % 2 == 0 ? v11 : v00 + width);
+    return 3;
+  }
+
+  // Нижний край полосы слева направо, верхний - справа налево
+  const size_t per_row = columns_ / cells_per_face_;
+  const size_t bottom = face / per_row * width +
+                        face % per_row * cells_per_face_;
+  size_t n = 0;
+  for (size_t i = 0; i <= cells_per_face_; ++i) {
+    out[n++] = static_cast<uint32_t>(bottom + i);
+  }
+  for (size_t i = 0; i <= cells_per_face_; ++i) {
+    out[n++] = static_cast<uint32_t>(bottom + width + cells_per_face_ - i);
+  }
+  return n;
+}
+
+size_t MeshGenerator::GetSphereFace(size_t face, uint32_t* out) const {
+  const size_t segments = columns_;
+  const size_t south = vertex_count_ - 1;
+  // Вершина пояса ring (1..rows_-1) и сегмента segment (по кругу)
+  auto at = [&](size_t ring, size_t segment) {
+    return static_cast<uint32_t>(1 + (ring - 1) * segments +
+                                 segment % segments);
+  };
+
+  if (face < segments) {
+    out[0] = 0;
+    out[1] = at(1, face);
+    out[2] = at(1, face + 1);
+    return 3;
+  }
+  face -= segments;
+
+  const size_t per_cell = spec_.sides == 3 ? 2 : 1;
+  const size_t middle = (rows_ - 2) * segments * per_cell;
+  if (face >= middle) {
+    const size_t segment = face - middle;
+    out[0] = static_cast<uint32_t>(south);
+    out[1] = at(rows_ - 1, segment + 1);
+    out[2] = at(rows_ - 1, segment);
+    return 3;
+  }
+
+  const size_t cell = face / per_cell;
+  const size_t ring = cell / segments + 1;
+  const size_t segment = cell % segments;
+  const uint32_t a = at(ring, segment), b = at(ring + 1, segment);
+  const uint32_t c = at(ring + 1, segment + 1), d = at(ring, segment + 1);
+  if (per_cell == 1) {
+    out[0] = a;
+    out[1] = b;
+    out[2] = c;
+    out[3] = d;
+    return 4;
+  }
+  out[0] = a;
+  out[1] = face % 2 == 0 ? b : c;
+  out[2] = face % 2 == 0 ? c : d;
+  return 3;
+}
+
+bool ParseMeshSpec(std::string_view text, MeshSpec& spec) {
+  MeshSpec result = spec;
+  std::vector<std::string_view> parts;
+  while (true) {
+    const size_t colon = text.find(':');
+    parts.push_back(text.substr(0, colon));
+    if (colon == std::string_view::npos) break;
+    text.remove_prefix(colon + 1);
+  }
+  if (parts.size() < 2 || parts.size() > 4) return false;
+
+  if (parts[0] == "grid") {
+    result.shape = MeshShape::kGrid;
+  } else if (parts[0] == "sphere") {
+    result.shape = MeshShape::kSphere;
+  } else if (parts[0] == "soup") {
+    result.shape = MeshShape::kSoup;
+  } else {
+    return false;
+  }
+
+  if (!ParseCount(parts[1], result.faces) || result.faces == 0) return false;
+  if (parts.size() > 2 && (!ParseCount(parts[2], result.sides) ||
+                           result.sides < 3 ||
+                           result.sides > MeshGenerator::kMaxSides)) {
+    return false;
+  }
+  if (parts.size() > 3) {
+    bool found = false;
+    for (auto format : {FaceFormat::kIndex, FaceFormat::kTexture,
+                        FaceFormat::kNormal, FaceFormat::kFull}) {
+      if (parts[3] == FormatName(format)) {
+        result.format = format;
+        found = true;
+      }
+    }
+    if (!found) return false;
+  }
+
+  spec = result;
+  return true;
+}
+
+std::string MeshSpecName(const MeshSpec& spec) {
+  return std::string(ShapeName(spec.shape)) + ":" +
+         std::to_string(spec.faces) + ":" + std::to_string(spec.sides) + ":" +
+         FormatName(spec.format);
+}
+
+bool WriteMeshObj(const MeshSpec& spec, const std::string& path) {
+  const MeshGenerator generator(spec);
+  if (!generator.IsValid()) return false;
+  ObjWriter out(path);
+  if (!out.IsOpen()) return false;
+
+  const bool textures = spec.format == FaceFormat::kTexture ||
+                        spec.format == FaceFormat::kFull;
+  const bool normals = spec.format == FaceFormat::kNormal ||
+                       spec.format == FaceFormat::kFull;
+
+  out.Text("# ");
+  out.Text(MeshSpecName(spec));
+  out.Text("\n");
+  for (size_t i = 0; i < generator.GetVertexCount(); ++i) {
+    out.Triple("v ", generator.GetVertex(i));
+  }
+  // Текстурные координаты - проекция вершины на плоскость XY
+  for (size_t i = 0; textures && i < generator.GetVertexCount(); ++i) {
+    const Vertex v = generator.GetVertex(i);
+    out.Text("vt ");
+    out.Number(v.x);
+    out.Text(" ");
+    out.Number(v.y);
+    out.Text("\n");
+  }
+  for (size_t i = 0; normals && i < generator.GetVertexCount(); ++i) {
+    out.Triple("vn ", generator.GetNormal(i));
+  }
+
+  // Индексы vt и vn совпадают с индексом вершины
+  uint32_t face[MeshGenerator::kMaxSides];
+  for (size_t f = 0; f < generator.GetFaceCount(); ++f) {
+    const size_t sides = generator.GetFace(f, face);
+    out.Text("f");
+    for (size_t i = 0; i < sides; ++i) {
+      const uint64_t index = uint64_t{face[i]} + 1;
+      out.Text(" ");
+      out.Number(index);
+      if (textures || normals) {
+        out.Text("/");
+        if (textures) out.Number(index);
+        if (normals) {
+          out.Text("/");
+          out.Number(index);
+        }
+      }
+    }
+    out.Text("\n");
+  }
+  return out.Close();
+}
+
+bool GenerateMesh(const MeshSpec& spec, Model& model) {
+  const MeshGenerator generator(spec);
+  if (!generator.IsValid() ||
+      generator.GetIndexCount() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  std::vector<Vertex> vertices(generator.GetVertexCount());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    vertices[i] = generator.GetVertex(i);
+  }
+
+  std::vector<uint32_t> indices(generator.GetIndexCount());
+  std::vector<uint32_t> offsets(generator.GetFaceCount() + 1);
+  size_t end = 0;
+  for (size_t f = 0; f < generator.GetFaceCount(); ++f) {
+    end += generator.GetFace(f, indices.data() + end);
+    offsets[f + 1] = static_cast<uint32_t>(end);
+  }
+  return model.SetMeshData("generated:" + MeshSpecName(spec),
+                           std::move(vertices), std::move(indices),
+                           std::move(offsets), {});
+}
+
+}  // namespace s21
@@ -0,0 +1,180 @@
+/**
+ * @file mesh_generator.hpp
+ * @brief Синтетические сетки для замеров масштабируемости.
+ *
+ * Генератор строит решётки, сферы и «суп» из несвязанных многоугольников
+ * заданного размера - от 10^3 до 10^8 полигонов - и либо записывает их в
+ * файл OBJ (потоково, без хранения сетки в памяти), либо сразу передаёт в
+ * Model через Model::SetMeshData. Вершины и полигоны вычисляются по номеру,
+ * поэтому одна и та же сетка получается при любом способе вывода.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef MESH_GENERATOR_HPP
+#define MESH_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "model.hpp"
+
+namespace s21 {
+
+/**
+ * @enum MeshShape
+ * @brief Вид синтетической сетки.
+ */
+enum class MeshShape {
+  kGrid,    ///< Плоская решётка в плоскости z = 0
+  kSphere,  ///< UV-сфера: четырёхугольники и треугольники у полюсов
+  kSoup     ///< Несвязанные многоугольники в случайных местах куба [-1, 1]
+};
+
+/**
+ * @enum FaceFormat
+ * @brief Запись индексов в строках "f" файла OBJ.
+ */
+enum class FaceFormat {
+  kIndex,    ///< f 1 2 3
+  kTexture,  ///< f 1/1 2/2 3/3 (и строки vt)
+  kNormal,   ///< f 1//1 2//2 3//3 (и строки vn)
+  kFull      ///< f 1/1/1 2/2/2 3/3/3 (и строки vt, vn)
+};
+
+/**
+ * @struct MeshSpec
+ * @brief Параметры синтетической сетки.
+ */
+struct MeshSpec {
+  MeshShape shape = MeshShape::kGrid;  ///< Вид сетки
+  size_t faces = 1000;  ///< Число полигонов (у сферы - приблизительно)
+  /// Вершин в полигоне: 3 - треугольники. В решётке больше четырёх -
+  /// полоса из (sides - 2) / 2 клеток (нечётное округляется вниз), у сферы
+  /// больше четырёх не бывает
+  size_t sides = 4;
+  FaceFormat format = FaceFormat::kIndex;  ///< Запись индексов в файле OBJ
+  uint32_t seed = 42;  ///< Зерно случайных чисел для kSoup
+};
+
+/**
+ * @class MeshGenerator
+ * @brief Вершины и полигоны синтетической сетки по номеру.
+ */
+class MeshGenerator {
+ public:
+  /// Наибольшее число вершин в полигоне
+  static constexpr size_t kMaxSides = 64;
+
+  /**
+   * @brief Вычисляет размеры сетки.
+   *
+   * @param spec Параметры; sides ограничивается диапазоном [3, kMaxSides].
+   */
+  explicit MeshGenerator(const MeshSpec& spec);
+
+  /**
+   * @brief Проверяет, помещаются ли индексы вершин в uint32_t.
+   */
+  bool IsValid() const;
+
+  /**
+   * @brief Возвращает число вершин.
+   */
+  size_t GetVertexCount() const { return vertex_count_; }
+
+  /**
+   * @brief Возвращает число полигонов.
+   */
+  size_t GetFaceCount() const { return face_count_; }
+
+  /**
+   * @brief Возвращает общее число индексов во всех полигонах.
+   */
+  size_t GetIndexCount() const { return index_count_; }
+
+  /**
+   * @brief Возвращает вершину с номером index.
+   */
+  Vertex GetVertex(size_t index) const;
+
+  /**
+   * @brief Возвращает единичную нормаль в вершине (для строк vn).
+   */
+  Vertex GetNormal(size_t index) const;
+
+  /**
+   * @brief Записывает индексы вершин полигона (с нуля) в out.
+   *
+   * @param face Номер полигона.
+   * @param out Буфер не меньше kMaxSides элементов.
+   * @return Число вершин полигона.
+   */
+  size_t GetFace(size_t face, uint32_t* out) const;
+
+ private:
+  MeshSpec spec_;            ///< Параметры с уточнённым sides
+  size_t columns_ = 0;       ///< Решётка: клеток в строке; сфера: сегментов
+  size_t rows_ = 0;          ///< Решётка: строк клеток; сфера: поясов
+  size_t cells_per_face_ = 1;  ///< Решётка: клеток в одном полигоне
+  size_t vertex_count_ = 0;  ///< Число вершин
+  size_t face_count_ = 0;    ///< Число полигонов
+  size_t index_count_ = 0;   ///< Число индексов во всех полигонах
+
+  /**
+   * @brief GetFace() для MeshShape::kGrid.
+   */
+  size_t GetGridFace(size_t face, uint32_t* out) const;
+
+  /**
+   * @brief GetFace() для MeshShape::kSphere: шапка у северного полюса,
+   * пояса, шапка у южного полюса.
+   */
+  size_t GetSphereFace(size_t face, uint32_t* out) const;
+};
+
+/**
+ * @brief Разбирает описание сетки "вид:полигоны[:вершин[:формат]]".
+ *
+ * Вид - grid, sphere или soup; формат - index, texture, normal или full.
+ * Например: "grid:1000000", "soup:100000:6:full".
+ *
+ * @param text Описание.
+ * @param spec Результат (не меняется при ошибке).
+ * @return true если описание корректно.
+ */
+bool ParseMeshSpec(std::string_view text, MeshSpec& spec);
+
+/**
+ * @brief Описание сетки в формате ParseMeshSpec (для имён файлов и меток).
+ */
+std::string MeshSpecName(const MeshSpec& spec);
+
+/**
+ * @brief Записывает сетку в файл OBJ.
+ *
+ * Сетка не строится в памяти, поэтому размер файла ограничен только диском.
+ *
+ * @param spec Параметры сетки.
+ * @param path Путь к файлу (перезаписывается).
+ * @return true если файл записан.
+ */
+bool WriteMeshObj(const MeshSpec& spec, const std::string& path);
+
+/**
+ * @brief Строит сетку сразу в модели, без файла.
+ *
+ * @param spec Параметры сетки.
+ * @param model Модель; путь модели - "generated:" + MeshSpecName(spec).
+ * @return true если сетка построена; false если индексы не помещаются в
+ * uint32_t (модель не меняется).
+ */
+bool GenerateMesh(const MeshSpec& spec, Model& model);
+
+}  // namespace s21
+
+#endif  // MESH_GENERATOR_HPP
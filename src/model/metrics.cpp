@@ -0,0 +1,155 @@
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Перцентиль по ближайшему рангу; values сортируется на месте.
+ */
+double Percentile(std::vector<double>& values, double p) {
+  if (values.empty()) return 0;
+  const auto rank = static_cast<size_t>(
+      std::ceil(p / 100.0 * static_cast<double>(values.size())));
+  const size_t index = std::clamp<size_t>(rank, 1, values.size()) - 1;
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+std::string FormatNumber(double value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+  return buffer;
+}
+
+}  // namespace
+
+std::string JsonString(std::string_view text) {
+  std::string result = "\"";
+  for (char ch : text) {
+    if (ch == '"' || ch == '\\') {
+      result += '\\';
+      result += ch;
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+      result += escaped;
+    } else {
+      result += ch;
+    }
+  }
+  return result + "\"";
+}
+
+void Metrics::Record(std::string_view name, double value) {
+  if (!IsEnabled()) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = series_.find(name);
+  if (it == series_.end()) {
+    it = series_.emplace(std::string(name), Series()).first;
+  }
+
+  Series& series = it->second;
+  series.min = series.count == 0 ? value : std::min(series.min, value);
+  series.max = series.count == 0 ? value : std::max(series.max, value);
+  series.total += value;
+  series.last = value;
+  ++series.count;
+
+  if (series.window.size() < kWindowSize) {
+    series.window.push_back(value);
+  } else {
+    series.window[series.next] = value;
+    series.next = (series.next + 1) % kWindowSize;
+  }
+}
+
+void Metrics::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  series_.clear();
+}
+
+bool Metrics::GetSummary(std::string_view name, MetricSummary& summary) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = series_.find(name);
+  if (it == series_.end()) return false;
+  summary = Summarize(it->first, it->second);
+  return true;
+}
+
+std::vector<MetricSummary> Metrics::GetSummaries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<MetricSummary> summaries;
+  summaries.reserve(series_.size());
+  for (const auto& [name, series] : series_) {
+    summaries.push_back(Summarize(name, series));
+  }
+  return summaries;
+}
+
+MetricSummary Metrics::Summarize(const std::string& name,
+                                 const Series& series) {
+  MetricSummary summary;
+  summary.name = name;
+  summary.count = series.count;
+  summary.total = series.total;
+  summary.min = series.min;
+  summary.max = series.max;
+  summary.last = series.last;
+  summary.mean =
+      series.count > 0 ? series.total / static_cast<double>(series.count) : 0;
+
+  std::vector<double> window = series.window;
+  summary.p50 = Percentile(window, 50);
+  summary.p99 = Percentile(window, 99);
+  return summary;
+}
+
+std::string Metrics::ToJson() const {
+  std::string json = "{\"metrics\": [";
+  bool first = true;
+  for (const MetricSummary& s : GetSummaries()) {
+    json += first ? "\n" : ",\n";
+    first = false;
+    json += "  {\"name\": " + JsonString(s.name) +
+            ", \"count\": " + std::to_string(s.count) +
+            ", \"total\": " + FormatNumber(s.total) +
+            ", \"min\": " + FormatNumber(s.min) +
+            ", \"max\": " + FormatNumber(s.max) +
+            ", \"mean\": " + FormatNumber(s.mean) +
+            ", \"p50\": " + FormatNumber(s.p50) +
+            ", \"p99\": " + FormatNumber(s.p99) +
+            ", \"last\": " + FormatNumber(s.last) + "}";
+  }
+  json += first ? "]}\n" : "\n]}\n";
+  return json;
+}
+
+std::string Metrics::ToCsv() const {
+  std::string csv = "name,count,total,min,max,mean,p50,p99,last\n";
+  for (const MetricSummary& s : GetSummaries()) {
+    csv += s.name + "," + std::to_string(s.count) + "," +
+           FormatNumber(s.total) + "," + FormatNumber(s.min) + "," +
+           FormatNumber(s.max) + "," + FormatNumber(s.mean) + "," +
+           FormatNumber(s.p50) + "," + FormatNumber(s.p99) + "," +
+           FormatNumber(s.last) + "\n";
+  }
+  return csv;
+}
+
+bool Metrics::WriteToFile(const std::string& path) const {
+  const bool csv = path.ends_with(".csv");
+  std::ofstream out(path, std::ios::trunc);
+  if (!out) return false;
+  out << (csv ? ToCsv() : ToJson());
+  out.close();
+  return static_cast<bool>(out);
+}
+
+}  // namespace s21
@@ -0,0 +1,211 @@
+/**
+ * @file metrics.hpp
+ * @brief Сбор показателей производительности: времена этапов и счётчики.
+ *
+ * Этапы загрузки, нормализации, выделения рёбер, команды трансформации и
+ * кадры отрисовки записывают свои значения в общий реестр Metrics. По каждому
+ * показателю хранятся итоги (количество, сумма, минимум, максимум) и окно
+ * последних значений для перцентилей. Реестр выгружается в JSON или CSV для
+ * отслеживания регрессий.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @struct MetricSummary
+ * @brief Итоги одного показателя.
+ *
+ * Перцентили считаются по последним Metrics::kWindowSize значениям,
+ * остальные поля - по всем значениям с последнего Reset().
+ */
+struct MetricSummary {
+  std::string name;   ///< Имя показателя
+  size_t count = 0;   ///< Количество значений
+  double total = 0;   ///< Сумма значений
+  double min = 0;     ///< Минимальное значение
+  double max = 0;     ///< Максимальное значение
+  double mean = 0;    ///< Среднее значение
+  double p50 = 0;     ///< Медиана
+  double p99 = 0;     ///< 99-й перцентиль
+  double last = 0;    ///< Последнее значение
+};
+
+/**
+ * @class Metrics
+ * @brief Потокобезопасный реестр показателей (Singleton).
+ *
+ * Времена записываются в миллисекундах (см. ScopedTimer), счётчики - в своих
+ * единицах (например, байты за кадр). Запись выполняется под мьютексом,
+ * поэтому показатели рассчитаны на этапы и кадры, а не на отдельные строки
+ * файла.
+ */
+class Metrics {
+ public:
+  /// Сколько последних значений хранится для перцентилей
+  static constexpr size_t kWindowSize = 1024;
+
+  Metrics(const Metrics&) = delete;
+  void operator=(const Metrics&) = delete;
+
+  /**
+   * @brief Получает ссылку на единственный экземпляр реестра.
+   */
+  static Metrics& GetInstance() {
+    static Metrics instance;
+    return instance;
+  }
+
+  /**
+   * @brief Включает или выключает сбор показателей.
+   *
+   * Выключенный реестр игнорирует Record(), а ScopedTimer не читает часы.
+   */
+  void SetEnabled(bool enabled) { enabled_ = enabled; }
+
+  /**
+   * @brief Проверяет, включён ли сбор показателей.
+   */
+  bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Добавляет значение показателя.
+   *
+   * @param name Имя показателя (например, "load.parse").
+   * @param value Значение (для времён - миллисекунды).
+   */
+  void Record(std::string_view name, double value);
+
+  /**
+   * @brief Удаляет все собранные значения.
+   */
+  void Reset();
+
+  /**
+   * @brief Итоги показателя.
+   *
+   * @param name Имя показателя.
+   * @param summary Сюда записываются итоги.
+   * @return false если значений показателя нет.
+   */
+  bool GetSummary(std::string_view name, MetricSummary& summary) const;
+
+  /**
+   * @brief Итоги всех показателей в порядке имён.
+   */
+  std::vector<MetricSummary> GetSummaries() const;
+
+  /**
+   * @brief Итоги в формате JSON: {"metrics": [{"name": ..., ...}, ...]}.
+   */
+  std::string ToJson() const;
+
+  /**
+   * @brief Итоги в формате CSV: строка заголовка и строка на показатель.
+   */
+  std::string ToCsv() const;
+
+  /**
+   * @brief Записывает итоги в файл.
+   *
+   * Формат выбирается по расширению: ".csv" - CSV, иначе JSON.
+   *
+   * @param path Путь к файлу.
+   * @return true если файл записан.
+   */
+  bool WriteToFile(const std::string& path) const;
+
+ private:
+  /**
+   * @brief Накопленные значения одного показателя.
+   */
+  struct Series {
+    size_t count = 0;            ///< Количество значений
+    double total = 0;            ///< Сумма значений
+    double min = 0;              ///< Минимум
+    double max = 0;              ///< Максимум
+    double last = 0;             ///< Последнее значение
+    std::vector<double> window;  ///< Последние значения (кольцевой буфер)
+    size_t next = 0;             ///< Позиция записи в window
+  };
+
+  Metrics() = default;
+  ~Metrics() = default;
+
+  /**
+   * @brief Составляет итоги серии.
+   */
+  static MetricSummary Summarize(const std::string& name,
+                                 const Series& series);
+
+  mutable std::mutex mutex_;  ///< Защита series_
+  std::map<std::string, Series, std::less<>> series_;  ///< Показатели по имени
+  std::atomic<bool> enabled_{true};  ///< Включён ли сбор
+};
+
+/**
+ * @brief Строка в кавычках с экранированием по правилам JSON.
+ */
+std::string JsonString(std::string_view text);
+
+/**
+ * @class ScopedTimer
+ * @brief Записывает время жизни объекта в показатель Metrics (в мс).
+ *
+ * @code
+ * {
+ *   ScopedTimer timer("model.normalize");
+ *   ...
+ * }
+ * @endcode
+ */
+class ScopedTimer {
+ public:
+  /**
+   * @brief Начинает замер.
+   *
+   * @param name Имя показателя; строка должна жить дольше таймера.
+   */
+  explicit ScopedTimer(const char* name)
+      : name_(Metrics::GetInstance().IsEnabled() ? name : nullptr) {
+    if (name_) start_ = Clock::now();
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  void operator=(const ScopedTimer&) = delete;
+
+  /**
+   * @brief Завершает замер и записывает результат.
+   */
+  ~ScopedTimer() {
+    if (!name_) return;
+    const std::chrono::duration<double, std::milli> elapsed =
+        Clock::now() - start_;
+    Metrics::GetInstance().Record(name_, elapsed.count());
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  const char* name_;         ///< Имя показателя (nullptr - сбор выключен)
+  Clock::time_point start_;  ///< Начало замера
+};
+
+}  // namespace s21
+
+#endif  // METRICS_HPP
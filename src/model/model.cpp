@@ -1,127 +1,1006 @@
 #include "model.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <mutex>
+
+#include "bvh.hpp"
+#include "mapped_file.hpp"
+#include "metrics.hpp"
+#include "radix_sort.hpp"
+#include "thread_pool.hpp"
+#include "transform_kernels.hpp"
+
 namespace s21 {
 
+namespace {
+
+/**
+ * @brief Проверяет, является ли символ пробельным (как std::isspace в "C").
+ */
+inline bool IsSpace(char ch) {
+  return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' ||
+         ch == '\r';
+}
+
+/**
+ * @brief Отбрасывает пробельные символы в начале строки.
+ */
+inline std::string_view SkipSpaces(std::string_view s) {
+  size_t i = 0;
+  while (i < s.size() && IsSpace(s[i])) ++i;
+  return s.substr(i);
+}
+
+/**
+ * @brief Отделяет очередной токен, ограниченный пробельными символами.
+ *
+ * @param s Оставшаяся часть строки, сдвигается за токен.
+ * @return Токен или пустая строка, если токенов больше нет.
+ */
+inline std::string_view NextToken(std::string_view& s) {
+  s = SkipSpaces(s);
+  size_t i = 0;
+  while (i < s.size() && !IsSpace(s[i])) ++i;
+  std::string_view token = s.substr(0, i);
+  s.remove_prefix(i);
+  return token;
+}
+
+/**
+ * @brief Читает число с плавающей точкой, пропуская ведущие пробелы.
+ *
+ * Поведение совпадает со спецификатором %f у sscanf: допускается знак '+',
+ * разбор останавливается на первом неподходящем символе.
+ *
+ * @param s Оставшаяся часть строки, сдвигается за прочитанное число.
+ * @param out Результат.
+ * @return true если число прочитано.
+ */
+inline bool ParseFloat(std::string_view& s, float& out) {
+  s = SkipSpaces(s);
+  const char* first = s.data();
+  const char* last = s.data() + s.size();
+  if (first != last && *first == '+') ++first;
+  auto [ptr, ec] = std::from_chars(first, last, out);
+  if (ec != std::errc()) return false;
+  s.remove_prefix(static_cast<size_t>(ptr - s.data()));
+  return true;
+}
+
+/**
+ * @brief Читает беззнаковый индекс вершины из начала токена.
+ *
+ * Как и std::stoul, допускает знак '+' и игнорирует хвост после цифр.
+ * Отрицательные индексы считаются ошибкой.
+ *
+ * @param s Токен с индексом.
+ * @param out Результат.
+ * @return true если индекс прочитан.
+ */
+inline bool ParseIndex(std::string_view s, size_t& out) {
+  const char* first = s.data();
+  const char* last = s.data() + s.size();
+  if (first != last && *first == '+') ++first;
+  auto [ptr, ec] = std::from_chars(first, last, out);
+  return ec == std::errc();
+}
+
+/// Индекс vt или vn угла полигона, которого нет в файле
+constexpr uint32_t kNoAttribute = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @struct TexCoord
+ * @brief Текстурные координаты из строки vt.
+ */
+struct TexCoord {
+  float u = 0.0f;  ///< Горизонтальная координата
+  float v = 0.0f;  ///< Вертикальная координата
+};
+
+/**
+ * @struct CornerKey
+ * @brief Тройка v/vt/vn угла полигона - ключ объединения вершин поверхности.
+ */
+struct CornerKey {
+  uint32_t vertex;    ///< Индекс вершины
+  uint32_t texcoord;  ///< Индекс vt или kNoAttribute
+  uint32_t normal;    ///< Индекс vn или kNoAttribute
+
+  bool operator==(const CornerKey&) const = default;
+};
+
+/**
+ * @brief Перемешивает биты ключа (финализатор splitmix64).
+ */
+inline uint64_t Mix64(uint64_t h) {
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+/**
+ * @brief Хэш CornerKey для таблицы в Model::BuildSurface().
+ */
+struct CornerKeyHash {
+  size_t operator()(const CornerKey& key) const {
+    return static_cast<size_t>(
+        Mix64((uint64_t{key.vertex} << 32 | key.texcoord) ^
+              (uint64_t{key.normal} * 0x9e3779b97f4a7c15ULL)));
+  }
+};
+
+/**
+ * @struct WeldCell
+ * @brief Ячейка пространственной хэш-сетки Model::WeldVertices().
+ */
+struct WeldCell {
+  int64_t x, y, z;  ///< Номер ячейки по осям
+  uint32_t head;    ///< Последняя оставленная вершина ячейки
+
+  /**
+   * @brief Хэш номера ячейки.
+   */
+  static size_t Hash(int64_t x, int64_t y, int64_t z) {
+    return static_cast<size_t>(
+        Mix64(static_cast<uint64_t>(x) * 0x9e3779b97f4a7c15ULL ^
+              static_cast<uint64_t>(y) * 0xc2b2ae3d27d4eb4fULL ^
+              static_cast<uint64_t>(z)));
+  }
+};
+
+/**
+ * @brief Читает индекс атрибута (vt или vn) из токена полигона.
+ *
+ * @param index Часть токена между '/' (пустая - атрибута нет).
+ * @param count Количество атрибутов, объявленных выше строки.
+ * @param name Название атрибута для сообщения об ошибке.
+ * @return Индекс с нуля или kNoAttribute.
+ * @throws std::runtime_error если индекс некорректен.
+ */
+uint32_t ParseAttributeIndex(std::string_view index, size_t count,
+                             const char* name) {
+  if (index.empty()) return kNoAttribute;
+  size_t idx = 0;
+  if (!ParseIndex(index, idx) || idx == 0 || idx > count ||
+      idx > kNoAttribute) {
+    throw std::runtime_error(std::string("Invalid ") + name +
+                             " index: " + std::string(index));
+  }
+  return static_cast<uint32_t>(idx - 1);
+}
+
+/// Как часто (в байтах разобранного куска) сообщается прогресс загрузки
+constexpr size_t kProgressStep = size_t{1} << 20;
+/// С какого числа ключей рёбер кусок начинает удалять из них повторы
+constexpr size_t kMinEdgeCompaction = size_t{1} << 20;
+
+/**
+ * @brief Упаковывает ребро в 64-битный ключ (min << 32 | max).
+ */
+inline uint64_t EdgeKey(uint64_t a, uint64_t b) {
+  return a < b ? (a << 32 | b) : (b << 32 | a);
+}
+
+/**
+ * @brief Делит [0, count) на блоки и вызывает fn(begin, end, block) для
+ * каждого.
+ *
+ * Если многопоточность запрещена или вершин мало, fn вызывается один раз
+ * в текущем потоке. Границы блоков кратны 8, чтобы векторные ядра
+ * не уходили в скалярный хвост посреди массива.
+ *
+ * @return Количество блоков.
+ */
+template <typename Fn>
+size_t ForEachBlock(size_t count, const ExecutionPolicy& policy, Fn&& fn) {
+  auto& pool = ThreadPool::GetInstance();
+  const size_t threads = pool.GetThreadCount();
+  if (!policy.parallel || threads == 1 || count < policy.min_parallel_size ||
+      count < 2) {
+    fn(size_t{0}, count, size_t{0});
+    return 1;
+  }
+
+  const size_t blocks = std::min(threads * 4, count / 2);
+  const size_t block_size = ((count + blocks - 1) / blocks + 7) & ~size_t{7};
+  const size_t used = (count + block_size - 1) / block_size;
+  pool.ParallelFor(used, [&](size_t b) {
+    fn(b * block_size, std::min(count, (b + 1) * block_size), b);
+  });
+  return used;
+}
+
+}  // namespace
+
+/**
+ * @brief Результат разбора одного куска файла.
+ *
+ * Кусок всегда начинается с начала строки и заканчивается после символа
+ * перевода строки (или в конце файла). Номера строк внутри куска локальные,
+ * отсчёт с 1.
+ */
+struct Model::Chunk {
+  std::string_view text;  ///< Текст куска
+  size_t line_count = 0;  ///< Количество строк в куске
+  size_t vertex_base = 0;  ///< Количество вершин во всех предыдущих кусках
+  std::vector<Vertex> vertices;    ///< Вершины куска
+  std::vector<uint32_t> face_indices;  ///< Индексы вершин полигонов куска
+  std::vector<uint32_t> face_ends;  ///< Конец каждого полигона в face_indices
+  size_t face_count = 0;  ///< Количество разобранных полигонов
+  /// Ключи рёбер куска (LoadMode::kEdgesOnly), повторы удаляются по ходу
+  std::vector<uint64_t> edge_keys;
+  /// Размер edge_keys, при котором из ключей в следующий раз удаляются повторы
+  size_t edge_compaction = kMinEdgeCompaction;
+  std::vector<size_t> bad_vertex_lines;  ///< Строки с ошибочными вершинами
+  // --- Атрибуты (LoadOptions::attributes) ---
+  size_t texcoord_base = 0;  ///< Количество vt во всех предыдущих кусках
+  size_t normal_base = 0;    ///< Количество vn во всех предыдущих кусках
+  std::vector<TexCoord> texcoords;  ///< Текстурные координаты куска
+  std::vector<Vertex> normals;      ///< Нормали куска
+  std::vector<uint32_t> corner_texcoords;  ///< vt каждого из face_indices
+  std::vector<uint32_t> corner_normals;    ///< vn каждого из face_indices
+  bool has_valid_data = false;  ///< Найдены ли корректные данные
+  size_t error_line = 0;  ///< Локальный номер строки последней ошибки
+  std::string error_message;  ///< Текст последней ошибки
+};
+
+/**
+ * @brief Атрибуты углов полигона для ParsePolygon().
+ */
+struct Model::FaceAttributes {
+  size_t texcoord_count = 0;  ///< Количество vt, объявленных выше строки
+  size_t normal_count = 0;    ///< Количество vn, объявленных выше строки
+  std::vector<uint32_t>* texcoords = nullptr;  ///< Куда дописать vt углов
+  std::vector<uint32_t>* normals = nullptr;    ///< Куда дописать vn углов
+};
+
+/**
+ * @brief Общее состояние одной загрузки: прогресс и отмена.
+ *
+ * Куски файла разбираются в разных потоках, поэтому счётчики атомарные,
+ * а вызовы LoadOptions::progress сериализуются мьютексом.
+ */
+struct Model::LoadContext {
+  LoadContext(const LoadOptions& load_options, size_t size, size_t pass_count)
+      : options(load_options), bytes_total(size), passes(pass_count) {}
+
+  /**
+   * @brief Проверяет, запрошена ли отмена загрузки.
+   */
+  bool IsCancelled() {
+    if (options.cancel && options.cancel->load(std::memory_order_relaxed)) {
+      cancelled.store(true, std::memory_order_relaxed);
+    }
+    return cancelled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Учитывает обработанную часть куска и сообщает о прогрессе.
+   */
+  void Advance(size_t bytes, size_t new_vertices, size_t new_faces) {
+    work += bytes;
+    vertices += new_vertices;
+    faces += new_faces;
+    if (!options.progress) return;
+
+    std::lock_guard<std::mutex> lock(report_mutex);
+    LoadProgress progress;
+    progress.bytes_total = bytes_total;
+    progress.bytes_parsed = std::min(bytes_total, work.load() / passes);
+    progress.vertices = vertices.load();
+    progress.faces = faces.load();
+    options.progress(progress);
+  }
+
+  const LoadOptions& options;  ///< Параметры загрузки
+  const size_t bytes_total;    ///< Размер файла
+  const size_t passes;  ///< Сколько раз разбирается каждый байт файла
+  std::atomic<size_t> work{0};      ///< Байт обработано во всех проходах
+  std::atomic<size_t> vertices{0};  ///< Прочитано вершин
+  std::atomic<size_t> faces{0};     ///< Прочитано полигонов
+  std::atomic<bool> cancelled{false};  ///< Отмена замечена
+  std::mutex report_mutex;             ///< Сериализация вызовов progress
+};
+
+Model::Model() = default;
+Model::~Model() = default;
+Model::Model(Model&&) noexcept = default;
+Model& Model::operator=(Model&&) noexcept = default;
+
 bool Model::LoadFromFile(const std::string& path) {
+  return LoadFromFile(path, LoadOptions());
+}
+
+bool Model::LoadFromFile(const std::string& path, const LoadOptions& options) {
+  ScopedTimer total_timer("load.total");
   ClearErrors();
   vertices_.clear();
-  polygons_.clear();
+  face_indices_.clear();
+  face_offsets_.clear();
+  edges_.clear();
+  edges_dirty_ = true;
+  bounds_dirty_ = true;
+  bvh_dirty_ = true;
+  transform_ = Matrix4::Identity();
+  ReleaseSourceVertices();
+  ClearSurface();
+  weld_stats_ = WeldStats();
   path_file_ = path;
 
-  std::ifstream file(path);
-  if (!file.is_open()) {
+  MappedFile file;
+  if (!file.Open(path)) {
     SetError(ErrorCode::kFileOpenError, "Failed to open file: " + path);
     path_file_ = "Failed to open file: " + path;
     return false;
   }
 
-  std::string line;
-  size_t line_num = 0;
+  std::vector<Chunk> chunks = SplitIntoChunks(file.View(), options);
+  LoadContext context(options, file.Size(), chunks.size() == 1 ? 1 : 2);
+
+  if (chunks.size() == 1) {
+    // Один кусок: вершины и полигоны разбираются за один проход
+    ScopedTimer timer("load.parse");
+    ParseChunk(chunks[0], ParsePass::kAll, context);
+  } else {
+    ScopedTimer timer("load.parse");
+    // Проход 1: вершины. После него известно точное число вершин в каждом
+    // куске, и проверка индексов полигонов остаётся такой же строгой, как при
+    // последовательном разборе (ссылаться можно только на уже объявленные
+    // вершины).
+    auto& pool = ThreadPool::GetInstance();
+    {
+      ScopedTimer pass_timer("load.parse_vertices");
+      pool.ParallelFor(chunks.size(), [&](size_t i) {
+        ParseChunk(chunks[i], ParsePass::kVertices, context);
+      });
+    }
+
+    size_t vertex_base = 0;
+    size_t texcoord_base = 0;
+    size_t normal_base = 0;
+    for (Chunk& chunk : chunks) {
+      chunk.vertex_base = vertex_base;
+      chunk.texcoord_base = texcoord_base;
+      chunk.normal_base = normal_base;
+      vertex_base += chunk.vertices.size();
+      texcoord_base += chunk.texcoords.size();
+      normal_base += chunk.normals.size();
+    }
+
+    // Проход 2: полигоны
+    ScopedTimer pass_timer("load.parse_polygons");
+    pool.ParallelFor(chunks.size(), [&](size_t i) {
+      ParseChunk(chunks[i], ParsePass::kPolygons, context);
+    });
+  }
+
+  if (context.IsCancelled()) {
+    SetError(ErrorCode::kCancelled, "Loading cancelled");
+    return false;
+  }
+
   bool has_valid_data = false;
+  {
+    ScopedTimer timer("load.merge");
+    if (!MergeChunks(chunks, has_valid_data)) return false;
+  }
+
+  if (!has_valid_data) {
+    SetError(ErrorCode::kNoValidData, "No valid data found in file");
+    return false;
+  }
+
+  if (!IsValid()) {
+    SetError(ErrorCode::kInvalidData, "Loaded data is invalid");
+    return false;
+  }
+
+  if (context.IsCancelled()) {
+    vertices_.clear();
+    face_indices_.clear();
+    face_offsets_.clear();
+    SetError(ErrorCode::kCancelled, "Loading cancelled");
+    return false;
+  }
+
+  if (options.mode == LoadMode::kEdgesOnly) {
+    ScopedTimer timer("model.extract_edges");
+    MergeEdgeKeys(chunks);
+  } else {
+    ExtractEdges();
+    if (options.attributes) {
+      ScopedTimer timer("load.surface");
+      BuildSurface(chunks);
+    }
+  }
+  if (options.weld) WeldVertices();
+  return true;
+}
+
+bool Model::SetMeshData(std::string path, std::vector<Vertex> vertices,
+                        std::vector<uint32_t> face_indices,
+                        std::vector<uint32_t> face_offsets,
+                        std::vector<Edge> edges) {
+  ClearErrors();
+  path_file_ = std::move(path);
+  vertices_ = std::move(vertices);
+  face_indices_ = std::move(face_indices);
+  face_offsets_ = std::move(face_offsets);
+  edges_ = std::move(edges);
+  edges_dirty_ = edges_.empty();
+  bounds_dirty_ = true;
+  bvh_dirty_ = true;
+  transform_ = Matrix4::Identity();
+  ReleaseSourceVertices();
+  ClearSurface();
+  weld_stats_ = WeldStats();
+
+  const size_t vertex_count = vertices_.size();
+  bool valid = face_offsets_.empty()
+                   ? face_indices_.empty()
+                   : face_offsets_.front() == 0 &&
+                         face_offsets_.back() == face_indices_.size() &&
+                         std::is_sorted(face_offsets_.begin(),
+                                        face_offsets_.end());
+  valid = valid && std::ranges::all_of(face_indices_, [&](uint32_t i) {
+            return i < vertex_count;
+          });
+  valid = valid && std::ranges::all_of(edges_, [&](const Edge& e) {
+            return e.first < vertex_count && e.second < vertex_count;
+          });
+
+  if (!valid) {
+    vertices_.clear();
+    face_indices_.clear();
+    face_offsets_.clear();
+    edges_.clear();
+    edges_dirty_ = true;
+    SetError(ErrorCode::kInvalidData, "Inconsistent mesh data");
+    return false;
+  }
+  return true;
+}
+
+std::vector<Model::Chunk> Model::SplitIntoChunks(std::string_view text,
+                                                 const LoadOptions& options) {
+  size_t chunk_count = 1;
+  const size_t threads = ThreadPool::GetInstance().GetThreadCount();
+  size_t max_chunks = options.max_chunks;
+  if (max_chunks == 0) max_chunks = threads > 1 ? threads * 4 : 1;
+  if (options.parallel && options.min_chunk_size > 0) {
+    chunk_count = std::clamp<size_t>(text.size() / options.min_chunk_size, 1,
+                                     max_chunks);
+  }
+
+  std::vector<Chunk> chunks;
+  chunks.reserve(chunk_count);
+
+  size_t begin = 0;
+  for (size_t i = 1; i <= chunk_count && begin < text.size(); ++i) {
+    size_t end = text.size();
+    if (i < chunk_count) {
+      // Сдвигаем границу к ближайшему переводу строки
+      end = std::max(begin, text.size() / chunk_count * i);
+      size_t nl = text.find('\n', end);
+      end = nl == std::string_view::npos ? text.size() : nl + 1;
+    }
+    chunks.emplace_back();
+    chunks.back().text = text.substr(begin, end - begin);
+    begin = end;
+  }
+
+  if (chunks.empty()) chunks.emplace_back();
+  return chunks;
+}
+
+void Model::ParseChunk(Chunk& chunk, ParsePass pass, LoadContext& context) {
+  const bool parse_vertices = pass != ParsePass::kPolygons;
+  const bool parse_polygons = pass != ParsePass::kVertices;
+  const bool edges_only = context.options.mode == LoadMode::kEdgesOnly;
+  const bool attributes = context.options.attributes && !edges_only;
+
+  const char* pos = chunk.text.data();
+  const char* const end = pos + chunk.text.size();
+  size_t line_num = 0;
+  size_t local_vertices = 0;  // Вершины куска, объявленные выше текущей строки
+  size_t local_texcoords = 0;  // То же для vt и vn: их строки не отбрасываются
+  size_t local_normals = 0;
+  FaceAttributes face_attributes;
+  face_attributes.texcoords = &chunk.corner_texcoords;
+  face_attributes.normals = &chunk.corner_normals;
+  auto bad_vertex = chunk.bad_vertex_lines.begin();
+
+  // Что уже учтено в общем прогрессе
+  const char* reported_pos = pos;
+  size_t reported_vertices = 0;
+  size_t reported_faces = 0;
+  auto report = [&] {
+    const size_t vertices = parse_vertices ? chunk.vertices.size() : 0;
+    context.Advance(static_cast<size_t>(std::min(pos, end) - reported_pos),
+                    vertices - reported_vertices,
+                    chunk.face_count - reported_faces);
+    reported_pos = std::min(pos, end);
+    reported_vertices = vertices;
+    reported_faces = chunk.face_count;
+  };
+
+  if (context.IsCancelled()) return;
+
+  while (pos < end) {
+    if (static_cast<size_t>(pos - reported_pos) >= kProgressStep) {
+      report();
+      if (context.IsCancelled()) return;
+    }
 
-  while (std::getline(file, line)) {
     line_num++;
-    line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](int ch) {
-                 return !std::isspace(ch);
-               }));
+    const char* eol = static_cast<const char*>(
+        std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    if (!eol) eol = end;
 
+    std::string_view line(pos, static_cast<size_t>(eol - pos));
+    pos = eol + 1;
+
+    line = SkipSpaces(line);
     if (line.empty() || line[0] == '#') {
       continue;
     }
 
     try {
       if (line.starts_with("v ")) {
-        if (ParseVertex(line)) {
-          has_valid_data = true;
+        if (parse_vertices) {
+          chunk.bad_vertex_lines.push_back(line_num);
+          chunk.vertices.push_back(ParseVertex(line));
+          chunk.bad_vertex_lines.pop_back();
+          chunk.has_valid_data = true;
+          local_vertices = chunk.vertices.size();
+        } else if (bad_vertex != chunk.bad_vertex_lines.end() &&
+                   *bad_vertex == line_num) {
+          ++bad_vertex;  // Эта вершина не была добавлена в первом проходе
+        } else {
+          ++local_vertices;
+        }
+      } else if (attributes && line.starts_with("vt ")) {
+        // Ошибочная строка оставляет нулевые координаты, чтобы номера
+        // следующих vt не сдвигались
+        ++local_texcoords;
+        if (parse_vertices) {
+          chunk.texcoords.emplace_back();
+          std::string_view rest = line.substr(2);
+          TexCoord& t = chunk.texcoords.back();
+          if (!ParseFloat(rest, t.u)) {
+            throw std::runtime_error("Invalid texture coordinate format");
+          }
+          ParseFloat(rest, t.v);  // Вторая координата необязательна
+        }
+      } else if (attributes && line.starts_with("vn ")) {
+        ++local_normals;
+        if (parse_vertices) {
+          chunk.normals.emplace_back();
+          chunk.normals.back() = ParseVertex(line.substr(1));
         }
-      } else if (line.starts_with("f ")) {
-        if (ParsePolygon(line)) {
-          has_valid_data = true;
+      } else if (parse_polygons && line.starts_with("f ")) {
+        const size_t start = chunk.face_indices.size();
+        face_attributes.texcoord_count = chunk.texcoord_base + local_texcoords;
+        face_attributes.normal_count = chunk.normal_base + local_normals;
+        if (ParsePolygon(line, chunk.vertex_base + local_vertices,
+                         chunk.face_indices,
+                         attributes ? &face_attributes : nullptr)) {
+          ++chunk.face_count;
+          chunk.has_valid_data = true;
+          if (edges_only) {
+            AppendEdgeKeys(chunk, start);
+          } else {
+            chunk.face_ends.push_back(
+                static_cast<uint32_t>(chunk.face_indices.size()));
+          }
         }
       }
     } catch (const std::exception& e) {
-      SetError(ErrorCode::kInvalidData,
-               "Error at line " + std::to_string(line_num) + ": " + e.what());
+      // Кусок разбирается в два прохода: ошибка вершины из первого прохода
+      // на более поздней строке остаётся последней, как при разборе подряд
+      if (line_num >= chunk.error_line) {
+        chunk.error_line = line_num;
+        chunk.error_message = e.what();
+      }
     }
   }
 
-  if (!has_valid_data) {
-    SetError(ErrorCode::kNoValidData, "No valid data found in file");
-    return false;
+  chunk.line_count = line_num;
+  if (edges_only) SortUnique(chunk.edge_keys);
+  report();
+}
+
+void Model::AppendEdgeKeys(Chunk& chunk, size_t start) {
+  const uint32_t* face = chunk.face_indices.data() + start;
+  const size_t size = chunk.face_indices.size() - start;
+  for (size_t i = 0; i < size; ++i) {
+    const uint32_t a = face[i];
+    const uint32_t b = face[i + 1 < size ? i + 1 : 0];
+    if (a != b) chunk.edge_keys.push_back(EdgeKey(a, b));
   }
+  chunk.face_indices.resize(start);
 
-  if (!IsValid()) {
-    SetError(ErrorCode::kInvalidData, "Loaded data is invalid");
+  // Каждое ребро замкнутой сетки встречается дважды: периодически удаляем
+  // повторы, чтобы буфер куска оставался порядка числа уникальных рёбер
+  if (chunk.edge_keys.size() >= chunk.edge_compaction) {
+    SortUnique(chunk.edge_keys);
+    chunk.edge_compaction =
+        std::max(kMinEdgeCompaction, chunk.edge_keys.size() * 2);
+  }
+}
+
+bool Model::MergeChunks(std::vector<Chunk>& chunks, bool& has_valid_data) {
+  size_t vertex_count = 0;
+  size_t polygon_count = 0;
+  size_t index_count = 0;
+  for (const Chunk& chunk : chunks) {
+    vertex_count += chunk.vertices.size();
+    polygon_count += chunk.face_ends.size();
+    index_count += chunk.face_indices.size();
+  }
+
+  if (index_count > std::numeric_limits<uint32_t>::max()) {
+    SetError(ErrorCode::kInvalidData, "Too many face indices in file");
     return false;
   }
 
+  vertices_.reserve(vertex_count);
+  face_indices_.reserve(index_count);
+  if (polygon_count > 0) {
+    face_offsets_.reserve(polygon_count + 1);
+    face_offsets_.push_back(0);
+  }
+
+  has_valid_data = false;
+  size_t line_base = 0;
+  for (Chunk& chunk : chunks) {
+    vertices_.insert(vertices_.end(), chunk.vertices.begin(),
+                     chunk.vertices.end());
+
+    const auto index_base = static_cast<uint32_t>(face_indices_.size());
+    face_indices_.insert(face_indices_.end(), chunk.face_indices.begin(),
+                         chunk.face_indices.end());
+    for (uint32_t end : chunk.face_ends) {
+      face_offsets_.push_back(index_base + end);
+    }
+    has_valid_data = has_valid_data || chunk.has_valid_data;
+
+    // Куски идут в порядке файла, поэтому последняя ошибка - из последнего
+    // куска, в котором она была
+    if (chunk.error_line != 0) {
+      SetError(ErrorCode::kInvalidData,
+               "Error at line " + std::to_string(line_base + chunk.error_line) +
+                   ": " + chunk.error_message);
+    }
+    line_base += chunk.line_count;
+  }
+
   return true;
 }
 
-bool Model::ParseVertex(const std::string& line) {
+Vertex Model::ParseVertex(std::string_view line) {
   Vertex v;
-  int count = sscanf(line.c_str(), "v %f %f %f", &v.x, &v.y, &v.z);
-  if (count != 3) {
+  std::string_view rest = line.substr(1);
+  if (!ParseFloat(rest, v.x) || !ParseFloat(rest, v.y) ||
+      !ParseFloat(rest, v.z)) {
     throw std::runtime_error("Invalid vertex format");
   }
-  vertices_.push_back(v);
-  return true;
+  return v;
 }
 
-bool Model::ParsePolygon(const std::string& line) {
-  Polygon p;
-  std::istringstream iss(line.substr(2));
-  std::string token;
+bool Model::ParsePolygon(std::string_view line, size_t vertex_count,
+                         std::vector<uint32_t>& out,
+                         FaceAttributes* attributes) {
+  const size_t start = out.size();
+  const size_t max_index = std::min<size_t>(
+      vertex_count, std::numeric_limits<uint32_t>::max());
+  std::string_view rest = line.substr(2);
+  std::string_view token;
+
+  auto discard = [&] {
+    out.resize(start);
+    if (attributes) {
+      attributes->texcoords->resize(start);
+      attributes->normals->resize(start);
+    }
+  };
+
+  while (!(token = NextToken(rest)).empty()) {
+    // Без attributes индексы текстур и нормалей (v/vt/vn) отбрасываются
+    const size_t slash = token.find('/');
+    std::string_view index = token.substr(0, slash);
 
-  while (iss >> token) {
-    size_t pos = token.find('/');
-    if (pos != std::string::npos) {
-      token = token.substr(0, pos);
+    size_t idx = 0;
+    if (!ParseIndex(index, idx) || idx == 0 || idx > max_index) {
+      discard();
+      throw std::runtime_error("Invalid face index: " + std::string(index));
     }
+    out.push_back(static_cast<uint32_t>(idx - 1));
+    if (!attributes) continue;
 
+    std::string_view tail =
+        slash == std::string_view::npos ? "" : token.substr(slash + 1);
+    const size_t second = tail.find('/');
     try {
-      size_t idx = std::stoul(token);
-      if (idx == 0 || idx > vertices_.size()) {
-        throw std::out_of_range("Vertex index out of range");
+      attributes->texcoords->push_back(ParseAttributeIndex(
+          tail.substr(0, second), attributes->texcoord_count, "texture"));
+      attributes->normals->push_back(ParseAttributeIndex(
+          second == std::string_view::npos ? "" : tail.substr(second + 1),
+          attributes->normal_count, "normal"));
+    } catch (const std::exception&) {
+      discard();
+      throw;
+    }
+  }
+
+  Polygon p{std::span<const uint32_t>(out.data() + start, out.size() - start)};
+  if (!p.IsValid(vertex_count)) {
+    discard();
+    return false;
+  }
+  return true;
+}
+
+void Model::ExtractEdges() const {
+  ScopedTimer timer("model.extract_edges");
+  constexpr uint64_t kNoEdge = std::numeric_limits<uint64_t>::max();
+  constexpr size_t kFacesPerTask = size_t{1} << 14;
+
+  // Один ключ на каждый индекс полигона: ребро от вершины к следующей
+  std::vector<uint64_t> keys(face_indices_.size());
+  const size_t face_count = GetPolygonCount();
+  const size_t tasks = (face_count + kFacesPerTask - 1) / kFacesPerTask;
+
+  ThreadPool::GetInstance().ParallelFor(tasks, [&](size_t t) {
+    const size_t face_end = std::min(face_count, (t + 1) * kFacesPerTask);
+    for (size_t f = t * kFacesPerTask; f < face_end; ++f) {
+      const uint32_t first = face_offsets_[f];
+      const uint32_t last = face_offsets_[f + 1];
+      for (uint32_t i = first; i < last; ++i) {
+        const uint32_t a = face_indices_[i];
+        const uint32_t b = face_indices_[i + 1 < last ? i + 1 : first];
+        keys[i] = a == b ? kNoEdge : EdgeKey(a, b);
       }
-      p.vertex_indices.push_back(idx - 1);
-    } catch (...) {
-      throw std::runtime_error("Invalid face index: " + token);
     }
+  });
+
+  SortUnique(keys);
+  if (!keys.empty() && keys.back() == kNoEdge) keys.pop_back();
+  SetEdgesFromKeys(keys);
+}
+
+void Model::MergeEdgeKeys(std::vector<Chunk>& chunks) {
+  std::vector<uint64_t> keys = std::move(chunks[0].edge_keys);
+  if (chunks.size() > 1) {
+    size_t total = 0;
+    for (const Chunk& chunk : chunks) total += chunk.edge_keys.size();
+    keys.reserve(keys.size() + total);
+    for (Chunk& chunk : chunks) {
+      keys.insert(keys.end(), chunk.edge_keys.begin(), chunk.edge_keys.end());
+      std::vector<uint64_t>().swap(chunk.edge_keys);
+    }
+    SortUnique(keys);
   }
+  SetEdgesFromKeys(keys);
+}
 
-  if (p.IsValid(vertices_.size())) {
-    polygons_.push_back(p);
-    return true;
+void Model::SetEdgesFromKeys(std::vector<uint64_t>& keys) const {
+  edges_.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    edges_[i] = {static_cast<uint32_t>(keys[i] >> 32),
+                 static_cast<uint32_t>(keys[i])};
   }
-  return false;
+  std::vector<uint64_t>().swap(keys);
+  edges_dirty_ = false;
 }
 
-std::vector<std::pair<size_t, size_t>> Model::GetEdges() const {
-  std::set<std::pair<size_t, size_t>> unique_edges;
+void Model::BuildSurface(std::vector<Chunk>& chunks) {
+  std::vector<TexCoord> texcoords;
+  std::vector<Vertex> normals;
+  std::vector<uint32_t> corner_texcoords;
+  std::vector<uint32_t> corner_normals;
+  if (chunks.size() == 1) {
+    texcoords = std::move(chunks[0].texcoords);
+    normals = std::move(chunks[0].normals);
+    corner_texcoords = std::move(chunks[0].corner_texcoords);
+    corner_normals = std::move(chunks[0].corner_normals);
+  } else {
+    for (Chunk& chunk : chunks) {
+      texcoords.insert(texcoords.end(), chunk.texcoords.begin(),
+                       chunk.texcoords.end());
+      normals.insert(normals.end(), chunk.normals.begin(),
+                     chunk.normals.end());
+      corner_texcoords.insert(corner_texcoords.end(),
+                              chunk.corner_texcoords.begin(),
+                              chunk.corner_texcoords.end());
+      corner_normals.insert(corner_normals.end(), chunk.corner_normals.begin(),
+                            chunk.corner_normals.end());
+      std::vector<TexCoord>().swap(chunk.texcoords);
+      std::vector<Vertex>().swap(chunk.normals);
+      std::vector<uint32_t>().swap(chunk.corner_texcoords);
+      std::vector<uint32_t>().swap(chunk.corner_normals);
+    }
+  }
 
-  for (const Polygon& poly : polygons_) {
-    if (poly.vertex_indices.size() < 2) continue;
+  // Углы полигонов идут в порядке face_indices_, поэтому i-й угол - это
+  // тройка (face_indices_[i], corner_texcoords[i], corner_normals[i])
+  const size_t corner_count = face_indices_.size();
+  std::vector<uint32_t> corner_vertex(corner_count);
 
-    for (size_t i = 0; i < poly.vertex_indices.size(); ++i) {
-      size_t start = poly.vertex_indices[i];
-      size_t end = poly.vertex_indices[(i + 1) % poly.vertex_indices.size()];
+  // Хэш-таблица с открытой адресацией: слот хранит номер вершины
+  // поверхности, ключ берётся из keys. Заполнена не больше чем наполовину,
+  // и в отличие от std::unordered_map не выделяет память на каждый ключ
+  const size_t mask = std::bit_ceil(std::max<size_t>(corner_count * 2, 2)) - 1;
+  std::vector<uint32_t> slots(mask + 1, kNoAttribute);
+  std::vector<CornerKey> keys;
+  keys.reserve(corner_count);
+  const CornerKeyHash hash;
+  for (size_t i = 0; i < corner_count; ++i) {
+    const CornerKey key{face_indices_[i], corner_texcoords[i],
+                        corner_normals[i]};
+    size_t slot = hash(key) & mask;
+    while (slots[slot] != kNoAttribute && keys[slots[slot]] != key) {
+      slot = (slot + 1) & mask;
+    }
+    if (slots[slot] == kNoAttribute) {
+      slots[slot] = static_cast<uint32_t>(keys.size());
+      keys.push_back(key);
+    }
+    corner_vertex[i] = slots[slot];
+  }
+  std::vector<uint32_t>().swap(slots);
 
-      if (start == end) continue;
+  surface_vertices_.reserve(keys.size());
+  surface_positions_.reserve(keys.size());
+  for (const CornerKey& key : keys) {
+    SurfaceVertex vertex{};
+    const Vertex& p = vertices_[key.vertex];
+    vertex.position[0] = p.x;
+    vertex.position[1] = p.y;
+    vertex.position[2] = p.z;
+    if (key.normal != kNoAttribute) {
+      const Vertex& n = normals[key.normal];
+      vertex.normal[0] = n.x;
+      vertex.normal[1] = n.y;
+      vertex.normal[2] = n.z;
+    }
+    if (key.texcoord != kNoAttribute) {
+      vertex.texcoord[0] = texcoords[key.texcoord].u;
+      vertex.texcoord[1] = texcoords[key.texcoord].v;
+    }
+    surface_vertices_.push_back(vertex);
+    surface_positions_.push_back(key.vertex);
+  }
 
-      auto edge = (start < end) ? std::make_pair(start, end)
-                                : std::make_pair(end, start);
-      unique_edges.insert(edge);
+  // Веер от первой вершины: полигон из n вершин - n - 2 треугольника
+  const size_t face_count = GetPolygonCount();
+  surface_triangles_.reserve((corner_count - 2 * face_count) * 3);
+  for (size_t f = 0; f < face_count; ++f) {
+    const uint32_t first = face_offsets_[f];
+    const uint32_t last = face_offsets_[f + 1];
+    for (uint32_t i = first + 1; i + 1 < last; ++i) {
+      surface_triangles_.push_back(corner_vertex[first]);
+      surface_triangles_.push_back(corner_vertex[i]);
+      surface_triangles_.push_back(corner_vertex[i + 1]);
     }
   }
+  surface_dirty_ = false;
+}
+
+void Model::UpdateSurfacePositions() const {
+  ForEachBlock(surface_vertices_.size(), policy_,
+               [&](size_t begin, size_t end, size_t) {
+                 for (size_t i = begin; i < end; ++i) {
+                   const Vertex& p = vertices_[surface_positions_[i]];
+                   float* position = surface_vertices_[i].position;
+                   position[0] = p.x;
+                   position[1] = p.y;
+                   position[2] = p.z;
+                 }
+               });
+  surface_dirty_ = false;
+}
+
+void Model::TransformSurfaceNormals(const Matrix4& transform,
+                                    const std::vector<Vertex>* source) {
+  // Нормали преобразуются транспонированной обратной матрицей, иначе после
+  // неравномерного масштаба они перестают быть перпендикулярны граням
+  const Matrix4 inverse = transform.AffineInverse();
+  const bool identity = transform.IsIdentity();
+  ForEachBlock(
+      surface_vertices_.size(), policy_, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+          float* normal = surface_vertices_[i].normal;
+          const float n[3] = {
+              source ? (*source)[i].x : normal[0],
+              source ? (*source)[i].y : normal[1],
+              source ? (*source)[i].z : normal[2]};
+          if (identity) {
+            std::copy(n, n + 3, normal);  // Исходная нормаль без изменений
+            continue;
+          }
+          float length = 0.0f;
+          for (int row = 0; row < 3; ++row) {
+            normal[row] = inverse(0, row) * n[0] + inverse(1, row) * n[1] +
+                          inverse(2, row) * n[2];
+            length += normal[row] * normal[row];
+          }
+          // Нормаль, которой не было в файле, остаётся нулевой
+          if (length > 0.0f) {
+            const float scale = 1.0f / std::sqrt(length);
+            for (int row = 0; row < 3; ++row) normal[row] *= scale;
+          }
+        }
+      });
+}
+
+void Model::ComputeBoundingBox() const {
+  bounds_ = BoundingBox();
+  bounds_dirty_ = false;
+  if (vertices_.empty()) return;
 
-  return {unique_edges.begin(), unique_edges.end()};
+  // По одному частичному AABB на блок; блоков не больше 4 * число потоков
+  const size_t max_blocks = ThreadPool::GetInstance().GetThreadCount() * 4;
+  std::vector<BoundingBox> partial(max_blocks);
+  const size_t blocks = ForEachBlock(
+      vertices_.size(), policy_, [&](size_t begin, size_t end, size_t block) {
+        BoundingBox& box = partial[block];
+        box.min = box.max = vertices_[begin];
+        for (size_t i = begin; i < end; ++i) {
+          const Vertex& v = vertices_[i];
+          box.min.x = std::min(box.min.x, v.x);
+          box.min.y = std::min(box.min.y, v.y);
+          box.min.z = std::min(box.min.z, v.z);
+
+          box.max.x = std::max(box.max.x, v.x);
+          box.max.y = std::max(box.max.y, v.y);
+          box.max.z = std::max(box.max.z, v.z);
+        }
+      });
+
+  bounds_ = partial[0];
+  for (size_t b = 1; b < blocks; ++b) {
+    bounds_.min.x = std::min(bounds_.min.x, partial[b].min.x);
+    bounds_.min.y = std::min(bounds_.min.y, partial[b].min.y);
+    bounds_.min.z = std::min(bounds_.min.z, partial[b].min.z);
+
+    bounds_.max.x = std::max(bounds_.max.x, partial[b].max.x);
+    bounds_.max.y = std::max(bounds_.max.y, partial[b].max.y);
+    bounds_.max.z = std::max(bounds_.max.z, partial[b].max.z);
+  }
+}
+
+const Bvh& Model::GetBvh() const {
+  if (!bvh_) bvh_ = std::make_unique<Bvh>();
+  if (bvh_dirty_) {
+    bvh_->Build(vertices_, GetEdges());
+  } else if (bvh_refit_) {
+    bvh_->Refit(vertices_, GetEdges());
+  }
+  bvh_dirty_ = false;
+  bvh_refit_ = false;
+  return *bvh_;
+}
+
+size_t Model::GetMemoryUsage() const {
+  return (vertices_.capacity() + source_vertices_.capacity() +
+          source_normals_.capacity()) *
+             sizeof(Vertex) +
+         (face_indices_.capacity() + face_offsets_.capacity() +
+          surface_positions_.capacity() + surface_triangles_.capacity()) *
+             sizeof(uint32_t) +
+         edges_.capacity() * sizeof(Edge) +
+         surface_vertices_.capacity() * sizeof(SurfaceVertex) +
+         (bvh_ ? bvh_->GetMemoryUsage() : 0);
 }
 
 bool Model::IsValid() const {
   if (vertices_.empty()) return false;
 
-  for (const Polygon& poly : polygons_) {
+  for (const Polygon& poly : GetPolygons()) {
     if (!poly.IsValid(vertices_.size())) {
       return false;
     }
@@ -131,35 +1010,19 @@ bool Model::IsValid() const {
 }
 
 void Model::NormalizeModel() {
+  ScopedTimer timer("model.normalize");
   if (vertices_.empty()) {
     return;  // Нечего нормализовать
   }
 
-  // Шаг 1: Находим bounding box (min и max по осям)
-  float min_x = vertices_[0].x, min_y = vertices_[0].y, min_z = vertices_[0].z;
-  float max_x = vertices_[0].x, max_y = vertices_[0].y, max_z = vertices_[0].z;
-
-  for (const auto& v : vertices_) {
-    min_x = std::min(min_x, v.x);
-    min_y = std::min(min_y, v.y);
-    min_z = std::min(min_z, v.z);
-
-    max_x = std::max(max_x, v.x);
-    max_y = std::max(max_y, v.y);
-    max_z = std::max(max_z, v.z);
-  }
+  // Шаг 1: Берём bounding box (из кэша или пересчитываем)
+  const BoundingBox box = GetBoundingBox();
 
   // Шаг 2: Вычисляем центр габаритного объёма
-  float center_x = (min_x + max_x) * 0.5f;
-  float center_y = (min_y + max_y) * 0.5f;
-  float center_z = (min_z + max_z) * 0.5f;
+  const Vertex center = box.Center();
 
   // Шаг 3: Вычисляем половину диагонали (радиус описанной сферы)
-  float dx = max_x - min_x;
-  float dy = max_y - min_y;
-  float dz = max_z - min_z;
-  float diagonal = std::sqrt(dx * dx + dy * dy + dz * dz);
-  float radius = diagonal * 0.5f;
+  float radius = box.Radius();
 
   // Защита от деления на ноль (все точки совпадают)
   if (radius < 1e-6f) {
@@ -171,11 +1034,246 @@ void Model::NormalizeModel() {
   // 2. Масштабируем, чтобы модель вписалась в сферу радиуса 1.0
   float scale_factor = 1.0f / radius;
 
-  for (auto& v : vertices_) {
-    v.x = (v.x - center_x) * scale_factor;
-    v.y = (v.y - center_y) * scale_factor;
-    v.z = (v.z - center_z) * scale_factor;
+  const Matrix4 normalize = Matrix4::Scale(scale_factor) *
+                            Matrix4::Translation(-center.x, -center.y, -center.z);
+  TransformVertices(normalize);
+
+  // Преобразование монотонно по каждой оси, поэтому новый AABB получается
+  // тем же преобразованием из старого без повторного прохода по вершинам
+  bounds_ = box;
+  normalize.Apply(bounds_.min.x, bounds_.min.y, bounds_.min.z);
+  normalize.Apply(bounds_.max.x, bounds_.max.y, bounds_.max.z);
+  bounds_dirty_ = false;
+}
+
+void Model::TransformVertices(const Matrix4& transform) {
+  ReleaseSourceVertices();
+  // Вершины лежат в памяти подряд как x, y, z - это и есть формат AoS-ядра
+  static_assert(sizeof(Vertex) == 3 * sizeof(float));
+  float* points = reinterpret_cast<float*>(vertices_.data());
+  ForEachBlock(vertices_.size(), policy_,
+               [&](size_t begin, size_t end, size_t) {
+                 TransformPoints(points + begin * 3, end - begin, transform);
+               });
+  bounds_dirty_ = true;
+  if (HasSurface()) {
+    TransformSurfaceNormals(transform, nullptr);
+    surface_dirty_ = true;
+  }
+
+  // Перенос и масштабирование переводят AABB узлов в AABB без прохода по
+  // рёбрам; после поворота узлы пересчитываются при обращении к GetBvh()
+  if (bvh_ && !bvh_dirty_ && !bvh_refit_) {
+    bvh_refit_ = !bvh_->Transform(transform);
+  }
+}
+
+void Model::SetVertexTransform(const Matrix4& transform) {
+  if (source_vertices_.empty()) {
+    if (transform.IsIdentity()) return;
+    source_vertices_ = vertices_;
+    source_normals_.reserve(surface_vertices_.size());
+    for (const SurfaceVertex& vertex : surface_vertices_) {
+      source_normals_.push_back(
+          {vertex.normal[0], vertex.normal[1], vertex.normal[2]});
+    }
   }
+
+  // Копия и преобразование в одном проходе по блокам: блок исходных вершин
+  // ещё в кэше, когда его переписывает ядро
+  const Vertex* source = source_vertices_.data();
+  float* points = reinterpret_cast<float*>(vertices_.data());
+  const bool identity = transform.IsIdentity();
+  ForEachBlock(vertices_.size(), policy_,
+               [&](size_t begin, size_t end, size_t) {
+                 std::copy(source + begin, source + end,
+                           vertices_.begin() + begin);
+                 if (!identity) {
+                   TransformPoints(points + begin * 3, end - begin, transform);
+                 }
+               });
+  bounds_dirty_ = true;
+  if (HasSurface()) {
+    TransformSurfaceNormals(transform, &source_normals_);
+    surface_dirty_ = true;
+  }
+  // Узлы иерархии соответствуют прежним вершинам, а не исходным
+  bvh_refit_ = true;
+  if (identity) ReleaseSourceVertices();
+}
+
+WeldStats Model::WeldVertices(float tolerance) {
+  ScopedTimer timer("model.weld");
+  weld_stats_ = WeldStats();
+  const size_t count = vertices_.size();
+  if (count < 2 || !(tolerance > 0.0f)) return weld_stats_;
+
+  // Ячейка со стороной kCellScale * tolerance: соседнюю ячейку по оси нужно
+  // смотреть, только если вершина ближе tolerance к её границе, поэтому
+  // на вершину приходится в среднем около двух поисков в таблице, а не 27
+  constexpr double kCellScale = 8.0;
+  const double to_cell = 1.0 / (kCellScale * static_cast<double>(tolerance));
+  constexpr double kMaxCell = 1e18;  // Номер ячейки помещается в int64_t
+  constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  const size_t mask = std::bit_ceil(count * 2) - 1;
+  std::vector<uint32_t> slots(mask + 1, kNone);  // Номера ячеек в cells
+  std::vector<WeldCell> cells;
+  std::vector<uint32_t> next(count, kNone);  // Предыдущая вершина ячейки
+  std::vector<uint32_t> remap(count);
+  auto find = [&](int64_t x, int64_t y, int64_t z) -> size_t {
+    size_t slot = WeldCell::Hash(x, y, z) & mask;
+    while (slots[slot] != kNone) {
+      const WeldCell& c = cells[slots[slot]];
+      if (c.x == x && c.y == y && c.z == z) break;
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  };
+
+  // Оставленные вершины сдвигаются к началу массива на месте: номер
+  // оставленной вершины не больше номера текущей
+  uint32_t kept = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const Vertex v = vertices_[i];
+    const double q[3] = {v.x * to_cell, v.y * to_cell, v.z * to_cell};
+    if (!(std::abs(q[0]) < kMaxCell && std::abs(q[1]) < kMaxCell &&
+          std::abs(q[2]) < kMaxCell)) {
+      remap[i] = kept;  // NaN и огромные координаты не сливаются
+      vertices_[kept++] = v;
+      continue;
+    }
+
+    int64_t cell[3];
+    int64_t side[3];
+    for (int axis = 0; axis < 3; ++axis) {
+      const double floor = std::floor(q[axis]);
+      cell[axis] = static_cast<int64_t>(floor);
+      const double offset = (q[axis] - floor) * kCellScale;
+      side[axis] = offset < 1.0 ? -1 : offset > kCellScale - 1.0 ? 1 : 0;
+    }
+
+    uint32_t match = kNone;
+    size_t own_slot = 0;
+    for (int neighbour = 0; neighbour < 8 && match == kNone; ++neighbour) {
+      if ((neighbour & 1 && !side[0]) || (neighbour & 2 && !side[1]) ||
+          (neighbour & 4 && !side[2])) {
+        continue;
+      }
+      const size_t slot =
+          find(cell[0] + (neighbour & 1 ? side[0] : 0),
+               cell[1] + (neighbour & 2 ? side[1] : 0),
+               cell[2] + (neighbour & 4 ? side[2] : 0));
+      if (neighbour == 0) own_slot = slot;
+      if (slots[slot] == kNone) continue;
+      for (uint32_t r = cells[slots[slot]].head; r != kNone; r = next[r]) {
+        const Vertex& w = vertices_[r];
+        if (std::abs(v.x - w.x) < tolerance &&
+            std::abs(v.y - w.y) < tolerance &&
+            std::abs(v.z - w.z) < tolerance) {
+          match = r;
+          break;
+        }
+      }
+    }
+    if (match != kNone) {
+      remap[i] = match;
+      continue;
+    }
+
+    if (slots[own_slot] == kNone) {
+      slots[own_slot] = static_cast<uint32_t>(cells.size());
+      cells.push_back({cell[0], cell[1], cell[2], kNone});
+    }
+    WeldCell& own = cells[slots[own_slot]];
+    next[kept] = own.head;
+    own.head = kept;
+    remap[i] = kept;
+    vertices_[kept++] = v;
+  }
+  std::vector<uint32_t>().swap(slots);
+  std::vector<WeldCell>().swap(cells);
+  std::vector<uint32_t>().swap(next);
+
+  weld_stats_.vertices_removed = count - kept;
+  if (kept == count) return weld_stats_;
+  vertices_.resize(kept);
+  vertices_.shrink_to_fit();
+
+  // Полигоны: индексы переназначаются, выродившиеся полигоны удаляются
+  // вместе со своими треугольниками поверхности (n - 2 подряд, см.
+  // BuildSurface)
+  const size_t face_count = GetPolygonCount();
+  const bool surface = !surface_triangles_.empty();
+  uint32_t write = 0;
+  size_t faces_kept = 0;
+  size_t triangle_read = 0;
+  size_t triangle_write = 0;
+  for (size_t f = 0; f < face_count; ++f) {
+    const uint32_t first = face_offsets_[f];
+    const uint32_t last = face_offsets_[f + 1];
+    const uint32_t start = write;
+    for (uint32_t i = first; i < last; ++i) {
+      face_indices_[write++] = remap[face_indices_[i]];
+    }
+    const size_t triangles = last - first > 2 ? 3 * (last - first - 2) : 0;
+    Polygon p{std::span<const uint32_t>(face_indices_.data() + start,
+                                        write - start)};
+    if (p.IsValid(kept)) {
+      face_offsets_[++faces_kept] = write;
+      if (surface && triangle_write != triangle_read) {
+        std::copy_n(surface_triangles_.begin() + triangle_read, triangles,
+                    surface_triangles_.begin() + triangle_write);
+      }
+      triangle_write += triangles;
+    } else {
+      write = start;
+    }
+    triangle_read += triangles;
+  }
+  if (face_count > 0) {
+    weld_stats_.polygons_removed = face_count - faces_kept;
+    face_indices_.resize(write);
+    face_offsets_.resize(faces_kept + 1);
+    if (surface) surface_triangles_.resize(triangle_write);
+  }
+
+  // Рёбра: у модели с полигонами строятся из них заново, у каркаса
+  // (LoadMode::kEdgesOnly) переназначаются концы, совпавшие рёбра сливаются
+  if (!edges_dirty_) {
+    const size_t edges_before = edges_.size();
+    if (face_offsets_.empty()) {
+      std::vector<uint64_t> keys;
+      keys.reserve(edges_.size());
+      for (const Edge& edge : edges_) {
+        const uint32_t a = remap[edge.first];
+        const uint32_t b = remap[edge.second];
+        if (a != b) keys.push_back(EdgeKey(a, b));
+      }
+      SortUnique(keys);
+      SetEdgesFromKeys(keys);
+    } else {
+      ExtractEdges();
+    }
+    weld_stats_.edges_removed = edges_before - edges_.size();
+  }
+
+  // Вершины поверхности указывают на вершины модели; сами тройки
+  // v/vt/vn заново не объединяются
+  for (uint32_t& position : surface_positions_) position = remap[position];
+  surface_dirty_ = !surface_vertices_.empty();
+
+  ReleaseSourceVertices();
+  bounds_dirty_ = true;
+  bvh_dirty_ = true;
+  return weld_stats_;
+}
+
+void Model::BakeTransform() {
+  if (transform_.IsIdentity()) return;
+
+  TransformVertices(transform_);
+  transform_ = Matrix4::Identity();
 }
 
-}  // namespace s21
\ No newline at end of file
+}  // namespace s21
@@ -15,17 +15,22 @@
 #define MODEL_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
-#include <fstream>
-#include <iostream>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <limits>
-#include <set>
-#include <sstream>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "transform.hpp"
+
 namespace s21 {
 
 /**
@@ -54,11 +59,11 @@ struct Vertex {
  * @struct Polygon
  * @brief Структура, представляющая полигон (многоугольник).
  *
- * Хранит индексы вершин, образующих полигон. Проверяется на корректность при
- * необходимости.
+ * Не владеет данными: ссылается на участок общего массива индексов модели
+ * (см. PolygonList). Проверяется на корректность при необходимости.
  */
 struct Polygon {
-  std::vector<size_t> vertex_indices;
+  std::span<const uint32_t> vertex_indices;  ///< Индексы вершин полигона
 
   /**
    * @brief Проверяет, является ли полигон валидным.
@@ -72,16 +77,240 @@ struct Polygon {
   bool IsValid(size_t max_vertex_index) const {
     if (vertex_indices.size() < 3) return false;
 
-    std::set<size_t> unique_indices;
+    // Достаточно найти три различных индекса: память не выделяется
+    constexpr size_t kNone = std::numeric_limits<size_t>::max();
+    size_t first = kNone, second = kNone;
+    bool unique = false;
     for (size_t idx : vertex_indices) {
       if (idx >= max_vertex_index) return false;
-      unique_indices.insert(idx);
+      if (first == kNone) {
+        first = idx;
+      } else if (idx != first && second == kNone) {
+        second = idx;
+      } else if (idx != first && idx != second) {
+        unique = true;
+      }
+    }
+    return unique;
+  }
+};
+
+/**
+ * @struct BoundingBox
+ * @brief Ограничивающий параллелепипед модели, выровненный по осям (AABB).
+ */
+struct BoundingBox {
+  Vertex min{0.0f, 0.0f, 0.0f};  ///< Минимальные координаты
+  Vertex max{0.0f, 0.0f, 0.0f};  ///< Максимальные координаты
+
+  /**
+   * @brief Возвращает центр параллелепипеда.
+   */
+  Vertex Center() const {
+    return {(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f,
+            (min.z + max.z) * 0.5f};
+  }
+
+  /**
+   * @brief Возвращает половину диагонали (радиус описанной сферы).
+   */
+  float Radius() const {
+    float dx = max.x - min.x;
+    float dy = max.y - min.y;
+    float dz = max.z - min.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz) * 0.5f;
+  }
+};
+
+/**
+ * @struct Edge
+ * @brief Ребро модели - пара индексов вершин (first < second).
+ *
+ * Массив рёбер можно напрямую использовать как индексный буфер GL_LINES.
+ */
+struct Edge {
+  uint32_t first;   ///< Индекс первой вершины
+  uint32_t second;  ///< Индекс второй вершины
+};
+
+/**
+ * @struct SurfaceVertex
+ * @brief Вершина поверхности для заливки: позиция, нормаль и текстурные
+ * координаты подряд.
+ *
+ * Массив таких вершин можно напрямую загрузить в буфер вершин (шаг 32
+ * байта). Нулевая нормаль означает, что у угла полигона в файле нет
+ * нормали (vn): её нужно взять у грани.
+ */
+struct SurfaceVertex {
+  float position[3];  ///< Позиция (вершина модели)
+  float normal[3];    ///< Нормаль из строки vn
+  float texcoord[2];  ///< Текстурные координаты из строки vt
+};
+
+/**
+ * @class PolygonList
+ * @brief Лёгкое представление списка полигонов, хранящегося в формате CSR.
+ *
+ * Индексы вершин всех полигонов лежат подряд в одном массиве, а массив
+ * смещений хранит начало каждого полигона (и конец последнего), т.е. полигон
+ * i занимает индексы [offsets[i], offsets[i + 1]).
+ */
+class PolygonList {
+ public:
+  /**
+   * @class Iterator
+   * @brief Итератор по полигонам списка.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Polygon;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Polygon;
+
+    Iterator() = default;
+    Iterator(const PolygonList* list, size_t pos) : list_(list), pos_(pos) {}
+
+    Polygon operator*() const { return (*list_)[pos_]; }
+    Iterator& operator++() {
+      ++pos_;
+      return *this;
     }
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++pos_;
+      return tmp;
+    }
+    bool operator==(const Iterator& other) const { return pos_ == other.pos_; }
+
+   private:
+    const PolygonList* list_ = nullptr;  ///< Список полигонов
+    size_t pos_ = 0;                     ///< Номер текущего полигона
+  };
+
+  /**
+   * @brief Конструктор представления.
+   *
+   * @param indices Общий массив индексов вершин.
+   * @param offsets Массив смещений (пустой или размер = число полигонов + 1).
+   */
+  PolygonList(const std::vector<uint32_t>& indices,
+              const std::vector<uint32_t>& offsets)
+      : indices_(indices), offsets_(offsets) {}
+
+  /**
+   * @brief Возвращает количество полигонов.
+   */
+  size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
 
-    return unique_indices.size() >= 3;
+  /**
+   * @brief Проверяет, пуст ли список.
+   */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Возвращает полигон с заданным номером.
+   *
+   * @param i Номер полигона.
+   */
+  Polygon operator[](size_t i) const {
+    return {std::span<const uint32_t>(indices_.data() + offsets_[i],
+                                      offsets_[i + 1] - offsets_[i])};
   }
+
+  Iterator begin() const { return {this, 0}; }
+  Iterator end() const { return {this, size()}; }
+
+ private:
+  std::span<const uint32_t> indices_;  ///< Общий массив индексов
+  std::span<const uint32_t> offsets_;  ///< Смещения полигонов
+};
+
+/**
+ * @struct LoadProgress
+ * @brief Состояние загрузки модели, передаваемое в LoadOptions::progress.
+ *
+ * При параллельном разборе файл читается в два прохода; bytes_parsed
+ * учитывает оба, поэтому растёт равномерно от 0 до bytes_total.
+ */
+struct LoadProgress {
+  size_t bytes_parsed = 0;  ///< Обработано байт файла
+  size_t bytes_total = 0;   ///< Размер файла
+  size_t vertices = 0;      ///< Прочитано вершин
+  size_t faces = 0;         ///< Прочитано полигонов
+};
+
+/**
+ * @enum LoadMode
+ * @brief Какие данные модели сохраняются при загрузке.
+ */
+enum class LoadMode {
+  kFull,      ///< Вершины, полигоны и рёбра
+  kEdgesOnly  ///< Только вершины и рёбра: полигоны сразу превращаются в рёбра
+};
+
+/**
+ * @struct LoadOptions
+ * @brief Параметры загрузки модели из файла.
+ */
+struct LoadOptions {
+  /// Разрешить многопоточный разбор файла (через ThreadPool)
+  bool parallel = true;
+  /// Минимальный размер куска файла, который разбирается одной задачей
+  size_t min_chunk_size = size_t{1} << 20;
+  /// Наибольшее число кусков; 0 - по четыре на поток пула, а без рабочих
+  /// потоков один кусок: два прохода по кускам в одном потоке медленнее
+  /// одного прохода по файлу
+  size_t max_chunks = 0;
+  /// Вызывается примерно после каждого мегабайта разобранных данных. Может
+  /// вызываться из рабочих потоков пула, но никогда из двух одновременно.
+  std::function<void(const LoadProgress&)> progress;
+  /// Флаг отмены: проверяется вместе с отчётом о прогрессе. После отмены
+  /// загрузка завершается с ошибкой kCancelled.
+  const std::atomic<bool>* cancel = nullptr;
+  /// В режиме kEdgesOnly полигоны не хранятся ни во время разбора, ни после:
+  /// каждый разобранный полигон сразу раскладывается на ключи рёбер, поэтому
+  /// пик памяти - примерно вершины и рёбра. Для каркасного просмотра больших
+  /// файлов.
+  LoadMode mode = LoadMode::kFull;
+  /// Сохранять нормали (vn) и текстурные координаты (vt) и за тот же проход
+  /// по файлу построить поверхность для заливки (Model::GetSurfaceVertices).
+  /// Не действует в режиме kEdgesOnly.
+  bool attributes = false;
+  /// После загрузки слить совпадающие вершины (Model::WeldVertices с
+  /// допуском Model::kWeldTolerance)
+  bool weld = false;
+};
+
+/**
+ * @struct WeldStats
+ * @brief Итоги слияния совпадающих вершин (Model::WeldVertices).
+ */
+struct WeldStats {
+  size_t vertices_removed = 0;  ///< Столько вершин слились с другими
+  size_t edges_removed = 0;     ///< Столько рёбер исчезло или совпало
+  size_t polygons_removed = 0;  ///< Полигоны, в которых осталось < 3 вершин
+};
+
+/**
+ * @struct ExecutionPolicy
+ * @brief Параметры выполнения поэлементных операций над вершинами.
+ *
+ * Относится к трансформациям, нормализации и пересчёту AABB. Диапазон вершин
+ * делится на блоки, которые обрабатываются в ThreadPool; небольшие модели
+ * обрабатываются в вызывающем потоке, чтобы не платить за синхронизацию.
+ */
+struct ExecutionPolicy {
+  /// Разрешить многопоточную обработку вершин
+  bool parallel = true;
+  /// Минимальное число вершин, с которого включается многопоточность
+  size_t min_parallel_size = size_t{1} << 16;
 };
 
+class Bvh;
+
 /**
  * @enum ErrorCode
  * @brief Перечисление кодов ошибок, возникающих при работе с моделью.
@@ -94,17 +323,62 @@ class Model {
     kSuccess = 0,        ///< Успешная операция
     kFileOpenError = 1,  ///< Ошибка открытия файла
     kInvalidData = 2,  ///< Некорректные данные в файле
-    kNoValidData = 3  ///< Нет валидных данных после парсинга
+    kNoValidData = 3,  ///< Нет валидных данных после парсинга
+    kCancelled = 4     ///< Загрузка отменена через LoadOptions::cancel
   };
 
+  // Определены в model.cpp, где Bvh - полный тип
+  Model();
+  ~Model();
+  Model(Model&&) noexcept;
+  Model& operator=(Model&&) noexcept;
+
   /**
    * @brief Загружает 3D-модель из файла формата .obj.
    *
+   * Файл отображается в память (см. MappedFile) и разбирается напрямую по
+   * буферу, без выделения памяти под каждую строку.
+   *
    * @param path Путь к файлу с моделью.
    * @return true если загрузка успешна, false в случае ошибки.
    */
   bool LoadFromFile(const std::string& path);
 
+  /**
+   * @brief Загружает 3D-модель из файла формата .obj с заданными параметрами.
+   *
+   * Большие файлы делятся на куски по границам строк, которые разбираются
+   * параллельно, а затем объединяются в исходном порядке. Результат и коды
+   * ошибок совпадают с последовательным разбором.
+   *
+   * @param path Путь к файлу с моделью.
+   * @param options Параметры загрузки.
+   * @return true если загрузка успешна, false в случае ошибки.
+   */
+  bool LoadFromFile(const std::string& path, const LoadOptions& options);
+
+  /**
+   * @brief Заполняет модель готовыми массивами, без разбора файла.
+   *
+   * Используется для данных, которые уже проверялись (кэш сетки,
+   * сгенерированные модели). Проверяется только структура: смещения
+   * полигонов не убывают и заканчиваются на размере face_indices, все индексы
+   * вершин в допустимом диапазоне.
+   *
+   * @param path Путь, который вернёт GetPathFile().
+   * @param vertices Вершины.
+   * @param face_indices Индексы вершин полигонов (формат CSR).
+   * @param face_offsets Пустой массив или начало каждого полигона плюс конец.
+   * @param edges Готовый список рёбер; если пуст, рёбра будут построены
+   * при первом обращении.
+   * @return true если данные корректны; иначе модель пуста, код ошибки
+   * kInvalidData.
+   */
+  bool SetMeshData(std::string path, std::vector<Vertex> vertices,
+                   std::vector<uint32_t> face_indices,
+                   std::vector<uint32_t> face_offsets,
+                   std::vector<Edge> edges = {});
+
   /**
    * @brief Возвращает последний код ошибки.
    *
@@ -124,9 +398,20 @@ class Model {
   /**
    * @brief Возвращает изменяемый вектор вершин.
    *
+   * Вызов помечает ограничивающий параллелепипед устаревшим: он будет
+   * пересчитан при следующем обращении к GetBoundingBox(), а AABB узлов
+   * иерархии - при обращении к GetBvh(). Рёбра от положения вершин не
+   * зависят и остаются в кэше.
+   *
    * @return Ссылка на вектор вершин.
    */
-  std::vector<Vertex>& GetMutableVertices() { return vertices_; }
+  std::vector<Vertex>& GetMutableVertices() {
+    bounds_dirty_ = true;
+    bvh_refit_ = true;
+    surface_dirty_ = true;
+    ReleaseSourceVertices();
+    return vertices_;
+  }
 
   /**
    * @brief Возвращает константный вектор вершин.
@@ -136,11 +421,25 @@ class Model {
   const std::vector<Vertex>& GetVertices() const { return vertices_; }
 
   /**
-   * @brief Возвращает константный вектор полигонов.
+   * @brief Возвращает список полигонов.
    *
-   * @return Константная ссылка на вектор полигонов.
+   * @return Представление полигонов поверх массивов индексов и смещений.
    */
-  const std::vector<Polygon>& GetPolygons() const { return polygons_; }
+  PolygonList GetPolygons() const { return {face_indices_, face_offsets_}; }
+
+  /**
+   * @brief Возвращает общий массив индексов вершин всех полигонов.
+   *
+   * @return Константная ссылка на массив индексов (формат CSR).
+   */
+  const std::vector<uint32_t>& GetFaceIndices() const { return face_indices_; }
+
+  /**
+   * @brief Возвращает массив смещений полигонов в GetFaceIndices().
+   *
+   * @return Пустой массив или массив размером GetPolygonCount() + 1.
+   */
+  const std::vector<uint32_t>& GetFaceOffsets() const { return face_offsets_; }
 
   /**
    * @brief Возвращает количество вершин в модели.
@@ -152,9 +451,11 @@ class Model {
   /**
    * @brief Возвращает количество полигонов в модели.
    *
-   * @return Размер вектора полигонов.
+   * @return Количество полигонов.
    */
-  size_t GetPolygonCount() const { return polygons_.size(); }
+  size_t GetPolygonCount() const {
+    return face_offsets_.empty() ? 0 : face_offsets_.size() - 1;
+  }
 
   /**
    * @brief Возвращает количество рёбер в модели.
@@ -165,14 +466,94 @@ class Model {
    */
   size_t GetEdgeCount() const { return GetEdges().size(); }
 
+  /**
+   * @brief Проверяет, загружена ли модель без полигонов (LoadMode::kEdgesOnly).
+   *
+   * @return true если рёбра есть, а массивы полигонов пусты.
+   */
+  bool IsEdgesOnly() const {
+    return face_offsets_.empty() && !GetEdges().empty();
+  }
+
   /**
    * @brief Возвращает список рёбер модели.
    *
-   * Каждое ребро представлено парой индексов вершин.
+   * Каждое ребро представлено парой индексов вершин. Список хранится в кэше и
+   * перестраивается только после изменения полигонов (при загрузке).
+   *
+   * @return Константная ссылка на вектор рёбер, упорядоченных по возрастанию.
+   */
+  const std::vector<Edge>& GetEdges() const {
+    if (edges_dirty_) ExtractEdges();
+    return edges_;
+  }
+  /**
+   * @brief Проверяет, построена ли поверхность для заливки.
+   *
+   * Поверхность строится при загрузке с LoadOptions::attributes.
+   */
+  bool HasSurface() const { return !surface_triangles_.empty(); }
+
+  /**
+   * @brief Возвращает вершины поверхности для заливки.
+   *
+   * Каждая уникальная тройка v/vt/vn файла - одна вершина. Позиции
+   * обновляются из вершин модели при первом обращении после их изменения;
+   * нормали поворачиваются вместе с вершинами (TransformVertices,
+   * SetVertexTransform), но не после GetMutableVertices().
+   *
+   * @return Вершины (пустой массив, если поверхности нет).
+   */
+  const std::vector<SurfaceVertex>& GetSurfaceVertices() const {
+    if (surface_dirty_) UpdateSurfacePositions();
+    return surface_vertices_;
+  }
+
+  /**
+   * @brief Возвращает индексы треугольников поверхности.
+   *
+   * Многоугольники разбиты веером от первой вершины; индексы указывают в
+   * GetSurfaceVertices() (буфер GL_TRIANGLES).
+   */
+  const std::vector<uint32_t>& GetSurfaceTriangles() const {
+    return surface_triangles_;
+  }
+
+  /**
+   * @brief Возвращает ограничивающий параллелепипед модели.
+   *
+   * Хранится в кэше; пересчитывается, только если вершины менялись через
+   * GetMutableVertices().
+   *
+   * @return Константная ссылка на AABB (нулевой, если вершин нет).
+   */
+  const BoundingBox& GetBoundingBox() const {
+    if (bounds_dirty_) ComputeBoundingBox();
+    return bounds_;
+  }
+
+  /**
+   * @brief Возвращает иерархию AABB над рёбрами модели (см. bvh.hpp).
+   *
+   * Строится при первом обращении после загрузки; после изменения вершин
+   * через GetMutableVertices() или TransformVertices() с поворотом AABB
+   * узлов пересчитываются (без перестроения). Ссылка остаётся
+   * действительной, пока жива модель.
+   *
+   * @return Константная ссылка на иерархию (пустую, если рёбер нет).
+   */
+  const Bvh& GetBvh() const;
+
+  /**
+   * @brief Возвращает объём памяти, занятый массивами модели.
+   *
+   * Учитываются вершины (и их исходная копия, см. SetVertexTransform),
+   * полигоны, кэш рёбер и иерархия рёбер, если она построена (по ёмкости
+   * векторов).
    *
-   * @return Вектор пар индексов вершин.
+   * @return Размер в байтах.
    */
-  std::vector<std::pair<size_t, size_t>> GetEdges() const;
+  size_t GetMemoryUsage() const;
 
   /**
    * @brief Возвращает путь к файлу модели.
@@ -199,13 +580,157 @@ class Model {
    */
   void NormalizeModel();
 
+  /**
+   * @brief Применяет преобразование к вершинам модели.
+   *
+   * Использует векторизованные ядра (см. transform_kernels.hpp) и помечает
+   * ограничивающий параллелепипед устаревшим. Уже построенная иерархия
+   * AABB при переносе и масштабировании обновляется сразу по узлам, при
+   * повороте - помечается для пересчёта.
+   *
+   * @param transform Матрица преобразования.
+   */
+  void TransformVertices(const Matrix4& transform);
+
+  /**
+   * @brief Устанавливает вершины равными transform * исходные вершины.
+   *
+   * При первом вызове текущие вершины сохраняются как исходные; следующие
+   * вызовы считают результат от них, а не от уже преобразованных вершин,
+   * поэтому погрешность не накапливается. Единичная матрица возвращает
+   * исходные вершины точно и освобождает копию. Копия сбрасывается при
+   * любом другом изменении вершин (TransformVertices, GetMutableVertices,
+   * загрузка).
+   *
+   * @param transform Абсолютное преобразование исходных вершин.
+   */
+  void SetVertexTransform(const Matrix4& transform);
+
+  /// Допуск слияния вершин по умолчанию: тот же, что у Vertex::operator==
+  static constexpr float kWeldTolerance = 1e-6f;
+
+  /**
+   * @brief Сливает вершины, совпадающие с точностью до tolerance.
+   *
+   * Вершины раскладываются по пространственной хэш-сетке с ячейкой
+   * 8 * tolerance, поэтому каждая сравнивается только с вершинами своей
+   * ячейки и тех соседних, к границе которых она ближе tolerance, и проход
+   * линеен по числу вершин. Из группы совпадающих
+   * остаётся первая по порядку; индексы полигонов и рёбер переназначаются,
+   * а полигоны, в которых осталось меньше трёх разных вершин, удаляются.
+   * Порядок оставшихся вершин сохраняется.
+   *
+   * @param tolerance Наибольшая разница по каждой координате.
+   * @return Сколько вершин, рёбер и полигонов удалено; то же возвращает
+   * GetWeldStats().
+   */
+  WeldStats WeldVertices(float tolerance = kWeldTolerance);
+
+  /**
+   * @brief Возвращает итоги последнего слияния вершин.
+   *
+   * Сбрасывается при загрузке; после загрузки с LoadOptions::weld содержит
+   * её результат.
+   */
+  const WeldStats& GetWeldStats() const { return weld_stats_; }
+
+  /**
+   * @brief Устанавливает параметры выполнения операций над вершинами.
+   *
+   * @param policy Новые параметры.
+   */
+  void SetExecutionPolicy(const ExecutionPolicy& policy) { policy_ = policy; }
+
+  /**
+   * @brief Возвращает параметры выполнения операций над вершинами.
+   */
+  const ExecutionPolicy& GetExecutionPolicy() const { return policy_; }
+
+  // --- Отложенное преобразование ---
+
+  /**
+   * @brief Возвращает накопленную матрицу преобразования модели.
+   *
+   * Матрица ещё не применена к вершинам: её применяет рендерер при отрисовке.
+   *
+   * @return Константная ссылка на матрицу (единичную сразу после загрузки).
+   */
+  const Matrix4& GetTransform() const { return transform_; }
+
+  /**
+   * @brief Добавляет преобразование к накопленной матрице.
+   *
+   * Стоимость не зависит от числа вершин: вершины не изменяются до вызова
+   * BakeTransform().
+   *
+   * @param transform Преобразование, применяемое после уже накопленных.
+   */
+  void ApplyTransform(const Matrix4& transform) {
+    transform_ = transform * transform_;
+  }
+
+  /**
+   * @brief Заменяет накопленную матрицу абсолютным преобразованием.
+   *
+   * @param transform Новая матрица модели.
+   */
+  void SetTransform(const Matrix4& transform) { transform_ = transform; }
+
+  /**
+   * @brief Применяет накопленную матрицу к вершинам и сбрасывает её.
+   *
+   * Вызывается, когда нужны итоговые координаты вершин (например, перед
+   * экспортом модели).
+   */
+  void BakeTransform();
+
  private:
   std::string path_file_;         ///< Путь к файлу модели
   std::vector<Vertex> vertices_;  ///< Список вершин модели
-  std::vector<Polygon> polygons_;  ///< Список полигонов модели
+  std::vector<uint32_t> face_indices_;  ///< Индексы вершин всех полигонов
+  std::vector<uint32_t> face_offsets_;  ///< Начало каждого полигона (CSR)
+
+  // --- Кэш производных данных ---
+  mutable std::vector<Edge> edges_;   ///< Уникальные рёбра модели
+  mutable bool edges_dirty_ = true;   ///< Рёбра требуют пересчёта
+  mutable BoundingBox bounds_;        ///< Ограничивающий параллелепипед
+  mutable bool bounds_dirty_ = true;  ///< AABB требует пересчёта
+  mutable std::unique_ptr<Bvh> bvh_;  ///< Иерархия AABB над рёбрами
+  mutable bool bvh_dirty_ = true;     ///< Иерархию нужно построить заново
+  mutable bool bvh_refit_ = false;    ///< AABB узлов нужно пересчитать
+  Matrix4 transform_;  ///< Не применённое к вершинам преобразование
+  std::vector<Vertex> source_vertices_;  ///< Вершины до SetVertexTransform
+  std::vector<Vertex> source_normals_;  ///< Нормали поверхности до него же
+
+  // --- Поверхность для заливки (LoadOptions::attributes) ---
+  mutable std::vector<SurfaceVertex> surface_vertices_;  ///< Вершины
+  std::vector<uint32_t> surface_positions_;  ///< Вершина модели для каждой
+  std::vector<uint32_t> surface_triangles_;  ///< Индексы треугольников
+  mutable bool surface_dirty_ = false;  ///< Позиции требуют обновления
+  ExecutionPolicy policy_;  ///< Параметры обработки вершин
+  WeldStats weld_stats_;  ///< Итоги последнего WeldVertices()
+
   ErrorCode last_error_ = ErrorCode::kSuccess;  ///< Последняя ошибка
   std::string last_error_str_;  ///< Строка с описанием ошибки
 
+  /**
+   * @brief Освобождает исходную копию вершин (см. SetVertexTransform).
+   */
+  void ReleaseSourceVertices() {
+    std::vector<Vertex>().swap(source_vertices_);
+    std::vector<Vertex>().swap(source_normals_);
+  }
+
+  /**
+   * @brief Удаляет поверхность для заливки.
+   */
+  void ClearSurface() {
+    std::vector<SurfaceVertex>().swap(surface_vertices_);
+    std::vector<uint32_t>().swap(surface_positions_);
+    std::vector<uint32_t>().swap(surface_triangles_);
+    surface_dirty_ = false;
+  }
+
   /**
    * @brief Очищает информацию об ошибках.
    */
@@ -225,21 +750,147 @@ class Model {
     last_error_str_ = message;
   }
 
+  struct Chunk;
+  struct LoadContext;
+  struct FaceAttributes;
+
+  /**
+   * @enum ParsePass
+   * @brief Какие записи разбираются при проходе по куску файла.
+   */
+  enum class ParsePass {
+    kAll,       ///< Вершины и полигоны за один проход
+    kVertices,  ///< Только вершины
+    kPolygons   ///< Только полигоны (вершины уже разобраны)
+  };
+
+  /**
+   * @brief Делит содержимое файла на куски по границам строк.
+   *
+   * @param text Содержимое файла.
+   * @param options Параметры загрузки.
+   * @return Куски в порядке следования в файле (хотя бы один).
+   */
+  static std::vector<Chunk> SplitIntoChunks(std::string_view text,
+                                            const LoadOptions& options);
+
+  /**
+   * @brief Разбирает строки одного куска файла.
+   *
+   * Периодически сообщает о прогрессе и прекращает разбор, если загрузка
+   * отменена.
+   *
+   * @param chunk Кусок файла, сюда же складываются результаты.
+   * @param pass Какие записи разбирать.
+   * @param context Общее состояние загрузки (прогресс и отмена).
+   */
+  static void ParseChunk(Chunk& chunk, ParsePass pass, LoadContext& context);
+
+  /**
+   * @brief Объединяет результаты кусков в vertices_ и массивы полигонов.
+   *
+   * @param chunks Разобранные куски в порядке файла.
+   * @param has_valid_data Сюда записывается, были ли хотя бы в одном куске
+   * корректные данные.
+   * @return false если индексов полигонов больше, чем помещается в uint32_t
+   * (ошибка уже установлена).
+   */
+  bool MergeChunks(std::vector<Chunk>& chunks, bool& has_valid_data);
+
+  /**
+   * @brief Строит список уникальных рёбер по полигонам.
+   *
+   * Каждое ребро упаковывается в 64-битный ключ (min << 32 | max) в плоском
+   * буфере, ключи сортируются поразрядно (ParallelRadixSort) и из них
+   * удаляются повторы.
+   */
+  void ExtractEdges() const;
+
+  /**
+   * @brief Собирает рёбра из ключей, накопленных кусками в режиме
+   * LoadMode::kEdgesOnly.
+   *
+   * Ключи кусков переносятся в общий буфер по одному, освобождая память
+   * куска сразу после переноса.
+   *
+   * @param chunks Разобранные куски.
+   */
+  void MergeEdgeKeys(std::vector<Chunk>& chunks);
+
+  /**
+   * @brief Строит поверхность для заливки по атрибутам углов полигонов.
+   *
+   * Одинаковые тройки v/vt/vn объединяются через хэш-таблицу, полигоны
+   * разбиваются на треугольники веером. Вызывается после MergeChunks().
+   *
+   * @param chunks Разобранные куски; их атрибуты освобождаются.
+   */
+  void BuildSurface(std::vector<Chunk>& chunks);
+
+  /**
+   * @brief Копирует позиции вершин модели в вершины поверхности.
+   */
+  void UpdateSurfacePositions() const;
+
+  /**
+   * @brief Поворачивает нормали поверхности вместе с вершинами.
+   *
+   * @param transform Преобразование вершин.
+   * @param source Исходные нормали (nullptr - текущие).
+   */
+  void TransformSurfaceNormals(const Matrix4& transform,
+                               const std::vector<Vertex>* source);
+
+  /**
+   * @brief Заполняет edges_ из отсортированных уникальных ключей рёбер.
+   *
+   * @param keys Ключи (min << 32 | max); буфер освобождается.
+   */
+  void SetEdgesFromKeys(std::vector<uint64_t>& keys) const;
+
+  /**
+   * @brief Пересчитывает ограничивающий параллелепипед по вершинам.
+   *
+   * Для больших моделей min/max считаются по блокам параллельно и затем
+   * объединяются.
+   */
+  void ComputeBoundingBox() const;
+
   /**
    * @brief Парсит строку с данными вершины.
    *
    * @param line Строка из файла .obj, начинающаяся с 'v'.
-   * @return true если парсинг успешен.
+   * @return Прочитанная вершина.
+   * @throws std::runtime_error если формат вершины некорректен.
    */
-  bool ParseVertex(const std::string& line);
+  static Vertex ParseVertex(std::string_view line);
 
   /**
    * @brief Парсит строку с данными полигонов.
    *
+   * Индексы вершин дописываются в конец out. Невалидный полигон (или строка
+   * с ошибкой) не оставляет в out никаких данных.
+   *
    * @param line Строка из файла .obj, начинающаяся с 'f'.
-   * @return true если парсинг успешен.
+   * @param vertex_count Количество вершин, объявленных выше этой строки.
+   * @param out Массив индексов, в который добавляется полигон.
+   * @param attributes Куда дописать индексы vt и vn каждого угла
+   * (nullptr - отбросить их).
+   * @return true если полигон валиден и добавлен.
+   * @throws std::runtime_error если индекс вершины некорректен.
+   */
+  static bool ParsePolygon(std::string_view line, size_t vertex_count,
+                           std::vector<uint32_t>& out,
+                           FaceAttributes* attributes = nullptr);
+
+  /**
+   * @brief Раскладывает только что разобранный полигон куска на ключи рёбер
+   * и убирает его индексы (LoadMode::kEdgesOnly).
+   *
+   * @param chunk Кусок файла.
+   * @param start Начало полигона в chunk.face_indices.
    */
-  bool ParsePolygon(const std::string& line);
+  static void AppendEdgeKeys(Chunk& chunk, size_t start);
 };
 
 }  // namespace s21
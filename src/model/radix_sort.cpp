@@ -0,0 +1,89 @@
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "thread_pool.hpp"
+
+namespace s21 {
+
+namespace {
+
+constexpr int kDigitBits = 8;
+constexpr size_t kBuckets = size_t{1} << kDigitBits;
+/// Меньше этого числа ключей на блок распараллеливание не окупается
+constexpr size_t kMinBlockSize = size_t{1} << 16;
+/// Небольшие массивы быстрее сортировать сравнением
+constexpr size_t kSmallSortSize = 256;
+
+using Histogram = std::array<size_t, kBuckets>;
+
+}  // namespace
+
+void ParallelRadixSort(std::vector<uint64_t>& keys) {
+  const size_t n = keys.size();
+  if (n < kSmallSortSize) {
+    std::sort(keys.begin(), keys.end());
+    return;
+  }
+
+  auto& pool = ThreadPool::GetInstance();
+  const size_t blocks =
+      std::clamp<size_t>(n / kMinBlockSize, 1, pool.GetThreadCount() * 2);
+  const size_t block_size = (n + blocks - 1) / blocks;
+
+  // Разряды, в которых ключи различаются
+  uint64_t diff_bits = 0;
+  const uint64_t first = keys[0];
+  for (uint64_t key : keys) diff_bits |= key ^ first;
+
+  std::vector<uint64_t> buffer(n);
+  std::vector<Histogram> histograms(blocks);
+  uint64_t* src = keys.data();
+  uint64_t* dst = buffer.data();
+
+  for (int shift = 0; shift < 64; shift += kDigitBits) {
+    if (((diff_bits >> shift) & (kBuckets - 1)) == 0) continue;
+
+    pool.ParallelFor(blocks, [&](size_t b) {
+      Histogram& hist = histograms[b];
+      hist.fill(0);
+      const size_t end = std::min(n, (b + 1) * block_size);
+      for (size_t i = b * block_size; i < end; ++i) {
+        ++hist[(src[i] >> shift) & (kBuckets - 1)];
+      }
+    });
+
+    // Превращаем гистограммы в позиции записи: корзина за корзиной,
+    // внутри корзины - блоки по порядку (сортировка остаётся устойчивой)
+    size_t offset = 0;
+    for (size_t digit = 0; digit < kBuckets; ++digit) {
+      for (size_t b = 0; b < blocks; ++b) {
+        size_t count = histograms[b][digit];
+        histograms[b][digit] = offset;
+        offset += count;
+      }
+    }
+
+    pool.ParallelFor(blocks, [&](size_t b) {
+      Histogram& pos = histograms[b];
+      const size_t end = std::min(n, (b + 1) * block_size);
+      for (size_t i = b * block_size; i < end; ++i) {
+        dst[pos[(src[i] >> shift) & (kBuckets - 1)]++] = src[i];
+      }
+    });
+
+    std::swap(src, dst);
+  }
+
+  if (src != keys.data()) {
+    keys.swap(buffer);
+  }
+}
+
+void SortUnique(std::vector<uint64_t>& keys) {
+  ParallelRadixSort(keys);
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+}  // namespace s21
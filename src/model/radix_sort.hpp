@@ -0,0 +1,43 @@
+/**
+ * @file radix_sort.hpp
+ * @brief Параллельная поразрядная сортировка 64-битных ключей.
+ *
+ * Используется для выделения уникальных рёбер модели: каждое ребро
+ * упаковывается в один 64-битный ключ, ключи сортируются и из них удаляются
+ * повторы.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Сортирует ключи по возрастанию (LSD radix sort, разряд - 8 бит).
+ *
+ * Гистограммы и раскладка по корзинам считаются блоками в ThreadPool.
+ * Разряды, одинаковые у всех ключей, пропускаются, поэтому число проходов
+ * зависит от реального диапазона ключей, а не от их ширины.
+ *
+ * @param keys Сортируемые ключи.
+ */
+void ParallelRadixSort(std::vector<uint64_t>& keys);
+
+/**
+ * @brief Сортирует ключи и удаляет повторы.
+ *
+ * @param keys Ключи; после вызова содержит только уникальные значения
+ * в порядке возрастания.
+ */
+void SortUnique(std::vector<uint64_t>& keys);
+
+}  // namespace s21
+
+#endif  // RADIX_SORT_HPP
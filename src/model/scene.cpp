@@ -0,0 +1,71 @@
+#include "scene.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace s21 {
+
+void Scene::SetInstanceCount(const Model* model, uint32_t count) {
+  if (!model) return;
+  count = std::min(count, kMaxInstances);
+
+  auto it = std::find_if(
+      models_.begin(), models_.end(),
+      [model](const SceneModel& entry) { return entry.model == model; });
+  if (count == 0) {
+    if (it == models_.end()) return;
+    models_.erase(it);
+  } else if (it == models_.end()) {
+    models_.push_back({model, std::vector<Matrix4>(count), next_id_++});
+  } else if (it->instances.size() != count) {
+    it->instances.resize(count);
+  } else {
+    return;
+  }
+  Layout();
+  ++version_;
+}
+
+uint32_t Scene::GetInstanceCount(const Model* model) const {
+  const SceneModel* entry = Find(model);
+  return entry ? static_cast<uint32_t>(entry->instances.size()) : 0;
+}
+
+size_t Scene::GetTotalInstances() const {
+  size_t total = 0;
+  for (const SceneModel& entry : models_) total += entry.instances.size();
+  return total;
+}
+
+const SceneModel* Scene::Find(const Model* model) const {
+  for (const SceneModel& entry : models_) {
+    if (entry.model == model) return &entry;
+  }
+  return nullptr;
+}
+
+void Scene::Layout() {
+  const size_t total = GetTotalInstances();
+  if (total == 0) return;
+
+  // Квадратная сетка side x side из ячеек 2 * kCellSpacing, сжатая в [-1, 1]
+  const auto side = static_cast<size_t>(std::ceil(std::sqrt(total)));
+  const float scale = 1.0f / (static_cast<float>(side) * kCellSpacing);
+  const float cell = 2.0f * kCellSpacing * scale;
+  const float origin = (static_cast<float>(side) - 1.0f) * cell / 2.0f;
+
+  size_t index = 0;
+  for (SceneModel& entry : models_) {
+    for (Matrix4& instance : entry.instances) {
+      const auto column = static_cast<float>(index % side);
+      const auto row = static_cast<float>(index / side);
+      // Первая строка сетки - сверху
+      instance = Matrix4::Translation(column * cell - origin,
+                                      origin - row * cell, 0.0f) *
+                 Matrix4::Scale(scale);
+      ++index;
+    }
+  }
+}
+
+}  // namespace s21
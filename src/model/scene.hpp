@@ -0,0 +1,131 @@
+/**
+ * @file scene.hpp
+ * @brief Сцена из нескольких моделей и экземпляров одной модели.
+ *
+ * Сцена не владеет моделями и не копирует их данные: каждая модель сцены
+ * загружается в видеопамять один раз, а её экземпляры отличаются только
+ * матрицей расположения. Рендерер рисует все экземпляры модели одним
+ * вызовом отрисовки с матрицами в отдельном буфере.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "model.hpp"
+
+namespace s21 {
+
+/**
+ * @struct SceneModel
+ * @brief Модель сцены и расположение её экземпляров.
+ */
+struct SceneModel {
+  const Model* model = nullptr;     ///< Модель (принадлежит ModelManager)
+  std::vector<Matrix4> instances;  ///< Матрицы расположения экземпляров
+  uint64_t id = 0;  ///< Номер записи: новый при каждом добавлении модели
+};
+
+/**
+ * @class Scene
+ * @brief Модели сцены, разложенные по сетке.
+ *
+ * Экземпляры всех моделей по порядку добавления занимают ячейки квадратной
+ * сетки, вписанной в куб [-1, 1] (как нормализованная модель). Итоговое
+ * преобразование вершины экземпляра - instances[i] * model->GetTransform(),
+ * так что команды трансформации текущей модели двигают модель внутри
+ * каждой её ячейки.
+ */
+class Scene {
+ public:
+  /// Размер ячейки сетки относительно модели (зазор между экземплярами)
+  static constexpr float kCellSpacing = 1.1f;
+
+  /// Наибольшее число экземпляров одной модели
+  static constexpr uint32_t kMaxInstances = 4096;
+
+  /**
+   * @brief Добавляет модель в сцену или меняет число её экземпляров.
+   *
+   * @param model Модель; должна оставаться в памяти, пока она в сцене.
+   * @param count Число экземпляров (не больше kMaxInstances; 0 - удалить).
+   */
+  void SetInstanceCount(const Model* model, uint32_t count);
+
+  /**
+   * @brief Возвращает число экземпляров модели (0 - модели нет в сцене).
+   */
+  uint32_t GetInstanceCount(const Model* model) const;
+
+  /**
+   * @brief Удаляет модель из сцены.
+   *
+   * Вызывается до того, как модель будет удалена из памяти.
+   */
+  void Remove(const Model* model) { SetInstanceCount(model, 0); }
+
+  /**
+   * @brief Удаляет все модели.
+   */
+  void Clear() {
+    if (models_.empty()) return;
+    models_.clear();
+    ++version_;
+  }
+
+  /**
+   * @brief Проверяет, содержит ли сцена модель.
+   */
+  bool Contains(const Model* model) const { return Find(model) != nullptr; }
+
+  /**
+   * @brief Проверяет, пуста ли сцена.
+   */
+  bool IsEmpty() const { return models_.empty(); }
+
+  /**
+   * @brief Возвращает модели сцены в порядке добавления.
+   */
+  const std::vector<SceneModel>& GetModels() const { return models_; }
+
+  /**
+   * @brief Возвращает суммарное число экземпляров всех моделей.
+   */
+  size_t GetTotalInstances() const;
+
+  /**
+   * @brief Возвращает номер изменения сцены.
+   *
+   * Растёт при каждом изменении состава сцены или расположения экземпляров,
+   * поэтому рендерер может сравнивать его с загруженным в видеопамять.
+   */
+  uint64_t GetVersion() const { return version_; }
+
+ private:
+  std::vector<SceneModel> models_;  ///< Модели в порядке добавления
+  uint64_t next_id_ = 1;            ///< Номер следующей записи
+  uint64_t version_ = 0;            ///< Номер изменения
+
+  /**
+   * @brief Ищет модель в сцене.
+   *
+   * @return Запись модели или nullptr.
+   */
+  const SceneModel* Find(const Model* model) const;
+
+  /**
+   * @brief Пересчитывает матрицы всех экземпляров после изменения состава.
+   */
+  void Layout();
+};
+
+}  // namespace s21
+
+#endif  // SCENE_HPP
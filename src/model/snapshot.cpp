@@ -0,0 +1,21 @@
+#include "snapshot.hpp"
+
+namespace s21 {
+
+void SnapshotBuffer::Publish() {
+  slots_[back_].version = ++version_;
+  // release: читатель, получивший снимок, видит его целиком; acquire:
+  // полученный обратно снимок читатель больше не читает
+  const auto fresh = static_cast<uint8_t>(back_ | kFresh);
+  const uint8_t previous = middle_.exchange(fresh, std::memory_order_acq_rel);
+  back_ = previous & kIndex;
+}
+
+const GeometrySnapshot* SnapshotBuffer::Consume() {
+  if (!(middle_.load(std::memory_order_relaxed) & kFresh)) return nullptr;
+  const uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+  front_ = previous & kIndex;
+  return &slots_[front_];
+}
+
+}  // namespace s21
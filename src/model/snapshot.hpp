@@ -0,0 +1,95 @@
+/**
+ * @file snapshot.hpp
+ * @brief Снимки вершин модели для передачи между потоками без блокировок.
+ *
+ * Поток, который меняет вершины (например, VertexBaker), записывает
+ * результат в снимок и публикует его; поток отрисовки забирает последний
+ * опубликованный снимок. Снимков три (тройная буферизация): один
+ * заполняется, один отдан отрисовке, один ждёт между ними, поэтому ни одна
+ * сторона не ждёт другую и не видит недописанных данных.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "model.hpp"
+
+namespace s21 {
+
+/**
+ * @struct GeometrySnapshot
+ * @brief Неизменяемая после публикации копия вершин модели.
+ */
+struct GeometrySnapshot {
+  uint64_t version = 0;          ///< Номер публикации, с 1
+  std::vector<Vertex> vertices;  ///< Вершины
+};
+
+/**
+ * @class SnapshotBuffer
+ * @brief Тройной буфер снимков: один писатель, один читатель.
+ *
+ * Писатель заполняет GetBack() и вызывает Publish(); читатель вызывает
+ * Consume() и читает полученный снимок до следующего Consume(). Обмен
+ * снимками - одна атомарная операция, без мьютексов и выделения памяти:
+ * массивы снимков переиспользуются, и при неизменном числе вершин
+ * публикация не выделяет память.
+ */
+class SnapshotBuffer {
+ public:
+  /**
+   * @brief Возвращает снимок, который заполняет писатель.
+   *
+   * Читатель к нему не обращается до Publish().
+   */
+  GeometrySnapshot& GetBack() { return slots_[back_]; }
+
+  /**
+   * @brief Публикует заполненный снимок.
+   *
+   * Снимок, опубликованный раньше и ещё не забранный читателем, заменяется
+   * (читателю нужен только последний). Вызывается только писателем.
+   */
+  void Publish();
+
+  /**
+   * @brief Забирает последний опубликованный снимок.
+   *
+   * Вызывается только читателем. Предыдущий снимок, полученный отсюда,
+   * после вызова может перезаписываться писателем.
+   *
+   * @return Новый снимок или nullptr, если после прошлого вызова ничего не
+   * публиковалось.
+   */
+  const GeometrySnapshot* Consume();
+
+  /**
+   * @brief Проверяет, есть ли снимок, ещё не забранный читателем.
+   */
+  bool HasPending() const {
+    return middle_.load(std::memory_order_acquire) & kFresh;
+  }
+
+ private:
+  static constexpr uint8_t kIndex = 0x3;  ///< Номер снимка в middle_
+  static constexpr uint8_t kFresh = 0x4;  ///< В middle_ новый снимок
+
+  std::array<GeometrySnapshot, 3> slots_;  ///< Снимки
+  uint8_t back_ = 0;   ///< Снимок писателя
+  uint8_t front_ = 2;  ///< Снимок читателя
+  std::atomic<uint8_t> middle_{1};  ///< Снимок между ними и флаг kFresh
+  uint64_t version_ = 0;  ///< Номер последней публикации (у писателя)
+};
+
+}  // namespace s21
+
+#endif  // SNAPSHOT_HPP
@@ -0,0 +1,91 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace s21 {
+
+ThreadPool::ThreadPool() {
+  size_t hw = std::thread::hardware_concurrency();
+  size_t workers = hw > 1 ? hw - 1 : 0;
+  workers_.reserve(workers);
+  for (size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)>& task) {
+  if (count == 0) return;
+
+  if (workers_.empty() || count == 1) {
+    for (size_t i = 0; i < count; ++i) task(i);
+    return;
+  }
+
+  auto job = std::make_shared<Job>();
+  job->task = &task;
+  job->count = count;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(job);
+  }
+  work_cv_.notify_all();
+
+  RunJob(*job);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = std::find(jobs_.begin(), jobs_.end(), job);
+  if (it != jobs_.end()) jobs_.erase(it);
+  done_cv_.wait(lock, [&] { return job->done.load() == job->count; });
+  lock.unlock();
+
+  if (job->error) std::rethrow_exception(job->error);
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (stop_) return;
+
+      job = jobs_.front();
+      if (job->next.load() >= job->count) {
+        // Все индексы уже розданы, задача больше не нужна в очереди
+        jobs_.pop_front();
+        continue;
+      }
+    }
+    RunJob(*job);
+  }
+}
+
+void ThreadPool::RunJob(Job& job) {
+  size_t i = 0;
+  while ((i = job.next.fetch_add(1)) < job.count) {
+    try {
+      (*job.task)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job.error_mutex);
+      if (!job.error) job.error = std::current_exception();
+    }
+    if (job.done.fetch_add(1) + 1 == job.count) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace s21
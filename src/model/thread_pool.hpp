@@ -0,0 +1,108 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Заголовочный файл для класса ThreadPool - общего пула потоков.
+ *
+ * Пул используется для распараллеливания тяжёлых операций над моделью
+ * (разбор файла, обработка вершин). Реализует паттерн Singleton: все
+ * компоненты приложения разделяют один набор рабочих потоков.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @class ThreadPool
+ * @brief Пул рабочих потоков с операцией ParallelFor.
+ *
+ * Вызывающий поток участвует в выполнении своей задачи, поэтому вложенные
+ * вызовы ParallelFor и вызовы из нескольких потоков одновременно не приводят
+ * к взаимной блокировке. На одноядерной машине все задачи выполняются
+ * последовательно в вызывающем потоке.
+ */
+class ThreadPool {
+ public:
+  ThreadPool(const ThreadPool&) = delete;
+  void operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief Получает ссылку на единственный экземпляр пула.
+   *
+   * @return Ссылка на пул потоков.
+   */
+  static ThreadPool& GetInstance() {
+    static ThreadPool instance;
+    return instance;
+  }
+
+  /**
+   * @brief Возвращает число потоков, выполняющих задачи (включая вызывающий).
+   */
+  size_t GetThreadCount() const { return workers_.size() + 1; }
+
+  /**
+   * @brief Выполняет task(i) для всех i из [0, count) и ждёт завершения.
+   *
+   * Если одна из задач выбросила исключение, оно пробрасывается вызывающему
+   * после завершения остальных задач.
+   *
+   * @param count Количество задач.
+   * @param task Функция, выполняемая для каждого индекса.
+   */
+  void ParallelFor(size_t count, const std::function<void(size_t)>& task);
+
+ private:
+  /**
+   * @brief Описание одного вызова ParallelFor.
+   */
+  struct Job {
+    const std::function<void(size_t)>* task = nullptr;  ///< Выполняемая функция
+    size_t count = 0;                   ///< Количество индексов
+    std::atomic<size_t> next{0};        ///< Следующий невыданный индекс
+    std::atomic<size_t> done{0};        ///< Количество выполненных индексов
+    std::exception_ptr error;           ///< Первое пойманное исключение
+    std::mutex error_mutex;             ///< Защита error
+  };
+
+  ThreadPool();
+  ~ThreadPool();
+
+  /**
+   * @brief Основной цикл рабочего потока.
+   */
+  void WorkerLoop();
+
+  /**
+   * @brief Выполняет индексы задачи, пока они не закончатся.
+   *
+   * @param job Задача.
+   */
+  void RunJob(Job& job);
+
+  std::vector<std::thread> workers_;       ///< Рабочие потоки
+  std::deque<std::shared_ptr<Job>> jobs_;  ///< Очередь активных задач
+  std::mutex mutex_;                       ///< Защита очереди
+  std::condition_variable work_cv_;  ///< Сигнал о появлении задач
+  std::condition_variable done_cv_;  ///< Сигнал о завершении задач
+  bool stop_ = false;                ///< Флаг остановки пула
+};
+
+}  // namespace s21
+
+#endif  // THREAD_POOL_HPP
@@ -0,0 +1,105 @@
+#include "transform.hpp"
+
+#include <cmath>
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Матрица поворота в плоскости осей (a, b) на angle радиан.
+ *
+ * Повторяет RotatePair: a' = a*cos - b*sin, b' = a*sin + b*cos.
+ */
+Matrix4 PlaneRotation(int a, int b, float angle) {
+  Matrix4 r;
+  const float c = std::cos(angle);
+  const float s = std::sin(angle);
+  r(a, a) = c;
+  r(a, b) = -s;
+  r(b, a) = s;
+  r(b, b) = c;
+  return r;
+}
+
+}  // namespace
+
+Matrix4 Matrix4::Translation(float dx, float dy, float dz) {
+  Matrix4 r;
+  r(0, 3) = dx;
+  r(1, 3) = dy;
+  r(2, 3) = dz;
+  return r;
+}
+
+Matrix4 TransformState::ToMatrix() const {
+  return Matrix4::Translation(translate_x, translate_y, translate_z) *
+         Matrix4::Rotation(rotate_x, rotate_y, rotate_z) *
+         Matrix4::Scale(scale);
+}
+
+Matrix4 Matrix4::Scale(float factor) {
+  Matrix4 r;
+  r(0, 0) = factor;
+  r(1, 1) = factor;
+  r(2, 2) = factor;
+  return r;
+}
+
+Matrix4 Matrix4::Rotation(float angle_x, float angle_y, float angle_z) {
+  const float deg_to_rad = M_PI / 180.0f;
+  Matrix4 r;
+  if (angle_x != 0) r = PlaneRotation(1, 2, angle_x * deg_to_rad) * r;
+  if (angle_y != 0) r = PlaneRotation(2, 0, angle_y * deg_to_rad) * r;
+  if (angle_z != 0) r = PlaneRotation(0, 1, angle_z * deg_to_rad) * r;
+  return r;
+}
+
+Matrix4 Matrix4::operator*(const Matrix4& rhs) const {
+  Matrix4 r;
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      float sum = 0.0f;
+      for (int k = 0; k < 4; ++k) sum += (*this)(row, k) * rhs(k, col);
+      r(row, col) = sum;
+    }
+  }
+  return r;
+}
+
+Matrix4 Matrix4::AffineInverse() const {
+  const Matrix4& a = *this;
+  // Алгебраические дополнения верхнего блока 3x3
+  const float c00 = a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1);
+  const float c01 = a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2);
+  const float c02 = a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0);
+  const float det = a(0, 0) * c00 + a(0, 1) * c01 + a(0, 2) * c02;
+  if (det == 0.0f) return {};
+
+  const float inv = 1.0f / det;
+  Matrix4 r;
+  r(0, 0) = c00 * inv;
+  r(1, 0) = c01 * inv;
+  r(2, 0) = c02 * inv;
+  r(0, 1) = (a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2)) * inv;
+  r(1, 1) = (a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0)) * inv;
+  r(2, 1) = (a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1)) * inv;
+  r(0, 2) = (a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1)) * inv;
+  r(1, 2) = (a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2)) * inv;
+  r(2, 2) = (a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)) * inv;
+  // Перенос: -R^-1 * t
+  for (int row = 0; row < 3; ++row) {
+    r(row, 3) = -(r(row, 0) * a(0, 3) + r(row, 1) * a(1, 3) +
+                  r(row, 2) * a(2, 3));
+  }
+  return r;
+}
+
+void Matrix4::Apply(float& x, float& y, float& z) const {
+  const float px = x, py = y, pz = z;
+  x = m[0] * px + m[4] * py + m[8] * pz + m[12];
+  y = m[1] * px + m[5] * py + m[9] * pz + m[13];
+  z = m[2] * px + m[6] * py + m[10] * pz + m[14];
+}
+
+}  // namespace s21
@@ -0,0 +1,117 @@
+/**
+ * @file transform.hpp
+ * @brief Матрица аффинного преобразования 4x4.
+ *
+ * Команды трансформации могут не переписывать вершины модели, а накапливать
+ * преобразование в одной матрице, которую затем применяет рендерер.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef TRANSFORM_HPP
+#define TRANSFORM_HPP
+
+#include <array>
+
+namespace s21 {
+
+/**
+ * @struct Matrix4
+ * @brief Матрица 4x4 в порядке столбцов (как в OpenGL).
+ *
+ * Элемент (row, col) хранится в m[col * 4 + row], поэтому Data() можно
+ * передавать в glMultMatrixf/glUniformMatrix4fv без транспонирования.
+ */
+struct Matrix4 {
+  std::array<float, 16> m{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+  /**
+   * @brief Единичная матрица.
+   */
+  static Matrix4 Identity() { return {}; }
+
+  /**
+   * @brief Матрица переноса.
+   */
+  static Matrix4 Translation(float dx, float dy, float dz);
+
+  /**
+   * @brief Матрица равномерного масштабирования.
+   */
+  static Matrix4 Scale(float factor);
+
+  /**
+   * @brief Матрица поворота на углы в градусах.
+   *
+   * Повороты применяются в том же порядке, что и в RotateCommand:
+   * сначала вокруг X, затем вокруг Y, затем вокруг Z.
+   */
+  static Matrix4 Rotation(float angle_x, float angle_y, float angle_z);
+
+  /**
+   * @brief Доступ к элементу (row, col).
+   */
+  float& operator()(int row, int col) { return m[col * 4 + row]; }
+  float operator()(int row, int col) const { return m[col * 4 + row]; }
+
+  /**
+   * @brief Произведение матриц: сначала применяется rhs, затем *this.
+   */
+  Matrix4 operator*(const Matrix4& rhs) const;
+
+  /**
+   * @brief Обратное аффинное преобразование.
+   *
+   * Последняя строка матрицы считается равной (0, 0, 0, 1), как у всех
+   * матриц команд. Для вырожденной матрицы (масштаб 0) возвращает
+   * единичную.
+   */
+  Matrix4 AffineInverse() const;
+
+  /**
+   * @brief Применяет преобразование к точке.
+   */
+  void Apply(float& x, float& y, float& z) const;
+
+  /**
+   * @brief Проверяет, является ли матрица единичной.
+   */
+  bool IsIdentity() const { return m == Matrix4{}.m; }
+
+  /**
+   * @brief Указатель на 16 элементов в порядке столбцов.
+   */
+  const float* Data() const { return m.data(); }
+};
+
+/**
+ * @struct TransformState
+ * @brief Абсолютное положение модели: перенос, поворот и масштаб.
+ *
+ * В отличие от последовательности команд состояние не накапливает
+ * погрешность: матрица каждый раз строится из этих значений заново и
+ * применяется к исходным (нормализованным) вершинам.
+ */
+struct TransformState {
+  float translate_x = 0;  ///< Перенос по оси X
+  float translate_y = 0;  ///< Перенос по оси Y
+  float translate_z = 0;  ///< Перенос по оси Z
+  float rotate_x = 0;     ///< Поворот вокруг оси X в градусах
+  float rotate_y = 0;     ///< Поворот вокруг оси Y в градусах
+  float rotate_z = 0;     ///< Поворот вокруг оси Z в градусах
+  float scale = 1;        ///< Коэффициент масштабирования
+
+  /**
+   * @brief Строит матрицу: масштаб, затем поворот (как Matrix4::Rotation),
+   * затем перенос.
+   */
+  Matrix4 ToMatrix() const;
+
+  bool operator==(const TransformState& other) const = default;
+};
+
+}  // namespace s21
+
+#endif  // TRANSFORM_HPP
@@ -0,0 +1,242 @@
+#include "transform_kernels.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#define S21_KERNELS_SSE 1
+#if defined(__GNUC__) && defined(__x86_64__)
+#define S21_KERNELS_AVX2 1
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define S21_KERNELS_NEON 1
+#endif
+
+namespace s21 {
+
+namespace {
+
+using AosKernel = void (*)(float*, size_t, const Matrix4&);
+using SoaKernel = void (*)(float*, float*, float*, size_t, const Matrix4&);
+
+/**
+ * @brief Набор ядер для одного набора инструкций.
+ */
+struct Kernels {
+  AosKernel aos;
+  SoaKernel soa;
+  const char* name;
+};
+
+void TransformAosScalar(float* p, size_t count, const Matrix4& matrix) {
+  for (size_t i = 0; i < count; ++i, p += 3) {
+    matrix.Apply(p[0], p[1], p[2]);
+  }
+}
+
+void TransformSoaScalar(float* x, float* y, float* z, size_t count,
+                        const Matrix4& matrix) {
+  for (size_t i = 0; i < count; ++i) matrix.Apply(x[i], y[i], z[i]);
+}
+
+// Порядок сложения во всех ядрах тот же, что в Matrix4::Apply:
+// ((m0 * x + m4 * y) + m8 * z) + m12. Без FMA результаты совпадают побитово.
+
+#if defined(S21_KERNELS_SSE)
+
+inline __m128 RowSse(__m128 x, __m128 y, __m128 z, const float* m, int row) {
+  __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[row]), x),
+                        _mm_mul_ps(_mm_set1_ps(m[4 + row]), y));
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[8 + row]), z));
+  return _mm_add_ps(r, _mm_set1_ps(m[12 + row]));
+}
+
+void TransformAosSse(float* p, size_t count, const Matrix4& matrix) {
+  const float* m = matrix.Data();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4, p += 12) {
+    // [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] -> [x0..x3] [y0..y3] [z0..z3]
+    const __m128 a = _mm_loadu_ps(p);
+    const __m128 b = _mm_loadu_ps(p + 4);
+    const __m128 c = _mm_loadu_ps(p + 8);
+    const __m128 xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    const __m128 yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    const __m128 x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    const __m128 y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128 z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+    const __m128 rx = RowSse(x, y, z, m, 0);
+    const __m128 ry = RowSse(x, y, z, m, 1);
+    const __m128 rz = RowSse(x, y, z, m, 2);
+
+    // Обратная перестановка в формат x, y, z
+    const __m128 rxy = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 ryz = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 rzx = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_ps(p, _mm_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+  TransformAosScalar(p, count - i, matrix);
+}
+
+void TransformSoaSse(float* x, float* y, float* z, size_t count,
+                     const Matrix4& matrix) {
+  const float* m = matrix.Data();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 vx = _mm_loadu_ps(x + i);
+    const __m128 vy = _mm_loadu_ps(y + i);
+    const __m128 vz = _mm_loadu_ps(z + i);
+    _mm_storeu_ps(x + i, RowSse(vx, vy, vz, m, 0));
+    _mm_storeu_ps(y + i, RowSse(vx, vy, vz, m, 1));
+    _mm_storeu_ps(z + i, RowSse(vx, vy, vz, m, 2));
+  }
+  TransformSoaScalar(x + i, y + i, z + i, count - i, matrix);
+}
+
+#endif  // S21_KERNELS_SSE
+
+#if defined(S21_KERNELS_AVX2)
+
+__attribute__((target("avx2"))) inline __m256 RowAvx(__m256 x, __m256 y,
+                                                     __m256 z, const float* m,
+                                                     int row) {
+  __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[row]), x),
+                           _mm256_mul_ps(_mm256_set1_ps(m[4 + row]), y));
+  r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(m[8 + row]), z));
+  return _mm256_add_ps(r, _mm256_set1_ps(m[12 + row]));
+}
+
+__attribute__((target("avx2"))) void TransformAosAvx2(float* p, size_t count,
+                                                      const Matrix4& matrix) {
+  const float* m = matrix.Data();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8, p += 24) {
+    // Вершины 0-3 - в младших половинах регистров, 4-7 - в старших;
+    // дальше перестановки те же, что в SSE-ядре, внутри каждой половины
+    const __m256 a = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+    const __m256 b = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+    const __m256 c = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+    const __m256 xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    const __m256 yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    const __m256 x = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    const __m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m256 z = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+    const __m256 rx = RowAvx(x, y, z, m, 0);
+    const __m256 ry = RowAvx(x, y, z, m, 1);
+    const __m256 rz = RowAvx(x, y, z, m, 2);
+
+    const __m256 rxy = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 ryz = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m256 rzx = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m256 ra = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 rb = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m256 rc = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm_storeu_ps(p, _mm256_castps256_ps128(ra));
+    _mm_storeu_ps(p + 4, _mm256_castps256_ps128(rb));
+    _mm_storeu_ps(p + 8, _mm256_castps256_ps128(rc));
+    _mm_storeu_ps(p + 12, _mm256_extractf128_ps(ra, 1));
+    _mm_storeu_ps(p + 16, _mm256_extractf128_ps(rb, 1));
+    _mm_storeu_ps(p + 20, _mm256_extractf128_ps(rc, 1));
+  }
+  TransformAosSse(p, count - i, matrix);
+}
+
+__attribute__((target("avx2"))) void TransformSoaAvx2(float* x, float* y,
+                                                      float* z, size_t count,
+                                                      const Matrix4& matrix) {
+  const float* m = matrix.Data();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 vx = _mm256_loadu_ps(x + i);
+    const __m256 vy = _mm256_loadu_ps(y + i);
+    const __m256 vz = _mm256_loadu_ps(z + i);
+    _mm256_storeu_ps(x + i, RowAvx(vx, vy, vz, m, 0));
+    _mm256_storeu_ps(y + i, RowAvx(vx, vy, vz, m, 1));
+    _mm256_storeu_ps(z + i, RowAvx(vx, vy, vz, m, 2));
+  }
+  TransformSoaSse(x + i, y + i, z + i, count - i, matrix);
+}
+
+#endif  // S21_KERNELS_AVX2
+
+#if defined(S21_KERNELS_NEON)
+
+inline float32x4_t RowNeon(float32x4_t x, float32x4_t y, float32x4_t z,
+                           const float* m, int row) {
+  float32x4_t r = vaddq_f32(vmulq_n_f32(x, m[row]), vmulq_n_f32(y, m[4 + row]));
+  r = vaddq_f32(r, vmulq_n_f32(z, m[8 + row]));
+  return vaddq_f32(r, vdupq_n_f32(m[12 + row]));
+}
+
+void TransformAosNeon(float* p, size_t count, const Matrix4& matrix) {
+  const float* m = matrix.Data();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4, p += 12) {
+    // vld3q/vst3q сами разделяют и собирают координаты
+    const float32x4x3_t v = vld3q_f32(p);
+    float32x4x3_t r;
+    r.val[0] = RowNeon(v.val[0], v.val[1], v.val[2], m, 0);
+    r.val[1] = RowNeon(v.val[0], v.val[1], v.val[2], m, 1);
+    r.val[2] = RowNeon(v.val[0], v.val[1], v.val[2], m, 2);
+    vst3q_f32(p, r);
+  }
+  TransformAosScalar(p, count - i, matrix);
+}
+
+void TransformSoaNeon(float* x, float* y, float* z, size_t count,
+                      const Matrix4& matrix) {
+  const float* m = matrix.Data();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float32x4_t vx = vld1q_f32(x + i);
+    const float32x4_t vy = vld1q_f32(y + i);
+    const float32x4_t vz = vld1q_f32(z + i);
+    vst1q_f32(x + i, RowNeon(vx, vy, vz, m, 0));
+    vst1q_f32(y + i, RowNeon(vx, vy, vz, m, 1));
+    vst1q_f32(z + i, RowNeon(vx, vy, vz, m, 2));
+  }
+  TransformSoaScalar(x + i, y + i, z + i, count - i, matrix);
+}
+
+#endif  // S21_KERNELS_NEON
+
+/**
+ * @brief Выбирает ядра по возможностям процессора (один раз).
+ */
+const Kernels& SelectKernels() {
+  static const Kernels kernels = [] {
+#if defined(S21_KERNELS_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+      return Kernels{TransformAosAvx2, TransformSoaAvx2, "avx2"};
+    }
+#endif
+#if defined(S21_KERNELS_SSE)
+    return Kernels{TransformAosSse, TransformSoaSse, "sse"};
+#elif defined(S21_KERNELS_NEON)
+    return Kernels{TransformAosNeon, TransformSoaNeon, "neon"};
+#else
+    return Kernels{TransformAosScalar, TransformSoaScalar, "scalar"};
+#endif
+  }();
+  return kernels;
+}
+
+}  // namespace
+
+void TransformPoints(float* xyz, size_t count, const Matrix4& matrix) {
+  SelectKernels().aos(xyz, count, matrix);
+}
+
+void TransformPoints(float* x, float* y, float* z, size_t count,
+                     const Matrix4& matrix) {
+  SelectKernels().soa(x, y, z, count, matrix);
+}
+
+const char* TransformKernelName() { return SelectKernels().name; }
+
+}  // namespace s21
@@ -0,0 +1,58 @@
+/**
+ * @file transform_kernels.hpp
+ * @brief Векторизованное применение матрицы преобразования к массивам точек.
+ *
+ * Ядра принимают уже собранную матрицу (синусы и косинусы поворота считаются
+ * один раз на команду, а не на вершину) и обрабатывают по 8 (AVX2) или
+ * 4 (SSE, NEON) точки за итерацию. Набор инструкций выбирается при первом
+ * вызове по возможностям процессора; порядок операций тот же, что в скалярном
+ * Matrix4::Apply.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef TRANSFORM_KERNELS_HPP
+#define TRANSFORM_KERNELS_HPP
+
+#include <cstddef>
+
+#include "transform.hpp"
+
+namespace s21 {
+
+/**
+ * @brief Применяет матрицу к точкам, хранящимся подряд как x, y, z (AoS).
+ *
+ * Формат совпадает с std::vector<Vertex>, поэтому вершины модели
+ * преобразуются на месте без перепаковки.
+ *
+ * @param xyz Массив из 3 * count чисел.
+ * @param count Количество точек.
+ * @param matrix Матрица преобразования.
+ */
+void TransformPoints(float* xyz, size_t count, const Matrix4& matrix);
+
+/**
+ * @brief Применяет матрицу к точкам, хранящимся отдельными массивами (SoA).
+ *
+ * @param x Координаты x, count чисел.
+ * @param y Координаты y, count чисел.
+ * @param z Координаты z, count чисел.
+ * @param count Количество точек.
+ * @param matrix Матрица преобразования.
+ */
+void TransformPoints(float* x, float* y, float* z, size_t count,
+                     const Matrix4& matrix);
+
+/**
+ * @brief Название набора инструкций, выбранного для ядер.
+ *
+ * @return "avx2", "sse", "neon" или "scalar".
+ */
+const char* TransformKernelName();
+
+}  // namespace s21
+
+#endif  // TRANSFORM_KERNELS_HPP
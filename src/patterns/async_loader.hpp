@@ -0,0 +1,126 @@
+/**
+ * @file async_loader.hpp
+ * @brief Загрузка 3D-модели в фоновом потоке.
+ *
+ * Модель читается и нормализуется в отдельном объекте Model, не затрагивая
+ * текущую модель ModelManager. Подменять текущую модель результатом должен
+ * поток, который её отображает (см. Controller::FinishAsyncLoad).
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef ASYNC_LOADER_HPP
+#define ASYNC_LOADER_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "model_manager.hpp"
+
+namespace s21 {
+
+/**
+ * @class AsyncLoader
+ * @brief Фоновая загрузка одной модели с прогрессом и отменой.
+ */
+class AsyncLoader {
+ public:
+  using ProgressCallback = std::function<void(const LoadProgress&)>;
+  using DoneCallback = std::function<void()>;
+
+  AsyncLoader() = default;
+  AsyncLoader(const AsyncLoader&) = delete;
+  void operator=(const AsyncLoader&) = delete;
+
+  /**
+   * @brief Деструктор: отменяет незавершённую загрузку и ждёт поток.
+   */
+  ~AsyncLoader() {
+    Cancel();
+    Wait();
+  }
+
+  /**
+   * @brief Запускает загрузку модели в фоновом потоке.
+   *
+   * Предыдущая незавершённая загрузка отменяется, её результат теряется.
+   * Колбэки вызываются в фоновом потоке (progress - и из потоков пула),
+   * поэтому done не должен сам вызывать TakeResult(): он лишь сообщает
+   * владельцу, что результат готов.
+   *
+   * @param path Путь к файлу модели (.obj).
+   * @param progress Вызывается по мере разбора файла (может быть пустым).
+   * @param done Вызывается после завершения загрузки, удачного или нет.
+   * @param cache Кэш сеток, через который идёт загрузка.
+   * @param mode Какие данные модели сохраняются.
+   */
+  void Start(const std::string& path, ProgressCallback progress,
+             DoneCallback done, MeshCache cache = MeshCache(),
+             LoadMode mode = LoadMode::kFull) {
+    Cancel();
+    Wait();
+    cancel_ = false;
+    result_.reset();
+    loaded_ = false;
+
+    thread_ = std::thread([this, path, progress = std::move(progress),
+                           done = std::move(done), cache = std::move(cache),
+                           mode] {
+      LoadOptions options;
+      options.progress = progress;
+      options.cancel = &cancel_;
+      options.mode = mode;
+
+      loaded_ = ModelManager::PrepareModel(path, options, cache, result_);
+      if (done) done();
+    });
+  }
+
+  /**
+   * @brief Запрашивает отмену текущей загрузки.
+   *
+   * Разбор прерывается в течение обработки следующего мегабайта файла;
+   * колбэк done всё равно вызывается.
+   */
+  void Cancel() { cancel_ = true; }
+
+  /**
+   * @brief Ждёт завершения фонового потока.
+   */
+  void Wait() {
+    if (thread_.joinable()) thread_.join();
+  }
+
+  /**
+   * @brief Забирает результат завершённой загрузки.
+   *
+   * Дожидается фонового потока.
+   *
+   * @param model Сюда записывается модель (при неудаче - с описанием
+   * ошибки) или nullptr, если загрузка не запускалась или результат уже
+   * забран.
+   * @return true если модель загружена.
+   */
+  bool TakeResult(std::unique_ptr<Model>& model) {
+    Wait();
+    model = std::move(result_);
+    const bool loaded = model && loaded_;
+    loaded_ = false;
+    return loaded;
+  }
+
+ private:
+  std::thread thread_;             ///< Фоновый поток загрузки
+  std::atomic<bool> cancel_{false};  ///< Флаг отмены для LoadOptions
+  std::unique_ptr<Model> result_;  ///< Результат последней загрузки
+  bool loaded_ = false;            ///< Результат загружен успешно
+};
+
+}  // namespace s21
+
+#endif  // ASYNC_LOADER_HPP
@@ -4,16 +4,23 @@
  *
  * Содержит абстрактный класс Command и его конкретные реализации:
  * MoveCommand, RotateCommand, ScaleCommand для выполнения трансформаций над
- * 3D-моделью.
+ * 3D-моделью, а также составную команду CompositeCommand. Каждая команда
+ * описывается одной матрицей, поэтому составная команда и отмена
+ * выполняются одним умножением (или одним проходом по вершинам).
  *
  * @authors lioncoco, starfrus, melonyna
- * @version 1.0
+ * @version 2.0
  * @date 2025
  */
 
 #ifndef COMMAND_HPP
 #define COMMAND_HPP
 
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../model/metrics.hpp"
 #include "model_manager.hpp"
 
 namespace s21 {
@@ -23,7 +30,9 @@ namespace s21 {
  * @brief Абстрактный базовый класс для команд трансформации модели.
  *
  * Реализует паттерн Command, позволяющий инкапсулировать операции над моделью
- * в виде объектов. Поддерживает отмену операций и составные команды.
+ * в виде объектов. Команда задаётся матрицей преобразования, поэтому для
+ * отмены достаточно обратной матрицы (CommandQueue), а составная команда
+ * (CompositeCommand) сводится к произведению матриц.
  */
 class Command {
  public:
@@ -35,12 +44,46 @@ class Command {
   virtual ~Command() = default;
 
   /**
-   * @brief Выполняет команду.
-   *
-   * Чисто виртуальный метод, который должен быть реализован в производных
-   * классах.
+   * @brief Выполняет команду над текущей моделью ModelManager.
    */
   virtual void Execute() = 0;
+
+  /**
+   * @brief Возвращает матрицу преобразования команды.
+   */
+  virtual Matrix4 GetMatrix() const = 0;
+
+  /**
+   * @brief Объединяет следующую команду с этой.
+   *
+   * Объединяются только команды одного вида, результат которых совпадает с
+   * последовательным выполнением (например, два перемещения).
+   *
+   * @param next Команда, которая выполнялась бы сразу после этой.
+   * @return true если next учтена в этой команде и её можно отбросить.
+   */
+  virtual bool MergeWith([[maybe_unused]] const Command& next) {
+    return false;
+  }
+
+  /**
+   * @brief Применяет преобразование к текущей модели ModelManager.
+   *
+   * В режиме TransformMode::kMatrix матрица добавляется к матрице модели,
+   * иначе переписываются вершины.
+   *
+   * @param transform Преобразование, применяемое после уже выполненных.
+   */
+  static void ApplyToModel(const Matrix4& transform) {
+    auto& manager = ModelManager::GetInstance();
+    if (auto* model = manager.GetModel()) {
+      if (manager.GetTransformMode() == TransformMode::kMatrix) {
+        model->ApplyTransform(transform);
+      } else {
+        model->TransformVertices(transform);
+      }
+    }
+  }
 };
 
 /**
@@ -63,19 +106,28 @@ class MoveCommand : public Command {
   /**
    * @brief Выполняет перемещение модели.
    *
-   * Прибавляет заданные значения ко всем координатам вершин текущей модели.
+   * Прибавляет заданные значения ко всем координатам вершин текущей модели
+   * (в режиме TransformMode::kMatrix - к матрице модели).
    */
   void Execute() override {
-    auto& manager = ModelManager::GetInstance();
+    ScopedTimer timer("command.move");
+    ApplyToModel(GetMatrix());
+  }
 
-    if (auto* model = manager.GetModel()) {
-      auto& vertices = model->GetMutableVertices();
-      for (auto& vertex : vertices) {
-        vertex.x += dx_;
-        vertex.y += dy_;
-        vertex.z += dz_;
-      }
-    }
+  Matrix4 GetMatrix() const override {
+    return Matrix4::Translation(dx_, dy_, dz_);
+  }
+
+  /**
+   * @brief Складывает смещения двух перемещений подряд.
+   */
+  bool MergeWith(const Command& next) override {
+    const auto* move = dynamic_cast<const MoveCommand*>(&next);
+    if (!move) return false;
+    dx_ += move->dx_;
+    dy_ += move->dy_;
+    dz_ += move->dz_;
+    return true;
   }
 
  private:
@@ -105,54 +157,51 @@ class RotateCommand : public Command {
   /**
    * @brief Выполняет вращение модели.
    *
-   * Применяет матричные преобразования для поворота всех вершин модели.
+   * Применяет матричные преобразования для поворота всех вершин модели
+   * (в режиме TransformMode::kMatrix - к матрице модели).
    */
   void Execute() override {
-    auto& manager = ModelManager::GetInstance();
-    if (auto* model = manager.GetModel()) {
-      RotateVertices(model->GetMutableVertices());
-    }
+    ScopedTimer timer("command.rotate");
+    ApplyToModel(GetMatrix());
   }
 
- private:
-  /**
-   * @brief Применяет вращение ко всем вершинам модели.
-   *
-   * @param vertices Вектор вершин для трансформации.
-   * @param inverse Флаг обратного вращения (для отмены операций).
-   */
-  void RotateVertices(std::vector<Vertex>& vertices, bool inverse = false) {
-    const float deg_to_rad = M_PI / 180.0f;
-    float ax = angle_x_ * deg_to_rad * (inverse ? -1 : 1);
-    float ay = angle_y_ * deg_to_rad * (inverse ? -1 : 1);
-    float az = angle_z_ * deg_to_rad * (inverse ? -1 : 1);
-
-    for (auto& vertex : vertices) {
-      if (ax != 0) RotatePair(vertex.y, vertex.z, ax);
-      if (ay != 0) RotatePair(vertex.z, vertex.x, ay);
-      if (az != 0) RotatePair(vertex.x, vertex.y, az);
-    }
+  Matrix4 GetMatrix() const override {
+    // Синусы и косинусы считаются один раз при построении матрицы
+    return Matrix4::Rotation(angle_x_, angle_y_, angle_z_);
   }
 
   /**
-   * @brief Поворачивает пару координат на заданный угол.
+   * @brief Складывает углы двух поворотов вокруг одной и той же оси.
    *
-   * Использует формулы вращения в двумерной плоскости.
-   *
-   * @param coord1 Первая координата (например, x).
-   * @param coord2 Вторая координата (например, y).
-   * @param angle Угол поворота в радианах.
-   */
-  void RotatePair(float& coord1, float& coord2, float angle) {
-    float p1 = coord1 * cos(angle) - coord2 * sin(angle);
-    float p2 = coord1 * sin(angle) + coord2 * cos(angle);
-    coord1 = p1;
-    coord2 = p2;
+   * Повороты вокруг разных осей не перестановочны, поэтому такие команды
+   * не объединяются.
+   */
+  bool MergeWith(const Command& next) override {
+    const auto* rotate = dynamic_cast<const RotateCommand*>(&next);
+    if (!rotate) return false;
+    const int axis = GetAxis();
+    if (axis < 0 || axis != rotate->GetAxis()) return false;
+    angle_x_ += rotate->angle_x_;
+    angle_y_ += rotate->angle_y_;
+    angle_z_ += rotate->angle_z_;
+    return true;
   }
 
+ private:
   float angle_x_;  ///< Угол поворота вокруг оси X
   float angle_y_;  ///< Угол поворота вокруг оси Y
   float angle_z_;  ///< Угол поворота вокруг оси Z
+
+  /**
+   * @brief Единственная ось поворота: 0 - X, 1 - Y, 2 - Z.
+   *
+   * @return -1, если поворот задан вокруг нескольких осей или нулевой.
+   */
+  int GetAxis() const {
+    const bool x = angle_x_ != 0, y = angle_y_ != 0, z = angle_z_ != 0;
+    if (x + y + z != 1) return -1;
+    return x ? 0 : (y ? 1 : 2);
+  }
 };
 
 /**
@@ -173,25 +222,90 @@ class ScaleCommand : public Command {
   /**
    * @brief Выполняет масштабирование модели.
    *
-   * Умножает координаты всех вершин на коэффициент масштабирования.
+   * Умножает координаты всех вершин на коэффициент масштабирования
+   * (в режиме TransformMode::kMatrix - к матрице модели).
    */
   void Execute() override {
+    ScopedTimer timer("command.scale");
     if (factor_ <= 0.0f) return;
-    auto& manager = ModelManager::GetInstance();
-    if (auto* model = manager.GetModel()) {
-      auto& vertices = model->GetMutableVertices();
-      for (auto& vertex : vertices) {
-        vertex.x *= factor_;
-        vertex.y *= factor_;
-        vertex.z *= factor_;
-      }
-    }
+    ApplyToModel(GetMatrix());
+  }
+
+  /**
+   * @brief Матрица масштабирования; для factor <= 0 - единичная.
+   */
+  Matrix4 GetMatrix() const override {
+    return factor_ > 0.0f ? Matrix4::Scale(factor_) : Matrix4::Identity();
+  }
+
+  /**
+   * @brief Перемножает коэффициенты двух масштабирований подряд.
+   */
+  bool MergeWith(const Command& next) override {
+    const auto* scale = dynamic_cast<const ScaleCommand*>(&next);
+    if (!scale || factor_ <= 0.0f || scale->factor_ <= 0.0f) return false;
+    factor_ *= scale->factor_;
+    return true;
   }
 
  private:
   float factor_;  ///< Коэффициент масштабирования
 };
 
+/**
+ * @class CompositeCommand
+ * @brief Последовательность команд, выполняемая как одна.
+ *
+ * Матрицы вложенных команд перемножаются, поэтому модель изменяется один
+ * раз: одно умножение матриц в режиме TransformMode::kMatrix или один
+ * проход по вершинам в режиме kBake.
+ */
+class CompositeCommand : public Command {
+ public:
+  /**
+   * @brief Добавляет команду в конец последовательности.
+   *
+   * Команда того же вида, что и последняя, объединяется с ней.
+   *
+   * @param command Команда (nullptr не добавляется).
+   */
+  void Add(std::unique_ptr<Command> command) {
+    if (!command) return;
+    if (!commands_.empty() && commands_.back()->MergeWith(*command)) return;
+    commands_.push_back(std::move(command));
+  }
+
+  /**
+   * @brief Проверяет, пуста ли последовательность.
+   */
+  bool IsEmpty() const { return commands_.empty(); }
+
+  /**
+   * @brief Возвращает число команд после объединения.
+   */
+  size_t GetSize() const { return commands_.size(); }
+
+  void Execute() override {
+    if (commands_.empty()) return;
+    ScopedTimer timer("command.composite");
+    ApplyToModel(GetMatrix());
+  }
+
+  /**
+   * @brief Произведение матриц команд: первая команда применяется первой.
+   */
+  Matrix4 GetMatrix() const override {
+    Matrix4 result;
+    for (const auto& command : commands_) {
+      result = command->GetMatrix() * result;
+    }
+    return result;
+  }
+
+ private:
+  std::vector<std::unique_ptr<Command>> commands_;  ///< Команды по порядку
+};
+
 }  // namespace s21
 
 #endif  // COMMAND_HPP
\ No newline at end of file
@@ -0,0 +1,213 @@
+/**
+ * @file command_queue.hpp
+ * @brief Очередь команд трансформации с отменой и повтором.
+ *
+ * Команды подряд одного вида объединяются ещё до выполнения, а вся очередь
+ * выполняется одним изменением модели. История хранит для каждого шага
+ * только матрицу и обратную к ней, а не копию вершин, поэтому её размер не
+ * зависит от числа вершин модели.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef COMMAND_QUEUE_HPP
+#define COMMAND_QUEUE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "command.hpp"
+
+namespace s21 {
+
+/**
+ * @class CommandQueue
+ * @brief Отложенное выполнение команд и история для отмены.
+ *
+ * Push() только ставит команду в очередь; Flush() выполняет накопленные
+ * команды как одну CompositeCommand и записывает шаг истории. Undo() и
+ * Redo() применяют к текущей модели обратную или прямую матрицу шага.
+ * Применение можно заменить (см. конструктор): так Controller совмещает
+ * шаги команд с абсолютным состоянием трансформации.
+ *
+ * История хранится вместе с моделью (Placement, см.
+ * ModelManager::GetPlacement): после возврата к модели из кэша её шаги
+ * снова можно отменить, а у новой модели история пуста.
+ */
+class CommandQueue {
+ public:
+  /// Наибольшее число шагов истории; старые шаги отбрасываются
+  static constexpr size_t kMaxHistory = 1000;
+
+  /// Применение шага к текущей модели; GetTransform() к этому моменту уже
+  /// учитывает шаг
+  using Applier = std::function<void(const Matrix4& step)>;
+
+  CommandQueue() = default;
+
+  /**
+   * @brief Создаёт очередь с собственным применением шагов.
+   *
+   * @param apply Вызывается вместо Command::ApplyToModel() с матрицей шага
+   * (при отмене - обратной).
+   */
+  explicit CommandQueue(Applier apply) : apply_(std::move(apply)) {}
+
+  /**
+   * @brief Ставит команду в очередь.
+   *
+   * Команда того же вида, что и последняя в очереди, объединяется с ней.
+   *
+   * @param command Команда (nullptr игнорируется).
+   */
+  void Push(std::unique_ptr<Command> command) {
+    pending_.Add(std::move(command));
+  }
+
+  /**
+   * @brief Проверяет, есть ли невыполненные команды.
+   */
+  bool HasPending() const { return !pending_.IsEmpty(); }
+
+  /**
+   * @brief Выполняет накопленные команды одним изменением модели.
+   *
+   * Шаг записывается в историю, а ветка повтора сбрасывается.
+   *
+   * @return true если модель изменилась.
+   */
+  bool Flush() {
+    if (pending_.IsEmpty()) return false;
+    CompositeCommand commands = std::exchange(pending_, CompositeCommand());
+    Placement* placement = GetPlacement();
+    if (!placement) return false;
+
+    const Matrix4 forward = commands.GetMatrix();
+    if (forward.IsIdentity()) return false;
+
+    auto& undo = placement->undo;
+    undo.push_back({forward, forward.AffineInverse()});
+    if (undo.size() > kMaxHistory) {
+      placement->dropped = undo.front().forward * placement->dropped;
+      undo.pop_front();
+    }
+    placement->redo.clear();
+    UpdateTransform(*placement);
+    ScopedTimer timer("command.composite");
+    apply_(forward);
+    return true;
+  }
+
+  /**
+   * @brief Отменяет последний шаг истории.
+   *
+   * Невыполненные команды сначала выполняются, чтобы отменить именно их.
+   *
+   * @return true если шаг отменён.
+   */
+  bool Undo() {
+    Flush();
+    Placement* placement = GetPlacement();
+    if (!placement || placement->undo.empty()) return false;
+    ScopedTimer timer("command.undo");
+    const Matrix4 inverse = placement->undo.back().inverse;
+    placement->redo.push_back(placement->undo.back());
+    placement->undo.pop_back();
+    UpdateTransform(*placement);
+    apply_(inverse);
+    return true;
+  }
+
+  /**
+   * @brief Повторяет последний отменённый шаг.
+   *
+   * @return true если шаг повторён.
+   */
+  bool Redo() {
+    Flush();
+    Placement* placement = GetPlacement();
+    if (!placement || placement->redo.empty()) return false;
+    ScopedTimer timer("command.redo");
+    const Matrix4 forward = placement->redo.back().forward;
+    placement->undo.push_back(placement->redo.back());
+    placement->redo.pop_back();
+    UpdateTransform(*placement);
+    apply_(forward);
+    return true;
+  }
+
+  /**
+   * @brief Возвращает число шагов, которые можно отменить.
+   */
+  size_t GetUndoCount() const {
+    const Placement* placement = GetPlacement();
+    return placement ? placement->undo.size() : 0;
+  }
+
+  /**
+   * @brief Возвращает число шагов, которые можно повторить.
+   */
+  size_t GetRedoCount() const {
+    const Placement* placement = GetPlacement();
+    return placement ? placement->redo.size() : 0;
+  }
+
+  /**
+   * @brief Возвращает итоговое преобразование выполненных шагов.
+   *
+   * Произведение шагов истории текущей модели без отменённых (и без
+   * невыполненных команд); для новой модели - единичная матрица.
+   */
+  const Matrix4& GetTransform() const {
+    static const Matrix4 kIdentity;
+    const Placement* placement = GetPlacement();
+    return placement ? placement->commands : kIdentity;
+  }
+
+  /**
+   * @brief Сбрасывает очередь и историю текущей модели.
+   */
+  void Clear() {
+    pending_ = CompositeCommand();
+    if (Placement* placement = GetPlacement()) {
+      placement->undo.clear();
+      placement->redo.clear();
+      placement->dropped = Matrix4::Identity();
+      placement->commands = Matrix4::Identity();
+    }
+  }
+
+ private:
+  CompositeCommand pending_;  ///< Ещё не выполненные команды
+  Applier apply_ = Command::ApplyToModel;  ///< Применение шага к модели
+
+  /**
+   * @brief Положение текущей модели вместе с её историей.
+   *
+   * @return nullptr если модель не загружена.
+   */
+  static Placement* GetPlacement() {
+    return ModelManager::GetInstance().GetPlacement();
+  }
+
+  /**
+   * @brief Пересчитывает итог выполненных шагов (Placement::commands).
+   *
+   * Произведение берётся заново, а не домножается на обратную матрицу,
+   * поэтому после отмены всех шагов получается точно единичная матрица.
+   */
+  static void UpdateTransform(Placement& placement) {
+    placement.commands = placement.dropped;
+    for (const TransformStep& step : placement.undo) {
+      placement.commands = step.forward * placement.commands;
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // COMMAND_QUEUE_HPP
@@ -0,0 +1,319 @@
+/**
+ * @file frame_recorder.hpp
+ * @brief Кодирование и запись кадров окна отрисовки в фоновом потоке.
+ *
+ * Поток отрисовки только копирует пиксели кадра и отдаёт их Submit(); файлы
+ * кодируются и пишутся фоновым потоком, который раздаёт накопившиеся кадры
+ * общему ThreadPool. Если кодирование не успевает, лишние кадры
+ * пропускаются, а поток отрисовки никогда не ждёт.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef FRAME_RECORDER_HPP
+#define FRAME_RECORDER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../model/capture.hpp"
+#include "../model/metrics.hpp"
+#include "../model/thread_pool.hpp"
+
+namespace s21 {
+
+/**
+ * @struct RecordOptions
+ * @brief Параметры записи.
+ */
+struct RecordOptions {
+  CaptureFormat format = CaptureFormat::kGif;  ///< Формат
+  /// GIF - путь к файлу; BMP и JPEG - путь без расширения, к которому
+  /// добавляется номер кадра (CaptureFramePath), а при frame_limit == 1 -
+  /// путь к единственному файлу
+  std::string path;
+  int fps = 10;            ///< Кадров в секунду (задержка кадров GIF)
+  size_t frame_limit = 0;  ///< Записать не больше кадров (0 - без предела)
+  size_t queue_limit = 8;  ///< Кадров в очереди, сверх - пропуск
+};
+
+/**
+ * @struct RecordStats
+ * @brief Итоги записи.
+ */
+struct RecordStats {
+  size_t frames_written = 0;  ///< Записано кадров
+  size_t frames_dropped = 0;  ///< Пропущено: очередь полна или другой размер
+  bool error = false;         ///< Не удалось записать файл
+};
+
+/**
+ * @class FrameRecorder
+ * @brief Очередь кадров и фоновое кодирование BMP, JPEG или GIF.
+ *
+ * Submit() вызывает один поток (отрисовка), Start() и Stop() - поток GUI.
+ * Кадры одного пакета кодируются параллельно, а в файл GIF пишутся в
+ * порядке поступления. Все кадры записи должны быть одного размера:
+ * кадр другого размера пропускается.
+ */
+class FrameRecorder {
+ public:
+  /// Кодировщик одного кадра в файл (для JPEG, см. RecordOptions)
+  using ImageWriter =
+      std::function<bool(const CaptureFrame& frame, const std::string& path)>;
+  using DoneCallback = std::function<void()>;
+
+  FrameRecorder() = default;
+  FrameRecorder(const FrameRecorder&) = delete;
+  void operator=(const FrameRecorder&) = delete;
+
+  /**
+   * @brief Деструктор: дописывает принятые кадры и закрывает файл.
+   */
+  ~FrameRecorder() { Stop(); }
+
+  /**
+   * @brief Начинает запись; предыдущая запись завершается.
+   *
+   * @param options Параметры.
+   * @param writer Кодировщик файлов кадров; пустой - WriteBmp (для kJpeg
+   * обязателен, для kGif не используется).
+   * @param done Вызывается в фоновом потоке, когда записаны frame_limit
+   * кадров; Stop() из него вызывать нельзя.
+   * @return false если для формата нет кодировщика или путь пуст.
+   */
+  bool Start(const RecordOptions& options, ImageWriter writer = nullptr,
+             DoneCallback done = nullptr) {
+    Stop();
+    if (options.path.empty() || options.fps <= 0) return false;
+    if (!writer) {
+      if (options.format == CaptureFormat::kJpeg) return false;
+      writer = WriteBmp;
+    }
+
+    options_ = options;
+    writer_ = std::move(writer);
+    done_ = std::move(done);
+    stats_ = RecordStats();
+    queue_.clear();
+    width_ = 0;
+    height_ = 0;
+    accepted_ = 0;
+    stop_ = false;
+    recording_ = true;
+    thread_ = std::thread([this] { Run(); });
+    return true;
+  }
+
+  /**
+   * @brief Проверяет, принимаются ли кадры.
+   *
+   * false до Start(), после Stop() и после frame_limit принятых кадров.
+   */
+  bool IsRecording() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recording_;
+  }
+
+  /**
+   * @brief Возвращает кадр для заполнения.
+   *
+   * Память кадров, уже записанных в файл, переиспользуется, поэтому при
+   * постоянном размере окна запись не выделяет память.
+   */
+  CaptureFrame AcquireFrame() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.empty()) return CaptureFrame();
+    CaptureFrame frame = std::move(free_.back());
+    free_.pop_back();
+    return frame;
+  }
+
+  /**
+   * @brief Ставит кадр в очередь записи. Не ждёт кодирования.
+   *
+   * @param frame Кадр (см. AcquireFrame()).
+   * @return false если кадр пропущен: запись не идёт, очередь полна или
+   * размер отличается от первого кадра.
+   */
+  bool Submit(CaptureFrame frame) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!recording_) return false;
+      if (width_ == 0) {
+        width_ = frame.width;
+        height_ = frame.height;
+      }
+      if (frame.width != width_ || frame.height != height_ ||
+          queue_.size() >= options_.queue_limit) {
+        ++stats_.frames_dropped;
+        Recycle(frame);
+        return false;
+      }
+      queue_.push_back({accepted_++, std::move(frame)});
+      if (options_.frame_limit && accepted_ >= options_.frame_limit) {
+        recording_ = false;
+      }
+    }
+    wake_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Завершает запись: дописывает принятые кадры и закрывает файл.
+   *
+   * @return Итоги записи.
+   */
+  RecordStats Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      recording_ = false;
+      stop_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+    return GetStats();
+  }
+
+  /**
+   * @brief Возвращает итоги записи на текущий момент.
+   */
+  RecordStats GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  /**
+   * @brief Возвращает параметры последнего Start().
+   */
+  const RecordOptions& GetOptions() const { return options_; }
+
+ private:
+  /**
+   * @brief Принятый кадр с номером в записи.
+   */
+  struct QueuedFrame {
+    size_t index = 0;    ///< Номер кадра, с нуля
+    CaptureFrame frame;  ///< Пиксели
+  };
+
+  /// Кадров в запасе для AcquireFrame()
+  static constexpr size_t kFreeFrames = 4;
+
+  std::thread thread_;            ///< Фоновый поток записи
+  mutable std::mutex mutex_;      ///< Защищает очередь и итоги
+  std::condition_variable wake_;  ///< Пришёл кадр или остановка
+  RecordOptions options_;         ///< Параметры записи
+  ImageWriter writer_;            ///< Кодировщик файлов кадров
+  DoneCallback done_;             ///< Уведомление о записи frame_limit кадров
+  RecordStats stats_;             ///< Итоги
+  std::deque<QueuedFrame> queue_;    ///< Принятые, ещё не записанные кадры
+  std::vector<CaptureFrame> free_;   ///< Память записанных кадров
+  uint32_t width_ = 0;   ///< Размер кадров записи (по первому кадру)
+  uint32_t height_ = 0;  ///< Высота кадров записи
+  size_t accepted_ = 0;  ///< Принято кадров
+  bool recording_ = false;  ///< Кадры принимаются
+  bool stop_ = false;       ///< Поток нужно завершить
+
+  /**
+   * @brief Путь к файлу кадра последовательности.
+   */
+  std::string FramePath(size_t index) const {
+    if (options_.frame_limit == 1) return options_.path;
+    return CaptureFramePath(options_.path, index, options_.format);
+  }
+
+  /**
+   * @brief Цикл фонового потока: пакет кадров из очереди кодируется в
+   * ThreadPool, затем следующий.
+   */
+  void Run() {
+    const bool gif = options_.format == CaptureFormat::kGif;
+    const auto delay = static_cast<uint16_t>((100 + options_.fps / 2) /
+                                             options_.fps);
+    GifWriter gif_writer;
+    std::vector<QueuedFrame> batch;
+    std::vector<std::vector<uint8_t>> blocks;
+    std::vector<char> written;
+    bool limit_reached = false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) break;
+      batch.clear();
+      while (!queue_.empty()) {
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+      const uint32_t width = width_;
+      const uint32_t height = height_;
+      lock.unlock();
+
+      if (gif && !gif_writer.IsOpen() &&
+          !gif_writer.Open(options_.path, width, height)) {
+        lock.lock();
+        stats_.error = true;
+        stats_.frames_dropped += batch.size();
+        for (QueuedFrame& queued : batch) Recycle(queued.frame);
+        continue;
+      }
+
+      blocks.assign(batch.size(), {});
+      written.assign(batch.size(), 0);
+      {
+        ScopedTimer timer("capture.encode");
+        ThreadPool::GetInstance().ParallelFor(batch.size(), [&](size_t i) {
+          if (gif) {
+            blocks[i] = EncodeGifFrame(batch[i].frame, delay);
+          } else {
+            written[i] = writer_(batch[i].frame, FramePath(batch[i].index));
+          }
+        });
+      }
+      if (gif) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+          written[i] = gif_writer.AddFrame(blocks[i]);
+        }
+      }
+
+      lock.lock();
+      for (size_t i = 0; i < batch.size(); ++i) {
+        if (written[i]) {
+          ++stats_.frames_written;
+        } else {
+          stats_.error = true;
+        }
+        Recycle(batch[i].frame);
+      }
+      limit_reached = options_.frame_limit && queue_.empty() &&
+                      accepted_ >= options_.frame_limit;
+      if (limit_reached) break;
+    }
+    lock.unlock();
+
+    if (gif_writer.IsOpen() && !gif_writer.Close()) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      stats_.error = true;
+    }
+    if (limit_reached && done_) done_();
+  }
+
+  /**
+   * @brief Возвращает память кадра в запас (под mutex_).
+   */
+  void Recycle(CaptureFrame& frame) {
+    if (free_.size() < kFreeFrames) free_.push_back(std::move(frame));
+  }
+};
+
+}  // namespace s21
+
+#endif  // FRAME_RECORDER_HPP
@@ -0,0 +1,111 @@
+/**
+ * @file lod_builder.hpp
+ * @brief Построение уровней детализации модели в фоновом потоке.
+ *
+ * Запускается после загрузки модели; до готовности уровней модель рисуется
+ * с полной детализацией. Результат забирает поток, который рисует модель.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef LOD_BUILDER_HPP
+#define LOD_BUILDER_HPP
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "../model/lod.hpp"
+
+namespace s21 {
+
+/**
+ * @class LodBuilder
+ * @brief Фоновое построение LodSet для одной модели с отменой.
+ *
+ * Вершины и рёбра модели не копируются: пока идёт построение, модель нельзя
+ * выгружать и менять её вершины (в режиме TransformMode::kMatrix команды
+ * меняют только матрицу). Перед сменой или выгрузкой модели нужно вызвать
+ * Stop().
+ */
+class LodBuilder {
+ public:
+  using DoneCallback = std::function<void()>;
+
+  LodBuilder() = default;
+  LodBuilder(const LodBuilder&) = delete;
+  void operator=(const LodBuilder&) = delete;
+
+  /**
+   * @brief Деструктор: отменяет построение и ждёт поток.
+   */
+  ~LodBuilder() { Stop(); }
+
+  /**
+   * @brief Запускает построение уровней для модели.
+   *
+   * Предыдущее незавершённое построение отменяется.
+   *
+   * @param model Модель; должна жить до завершения построения.
+   * @param done Вызывается в фоновом потоке после завершения (и после
+   * отмены); TakeResult() из него вызывать нельзя.
+   * @param options Параметры построения (поле cancel заполняется здесь).
+   */
+  void Start(const Model& model, DoneCallback done,
+             LodOptions options = LodOptions()) {
+    Stop();
+    cancel_ = false;
+    finished_ = false;
+    result_ = LodSet();
+    path_ = model.GetPathFile();
+
+    options.cancel = &cancel_;
+    thread_ = std::thread([this, &model, done = std::move(done), options] {
+      result_ = BuildLodSet(model.GetVertices(), model.GetEdges(), options);
+      finished_ = true;
+      if (done) done();
+    });
+  }
+
+  /**
+   * @brief Отменяет построение и ждёт фоновый поток.
+   */
+  void Stop() {
+    cancel_ = true;
+    if (thread_.joinable()) thread_.join();
+  }
+
+  /**
+   * @brief Забирает результат построения.
+   *
+   * Не ждёт незавершённое построение, поэтому запоздавшее уведомление о
+   * предыдущем построении не блокирует вызывающий поток.
+   *
+   * @param path Путь модели, для которой нужен результат.
+   * @param set Сюда переносятся уровни.
+   * @return false если построение ещё идёт, было отменено или было для
+   * другой модели.
+   */
+  bool TakeResult(const std::string& path, LodSet& set) {
+    if (!finished_) return false;
+    if (thread_.joinable()) thread_.join();
+    if (cancel_ || path != path_) return false;
+    set = std::move(result_);
+    result_ = LodSet();
+    return true;
+  }
+
+ private:
+  std::thread thread_;               ///< Фоновый поток
+  std::atomic<bool> cancel_{false};  ///< Флаг отмены для LodOptions
+  std::atomic<bool> finished_{false};  ///< Построение завершилось
+  std::string path_;                 ///< Путь модели последнего построения
+  LodSet result_;                    ///< Результат последнего построения
+};
+
+}  // namespace s21
+
+#endif  // LOD_BUILDER_HPP
@@ -2,9 +2,9 @@
  * @file model_manager.hpp
  * @brief Заголовочный файл для класса ModelManager - менеджера 3D-моделей.
  *
- * Реализует паттерн Singleton для управления единственным экземпляром 3D-модели
- * в приложении. Обеспечивает централизованный доступ к текущей модели и её
- * загрузку.
+ * Реализует паттерн Singleton для управления 3D-моделями в приложении.
+ * Обеспечивает централизованный доступ к текущей модели, её загрузку и
+ * хранение ранее загруженных моделей в пределах бюджета памяти.
  *
  * @authors lioncoco, starfrus, melonyna
  * @version 1.0
@@ -14,20 +14,74 @@
 #ifndef MODEL_MANAGER_HPP
 #define MODEL_MANAGER_HPP
 
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../model/bvh.hpp"
+#include "../model/mesh_cache.hpp"
 #include "../model/model.hpp"
+#include "../model/scene.hpp"
 
 namespace s21 {
 
+/**
+ * @enum TransformMode
+ * @brief Способ применения команд трансформации.
+ */
+enum class TransformMode {
+  kBake,   ///< Команды сразу переписывают вершины модели
+  kMatrix  ///< Команды накапливают матрицу модели (см. Model::GetTransform)
+};
+
+/**
+ * @struct TransformStep
+ * @brief Шаг истории команд: прямое и обратное преобразование.
+ */
+struct TransformStep {
+  Matrix4 forward;  ///< Преобразование шага
+  Matrix4 inverse;  ///< Обратное преобразование
+};
+
+/**
+ * @struct Placement
+ * @brief Положение модели, заданное пользователем.
+ *
+ * Хранится вместе с моделью в ModelManager, поэтому модель, снова ставшая
+ * текущей, сохраняет своё положение и историю отмены (CommandQueue), а не
+ * получает положение предыдущей.
+ */
+struct Placement {
+  TransformState state;  ///< Состояние (Controller::SetTransformState)
+  std::deque<TransformStep> undo;  ///< Выполненные шаги, последний - в конце
+  std::deque<TransformStep> redo;  ///< Отменённые шаги, последний - в конце
+  Matrix4 dropped;   ///< Шаги, вытесненные из истории
+  Matrix4 commands;  ///< Итог выполненных шагов (CommandQueue::GetTransform)
+};
+
 /**
  * @class ModelManager
- * @brief Класс-менеджер для управления единственным экземпляром 3D-модели.
+ * @brief Класс-менеджер для управления загруженными 3D-моделями.
  *
  * Реализует паттерн Singleton, гарантируя существование только одного
  * экземпляра менеджера в приложении. Отвечает за загрузку, хранение и доступ к
  * текущей модели.
+ *
+ * Успешно загруженные модели остаются в памяти (LRU-кэш по пути к файлу),
+ * поэтому повторное открытие файла или переключение между моделями не
+ * требует чтения с диска. Когда суммарный объём моделей превышает бюджет
+ * памяти, выгружаются давно не использованные модели; текущая модель
+ * и модели сцены (см. GetScene) не выгружаются никогда.
  */
 class ModelManager {
  public:
+  /// Бюджет памяти по умолчанию для загруженных моделей
+  static constexpr size_t kDefaultMemoryBudget = size_t{1} << 30;
+
   /**
    * @brief Удалённый конструктор копирования.
    *
@@ -62,44 +116,338 @@ class ModelManager {
    */
   Model* GetModel() const { return current_model_; }
 
+  /**
+   * @brief Номер выбора текущей модели.
+   *
+   * Растёт при каждой смене текущей модели, в том числе когда новая модель
+   * заняла адрес удалённой, поэтому по нему можно понять, что указатель из
+   * GetModel() относится к другой модели.
+   */
+  uint64_t GetSelection() const { return selection_; }
+
+  /**
+   * @brief Возвращает положение текущей модели.
+   *
+   * У новой модели (загруженной или заменившей модель того же файла)
+   * положение исходное.
+   *
+   * @return Указатель на положение или nullptr, если модель не загружена.
+   */
+  Placement* GetPlacement() { return current_placement_; }
+  const Placement* GetPlacement() const { return current_placement_; }
+
+  /**
+   * @brief Возвращает текущий способ применения трансформаций.
+   */
+  TransformMode GetTransformMode() const { return transform_mode_; }
+
+  /**
+   * @brief Устанавливает способ применения трансформаций.
+   *
+   * При переходе в режим kBake накопленная матрица текущей модели
+   * применяется к её вершинам.
+   *
+   * @param mode Новый режим.
+   */
+  void SetTransformMode(TransformMode mode) {
+    if (mode == TransformMode::kBake && current_model_) {
+      current_model_->BakeTransform();
+    }
+    transform_mode_ = mode;
+  }
+
   /**
    * @brief Загружает модель из файла и нормализует её.
    *
-   * Предварительно удаляет предыдущую модель, если она существовала.
-   * После успешной загрузки автоматически нормализует модель.
+   * Если модель этого файла уже в памяти и файл с тех пор не менялся, она
+   * становится текущей без чтения с диска. Иначе файл загружается (через кэш
+   * сеток, см. SetMeshCache) и нормализуется. Модель, загруженная с
+   * пропущенными ошибочными строками, считается загруженной: описание
+   * ошибки остаётся в ней как предупреждение. Неудачно загруженная модель
+   * становится текущей, чтобы была доступна ошибка, но в кэш моделей
+   * не попадает.
    *
    * @param path Путь к файлу модели (.obj).
    * @return true если загрузка успешна, false в случае ошибки.
    */
   bool LoadModel(const std::string& path) {
-    delete current_model_;
-    current_model_ = new Model();
-    bool flag = current_model_->LoadFromFile(path);
-    if (flag) {
-      current_model_->NormalizeModel();
+    if (SelectModel(path)) return true;
+
+    LoadOptions options;
+    options.mode = load_mode_;
+    std::unique_ptr<Model> model;
+    if (!PrepareModel(path, options, mesh_cache_, model)) {
+      SetDetached(std::move(model));
+      return false;
     }
-    return flag;
+    SetModel(std::move(model));
+    return true;
+  }
+
+  /**
+   * @brief Делает текущей модель, которая уже находится в памяти.
+   *
+   * Если исходный файл изменился после загрузки (или модель загружена без
+   * полигонов, а текущий режим загрузки - LoadMode::kFull), устаревшая модель
+   * выгружается.
+   *
+   * @param path Путь к файлу модели.
+   * @return true если модель найдена в памяти и актуальна.
+   */
+  bool SelectModel(const std::string& path) {
+    auto it = index_.find(path);
+    if (it == index_.end()) return false;
+
+    SourceStamp stamp;
+    const bool missing_faces =
+        load_mode_ == LoadMode::kFull && it->second->model->IsEdgesOnly();
+    if (!ReadSourceStamp(path, stamp) || !(stamp == it->second->stamp) ||
+        missing_faces) {
+      if (current_model_ == it->second->model.get()) SetCurrent(nullptr);
+      scene_.Remove(it->second->model.get());
+      entries_.erase(it->second);
+      index_.erase(it);
+      return false;
+    }
+
+    entries_.splice(entries_.begin(), entries_, it->second);
+    ResetDetached();
+    SetCurrent(entries_.front().model.get(), &entries_.front().placement);
+    const Matrix4 transform = current_model_->GetTransform();
+    if (transform_mode_ == TransformMode::kBake && !transform.IsIdentity()) {
+      // Исходные вершины сохраняются: положение модели (GetPlacement)
+      // по-прежнему отсчитывается от них
+      current_model_->SetTransform(Matrix4::Identity());
+      current_model_->SetVertexTransform(transform);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Загружает и нормализует модель в отдельный объект.
+   *
+   * Если в кэше есть действительная запись для файла, модель читается из
+   * неё без разбора, нормализации и выделения рёбер. Иначе файл разбирается,
+   * а результат без ошибок сохраняется в кэш. Запись без полигонов
+   * (LoadMode::kEdgesOnly) не подходит для загрузки в режиме
+   * LoadMode::kFull, а поверхность (LoadOptions::attributes) в кэше не
+   * хранится. В обоих случаях здесь же строится иерархия рёбер
+   * (Model::GetBvh()).
+   *
+   * @param path Путь к файлу модели (.obj).
+   * @param options Параметры разбора файла.
+   * @param cache Кэш сеток (может быть выключен).
+   * @param model Сюда записывается модель, в том числе неудачно загруженная
+   * (с описанием ошибки).
+   * @return true если модель загружена (как Model::LoadFromFile()).
+   */
+  static bool PrepareModel(const std::string& path, const LoadOptions& options,
+                           const MeshCache& cache,
+                           std::unique_ptr<Model>& model) {
+    model = std::make_unique<Model>();
+    bool loaded =
+        !options.attributes && cache.Load(path, *model) &&
+        (options.mode == LoadMode::kEdgesOnly || !model->IsEdgesOnly());
+
+    if (!loaded) {
+      loaded = model->LoadFromFile(path, options);
+      if (!loaded) return false;
+      model->NormalizeModel();
+      // Кэш не хранит ошибку: файл с пропущенными строками разбирается
+      // заново, чтобы предупреждение не терялось
+      if (model->GetLastError() == Model::ErrorCode::kSuccess) {
+        cache.Store(path, *model);
+      }
+    }
+    // Иерархия строится здесь, в потоке загрузки, а не в первом кадре
+    model->GetBvh();
+    return true;
+  }
+
+  /**
+   * @brief Устанавливает кэш сеток, используемый при загрузке.
+   *
+   * @param cache Кэш (MeshCache() - выключить кэширование).
+   */
+  void SetMeshCache(MeshCache cache) { mesh_cache_ = std::move(cache); }
+
+  /**
+   * @brief Возвращает кэш сеток.
+   */
+  const MeshCache& GetMeshCache() const { return mesh_cache_; }
+
+  /**
+   * @brief Устанавливает, какие данные сохраняются при загрузке моделей.
+   *
+   * @param mode LoadMode::kEdgesOnly - не хранить полигоны (только
+   * каркасный просмотр).
+   */
+  void SetLoadMode(LoadMode mode) { load_mode_ = mode; }
+
+  /**
+   * @brief Возвращает режим загрузки моделей.
+   */
+  LoadMode GetLoadMode() const { return load_mode_; }
+
+  /**
+   * @brief Делает загруженную модель текущей и помещает её в кэш моделей.
+   *
+   * Используется для фоновой загрузки: модель готовится в отдельном объекте
+   * и подменяется одной операцией, так что до этого момента отображается
+   * предыдущая модель. Модель того же файла, уже бывшая в памяти, заменяется.
+   *
+   * @param model Новая модель (nullptr - сделать текущей пустую модель).
+   */
+  void SetModel(std::unique_ptr<Model> model) {
+    if (!model) {
+      ResetDetached();
+      SetCurrent(nullptr);
+      return;
+    }
+
+    const std::string path = model->GetPathFile();
+    Entry entry;
+    entry.path = path;
+    ReadSourceStamp(path, entry.stamp);
+    entry.model = std::move(model);
+
+    if (auto it = index_.find(path); it != index_.end()) {
+      scene_.Remove(it->second->model.get());
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    entries_.push_front(std::move(entry));
+    index_[path] = entries_.begin();
+
+    ResetDetached();
+    SetCurrent(entries_.front().model.get(), &entries_.front().placement);
+    EvictToBudget();
   }
 
   /**
    * @brief Загружает модель из файла без нормализации (для тестирования).
    *
-   * Предварительно удаляет предыдущую модель, если она существовала.
-   * Используется в тестах, где нормализация не требуется.
+   * Модель не попадает в кэш моделей и не берётся из него.
    *
    * @param path Путь к файлу модели (.obj).
    * @return true если загрузка успешна, false в случае ошибки.
    */
   bool LoadModelForTest(const std::string& path) {
-    delete current_model_;
-    current_model_ = new Model();
-    bool flag = current_model_->LoadFromFile(path);
-
+    auto model = std::make_unique<Model>();
+    bool flag = model->LoadFromFile(path);
+    SetDetached(std::move(model));
     return flag;
   }
 
+  // --- Кэш моделей ---
+
+  /**
+   * @brief Проверяет, находится ли модель файла в памяти.
+   */
+  bool IsResident(const std::string& path) const {
+    return index_.contains(path);
+  }
+
+  /**
+   * @brief Пути моделей в памяти, от недавно использованной к давней.
+   */
+  std::vector<std::string> GetResidentPaths() const {
+    std::vector<std::string> paths;
+    paths.reserve(entries_.size());
+    for (const Entry& entry : entries_) paths.push_back(entry.path);
+    return paths;
+  }
+
+  /**
+   * @brief Суммарный объём памяти моделей в кэше.
+   *
+   * @return Размер в байтах (см. Model::GetMemoryUsage).
+   */
+  size_t GetMemoryUsage() const {
+    size_t total = 0;
+    for (const Entry& entry : entries_) total += entry.model->GetMemoryUsage();
+    return total;
+  }
+
+  /**
+   * @brief Возвращает бюджет памяти кэша моделей.
+   */
+  size_t GetMemoryBudget() const { return memory_budget_; }
+
+  /**
+   * @brief Устанавливает бюджет памяти кэша моделей.
+   *
+   * Лишние модели выгружаются сразу.
+   *
+   * @param bytes Бюджет в байтах.
+   */
+  void SetMemoryBudget(size_t bytes) {
+    memory_budget_ = bytes;
+    EvictToBudget();
+  }
+
+  /**
+   * @brief Выгружает модель файла из памяти.
+   *
+   * Если это текущая модель, текущей модели не остаётся.
+   *
+   * @param path Путь к файлу модели.
+   */
+  void Unload(const std::string& path) {
+    auto it = index_.find(path);
+    if (it == index_.end()) return;
+    if (current_model_ == it->second->model.get()) SetCurrent(nullptr);
+    scene_.Remove(it->second->model.get());
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  /**
+   * @brief Выгружает все модели, включая текущую.
+   */
+  void Clear() {
+    scene_.Clear();
+    entries_.clear();
+    index_.clear();
+    detached_.reset();
+    SetCurrent(nullptr);
+  }
+
+  // --- Сцена ---
+
+  /**
+   * @brief Возвращает сцену из нескольких моделей.
+   *
+   * Модели сцены остаются в памяти сверх бюджета; при выгрузке или замене
+   * модели (Unload, повторная загрузка файла) она удаляется и из сцены.
+   */
+  Scene& GetScene() { return scene_; }
+  const Scene& GetScene() const { return scene_; }
+
  private:
+  /**
+   * @brief Модель в кэше моделей.
+   */
+  struct Entry {
+    std::string path;              ///< Путь к исходному файлу (ключ)
+    SourceStamp stamp;             ///< Версия файла на момент загрузки
+    std::unique_ptr<Model> model;  ///< Загруженная модель
+    Placement placement;           ///< Положение модели
+  };
+
+  std::list<Entry> entries_;  ///< Модели, от недавно использованной к давней
+  std::unordered_map<std::string, std::list<Entry>::iterator>
+      index_;                          ///< Поиск модели по пути
+  std::unique_ptr<Model> detached_;    ///< Текущая модель вне кэша
+  Placement detached_placement_;       ///< Положение модели вне кэша
+  Placement* current_placement_ = nullptr;  ///< Положение текущей модели
   Model* current_model_ = nullptr;  ///< Указатель на текущую загруженную модель
+  uint64_t selection_ = 0;          ///< Номер выбора текущей модели
+  size_t memory_budget_ = kDefaultMemoryBudget;  ///< Бюджет памяти моделей
+  TransformMode transform_mode_ = TransformMode::kBake;  ///< Режим трансформаций
+  MeshCache mesh_cache_;  ///< Кэш сеток (по умолчанию выключен)
+  LoadMode load_mode_ = LoadMode::kFull;  ///< Режим загрузки моделей
+  Scene scene_;  ///< Сцена (указывает на модели кэша)
 
   /**
    * @brief Приватный конструктор.
@@ -112,11 +460,59 @@ class ModelManager {
   /**
    * @brief Приватный деструктор.
    *
-   * Автоматически удаляет текущую модель при уничтожении менеджера.
+   * Модели освобождаются вместе с кэшем.
    */
-  ~ModelManager() { delete current_model_; }
+  ~ModelManager() = default;
+
+  /**
+   * @brief Меняет текущую модель и номер выбора.
+   *
+   * @param model Новая текущая модель (nullptr - нет модели).
+   * @param placement Положение этой модели.
+   */
+  void SetCurrent(Model* model, Placement* placement = nullptr) {
+    current_placement_ = model ? placement : nullptr;
+    if (model == current_model_) return;
+    current_model_ = model;
+    ++selection_;
+  }
+
+  /**
+   * @brief Делает текущей модель, которая не хранится в кэше моделей.
+   */
+  void SetDetached(std::unique_ptr<Model> model) {
+    ResetDetached();
+    detached_ = std::move(model);
+    detached_placement_ = Placement();
+    SetCurrent(detached_.get(), &detached_placement_);
+  }
+
+  /**
+   * @brief Удаляет текущую модель вне кэша (и из сцены).
+   */
+  void ResetDetached() {
+    if (detached_) scene_.Remove(detached_.get());
+    detached_.reset();
+  }
+
+  /**
+   * @brief Выгружает давно использованные модели, пока кэш не уложится
+   * в бюджет. Текущая модель не выгружается.
+   */
+  void EvictToBudget() {
+    size_t usage = GetMemoryUsage();
+    auto it = entries_.end();
+    while (usage > memory_budget_ && it != entries_.begin()) {
+      --it;
+      const Model* model = it->model.get();
+      if (model == current_model_ || scene_.Contains(model)) continue;
+      usage -= it->model->GetMemoryUsage();
+      index_.erase(it->path);
+      it = entries_.erase(it);
+    }
+  }
 };
 
 }  // namespace s21
 
-#endif  // MODEL_MANAGER_HPP
\ No newline at end of file
+#endif  // MODEL_MANAGER_HPP
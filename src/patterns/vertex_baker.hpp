@@ -0,0 +1,170 @@
+/**
+ * @file vertex_baker.hpp
+ * @brief Пересчёт вершин модели (TransformMode::kBake) в фоновом потоке.
+ *
+ * Пересчёт вершин большой модели занимает сотни миллисекунд. Чтобы поток
+ * GUI не ждал его, запросы передаются фоновому потоку, а результат
+ * публикуется снимком в SnapshotBuffer, откуда его без блокировок забирает
+ * отрисовка.
+ *
+ * @authors lioncoco, starfrus, melonyna
+ * @version 2.0
+ * @date 2025
+ */
+
+#ifndef VERTEX_BAKER_HPP
+#define VERTEX_BAKER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "../model/bvh.hpp"
+#include "../model/metrics.hpp"
+#include "../model/model.hpp"
+#include "../model/snapshot.hpp"
+
+namespace s21 {
+
+/**
+ * @class VertexBaker
+ * @brief Фоновое Model::SetVertexTransform с объединением запросов.
+ *
+ * Пока пересчёт идёт (IsBusy()), вершины и иерархия рёбер модели
+ * принадлежат фоновому потоку: остальной код их не читает и не меняет, а
+ * отрисовка берёт вершины из GetSnapshots(). Запросы, пришедшие во время
+ * пересчёта, объединяются: следующим выполняется только последний. Перед
+ * любым другим обращением к вершинам модели (команды, смена или выгрузка
+ * модели) нужно вызвать Wait().
+ */
+class VertexBaker {
+ public:
+  using DoneCallback = std::function<void()>;
+
+  VertexBaker() = default;
+  VertexBaker(const VertexBaker&) = delete;
+  void operator=(const VertexBaker&) = delete;
+
+  /**
+   * @brief Деструктор: дожидается текущего пересчёта и останавливает поток.
+   */
+  ~VertexBaker() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+  }
+
+  /**
+   * @brief Устанавливает уведомление о публикации снимка.
+   *
+   * Вызывается в фоновом потоке после каждого пересчёта. Менять
+   * уведомление можно только без пересчёта (после Wait()).
+   *
+   * @param done Уведомление (пустое - без уведомления).
+   */
+  void SetDoneCallback(DoneCallback done) { done_ = std::move(done); }
+
+  /**
+   * @brief Запрашивает пересчёт вершин модели.
+   *
+   * Не ждёт пересчёта. Невыполненный запрос заменяется новым.
+   *
+   * @param model Модель; должна жить до завершения пересчёта.
+   * @param transform Абсолютное преобразование (Model::SetVertexTransform).
+   */
+  void Request(Model& model, const Matrix4& transform) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      model_ = &model;
+      transform_ = transform;
+      pending_ = true;
+      active_ = true;
+      busy_.store(true, std::memory_order_release);
+      if (!thread_.joinable()) thread_ = std::thread([this] { Run(); });
+    }
+    wake_.notify_one();
+  }
+
+  /**
+   * @brief Ждёт, пока все запросы выполнятся и уведомления завершатся.
+   */
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !active_; });
+  }
+
+  /**
+   * @brief Проверяет, принадлежат ли вершины модели фоновому потоку.
+   *
+   * Становится true в Request() и false после последнего пересчёта, до
+   * уведомления, поэтому в обработчике уведомления уже false, если новых
+   * запросов не было.
+   */
+  bool IsBusy() const { return busy_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Возвращает снимки пересчитанных вершин.
+   *
+   * Читатель - поток отрисовки (SnapshotBuffer::Consume()).
+   */
+  SnapshotBuffer& GetSnapshots() { return snapshots_; }
+
+ private:
+  std::thread thread_;  ///< Фоновый поток (запускается первым запросом)
+  std::mutex mutex_;    ///< Защищает запрос и флаги состояния
+  std::condition_variable wake_;  ///< Пришёл запрос или остановка
+  std::condition_variable idle_;  ///< Запросов и уведомлений не осталось
+  Model* model_ = nullptr;  ///< Модель последнего запроса
+  Matrix4 transform_;       ///< Преобразование последнего запроса
+  bool pending_ = false;    ///< Запрос ещё не взят фоновым потоком
+  bool active_ = false;     ///< Есть запрос, пересчёт или уведомление
+  bool stop_ = false;       ///< Поток нужно остановить
+  std::atomic<bool> busy_{false};  ///< Вершины модели у фонового потока
+  SnapshotBuffer snapshots_;  ///< Пересчитанные вершины для отрисовки
+  DoneCallback done_;         ///< Уведомление о публикации снимка
+
+  /**
+   * @brief Цикл фонового потока.
+   */
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait(lock, [this] { return pending_ || stop_; });
+      if (!pending_) return;
+      Model& model = *model_;
+      const Matrix4 transform = transform_;
+      pending_ = false;
+      lock.unlock();
+
+      {
+        ScopedTimer timer("bake.vertices");
+        model.SetVertexTransform(transform);
+        // AABB узлов пересчитываются здесь же, а не в потоке отрисовки
+        model.GetBvh();
+      }
+      GeometrySnapshot& snapshot = snapshots_.GetBack();
+      snapshot.vertices.assign(model.GetVertices().begin(),
+                               model.GetVertices().end());
+      snapshots_.Publish();
+
+      lock.lock();
+      if (!pending_) busy_.store(false, std::memory_order_release);
+      lock.unlock();
+      if (done_) done_();
+      lock.lock();
+      if (!pending_) {
+        active_ = false;
+        idle_.notify_all();
+      }
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // VERTEX_BAKER_HPP
@@ -0,0 +1,108 @@
+#include "../model/batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace s21 {
+
+class BatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::filesystem::create_directories(dir_ + "/nested");
+    Write(dir_ + "/b_square.obj",
+          "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n");
+    Write(dir_ + "/a_triangles.OBJ",
+          "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nf 1 2 3\nf 2 4 3\n");
+    Write(dir_ + "/c_broken.obj", "v 1 2\nf 1 2 3\n");
+    Write(dir_ + "/notes.txt", "not a model\n");
+    Write(dir_ + "/nested/d_nested.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  static void Write(const std::string& path, const std::string& text) {
+    std::ofstream out(path);
+    out << text;
+  }
+
+  std::string dir_ = "batch_test_dir";
+};
+
+TEST_F(BatchTest, CollectsObjFilesFromDirectories) {
+  const auto files = CollectModelFiles({dir_, "missing.obj"}, false);
+  ASSERT_EQ(files.size(), 4u);
+  EXPECT_EQ(files[0], dir_ + "/a_triangles.OBJ");
+  EXPECT_EQ(files[1], dir_ + "/b_square.obj");
+  EXPECT_EQ(files[2], dir_ + "/c_broken.obj");
+  EXPECT_EQ(files[3], "missing.obj");
+
+  EXPECT_EQ(CollectModelFiles({dir_}, true).size(), 4u);
+}
+
+TEST_F(BatchTest, ReportsCountsAndErrors) {
+  const auto files = CollectModelFiles({dir_, "missing.obj"}, true);
+  for (LoadMode mode : {LoadMode::kFull, LoadMode::kEdgesOnly}) {
+    BatchOptions options;
+    options.mode = mode;
+    const BatchReport report = RunBatch(files, options);
+
+    ASSERT_EQ(report.results.size(), 5u);
+    EXPECT_EQ(report.GetFailedCount(), 2u);
+
+    const BatchResult& triangles = report.results[0];
+    EXPECT_EQ(triangles.error, Model::ErrorCode::kSuccess);
+    EXPECT_EQ(triangles.vertices, 4u);
+    EXPECT_EQ(triangles.edges, 5u);
+    EXPECT_EQ(triangles.faces, 2u);
+
+    EXPECT_EQ(report.results[1].edges, 4u);
+    EXPECT_EQ(report.results[1].faces, 1u);
+    EXPECT_NE(report.results[2].error, Model::ErrorCode::kSuccess);
+    EXPECT_FALSE(report.results[2].message.empty());
+    EXPECT_EQ(report.results[3].faces, 1u);
+    EXPECT_EQ(report.results[4].error, Model::ErrorCode::kFileOpenError);
+  }
+}
+
+TEST_F(BatchTest, SkippedLineIsReported) {
+  const std::string path = dir_ + "/e_skipped.obj";
+  Write(path, "v 0 0 0\nv 1 0 0\nv 0 1 0\nv bad\nf 1 2 3\n");
+  const BatchReport report = RunBatch({path}, BatchOptions());
+
+  ASSERT_EQ(report.results.size(), 1u);
+  const BatchResult& result = report.results[0];
+  EXPECT_EQ(result.error, Model::ErrorCode::kInvalidData);
+  EXPECT_EQ(result.message.rfind("Error at line 4", 0), 0u);
+  EXPECT_EQ(result.vertices, 3u);
+  EXPECT_EQ(result.faces, 1u);
+}
+
+TEST_F(BatchTest, CallbackAndJson) {
+  BatchOptions options;
+  options.on_loaded = [](size_t index, const Model& model,
+                          BatchResult& result) {
+    result.thumbnail = std::to_string(index) + "_" +
+                       std::to_string(model.GetVertexCount()) + ".png";
+  };
+  const BatchReport report =
+      RunBatch({dir_ + "/b_square.obj", "missing.obj"}, options);
+  EXPECT_EQ(report.results[0].thumbnail, "0_4.png");
+  EXPECT_TRUE(report.results[1].thumbnail.empty());
+
+  const std::string json = BatchReportToJson(report);
+  EXPECT_EQ(json.find("{\"files\": 2, \"failed\": 1, \"threads\": "), 0u);
+  EXPECT_NE(json.find("{\"path\": \"" + dir_ +
+                      "/b_square.obj\", \"status\": \"success\", \"code\": 0, "
+                      "\"bytes\": "),
+            std::string::npos);
+  EXPECT_NE(json.find("\"vertices\": 4, \"edges\": 4, \"faces\": 1"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"thumbnail\": \"0_4.png\""), std::string::npos);
+  EXPECT_NE(json.find("\"status\": \"file_open_error\", \"code\": 1, "
+                      "\"message\": "),
+            std::string::npos);
+}
+
+}  // namespace s21
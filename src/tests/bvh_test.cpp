@@ -0,0 +1,205 @@
+#include "../model/bvh.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Модель-решётка side x side вершин в плоскости z = 0 с центром в
+ * начале координат и шагом step.
+ */
+Model MakeGridModel(uint32_t side, float step) {
+  std::vector<Vertex> vertices;
+  std::vector<Edge> edges;
+  const float offset = (static_cast<float>(side) - 1) * step / 2;
+  for (uint32_t y = 0; y < side; ++y) {
+    for (uint32_t x = 0; x < side; ++x) {
+      vertices.push_back({x * step - offset, y * step - offset, 0});
+      const uint32_t v = y * side + x;
+      if (x + 1 < side) edges.push_back({v, v + 1});
+      if (y + 1 < side) edges.push_back({v, v + side});
+    }
+  }
+  Model model;
+  model.SetMeshData("grid", std::move(vertices), {}, {}, std::move(edges));
+  return model;
+}
+
+bool Contains(const BoundingBox& box, const Vertex& v) {
+  constexpr float kEps = 1e-4f;
+  return v.x >= box.min.x - kEps && v.x <= box.max.x + kEps &&
+         v.y >= box.min.y - kEps && v.y <= box.max.y + kEps &&
+         v.z >= box.min.z - kEps && v.z <= box.max.z + kEps;
+}
+
+/**
+ * @brief Проверяет, что AABB каждого узла содержит все его рёбра.
+ */
+void ExpectBoxesCoverEdges(const Model& model, const Bvh& bvh) {
+  const auto& vertices = model.GetVertices();
+  const auto& edges = model.GetEdges();
+  for (const Bvh::Node& node : bvh.GetNodes()) {
+    for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+      const Edge& edge = edges[bvh.GetOrder()[k]];
+      ASSERT_TRUE(Contains(node.box, vertices[edge.first]));
+      ASSERT_TRUE(Contains(node.box, vertices[edge.second]));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BvhTest, BuildCoversEveryEdgeOnce) {
+  Model model = MakeGridModel(100, 0.02f);
+  const Bvh& bvh = model.GetBvh();
+  ASSERT_FALSE(bvh.IsEmpty());
+
+  std::vector<uint32_t> order = bvh.GetOrder();
+  ASSERT_EQ(order.size(), model.GetEdgeCount());
+  std::sort(order.begin(), order.end());
+  for (uint32_t i = 0; i < order.size(); ++i) ASSERT_EQ(order[i], i);
+
+  const Bvh::Node& root = bvh.GetNodes().front();
+  EXPECT_EQ(root.first, 0u);
+  EXPECT_EQ(root.count, model.GetEdgeCount());
+  EXPECT_FLOAT_EQ(bvh.GetBounds().min.x, model.GetBoundingBox().min.x);
+  EXPECT_FLOAT_EQ(bvh.GetBounds().max.y, model.GetBoundingBox().max.y);
+  for (const Bvh::Node& node : bvh.GetNodes()) {
+    if (node.right == 0) {
+      EXPECT_LE(node.count, Bvh::kLeafSize);
+    }
+  }
+  ExpectBoxesCoverEdges(model, bvh);
+
+  // Иерархия входит в память модели
+  Model copy = MakeGridModel(100, 0.02f);
+  const size_t usage = copy.GetMemoryUsage();
+  const size_t bvh_usage = copy.GetBvh().GetMemoryUsage();
+  EXPECT_GT(bvh_usage, 0u);
+  EXPECT_EQ(copy.GetMemoryUsage(), usage + bvh_usage);
+
+  Model empty;
+  EXPECT_TRUE(empty.GetBvh().IsEmpty());
+}
+
+TEST(BvhTest, FrustumCullsEdgeRanges) {
+  // Единичная матрица: видна область [-1, 1] по всем осям, модель - [-2, 2]
+  Model model = MakeGridModel(201, 0.02f);
+  const Bvh& bvh = model.GetBvh();
+  const Frustum frustum = Frustum::FromMatrix(Matrix4::Identity());
+
+  BoundingBox inside{{-0.5f, -0.5f, 0}, {0.5f, 0.5f, 0}};
+  BoundingBox outside{{1.5f, -0.5f, 0}, {2.0f, 0.5f, 0}};
+  BoundingBox crossing{{0.5f, -0.5f, 0}, {1.5f, 0.5f, 0}};
+  EXPECT_EQ(frustum.Classify(inside), Frustum::Side::kInside);
+  EXPECT_EQ(frustum.Classify(outside), Frustum::Side::kOutside);
+  EXPECT_EQ(frustum.Classify(crossing), Frustum::Side::kIntersect);
+
+  std::vector<EdgeRange> ranges;
+  const size_t visible = bvh.CollectVisible(frustum, ranges);
+  EXPECT_LT(visible, model.GetEdgeCount() / 2);
+
+  std::vector<bool> drawn(model.GetEdgeCount(), false);
+  size_t total = 0;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (i > 0) {
+      // Соседние участки слиты
+      EXPECT_GT(ranges[i].first, ranges[i - 1].first + ranges[i - 1].count);
+    }
+    for (uint32_t k = ranges[i].first; k < ranges[i].first + ranges[i].count;
+         ++k) {
+      drawn[bvh.GetOrder()[k]] = true;
+    }
+    total += ranges[i].count;
+  }
+  EXPECT_EQ(total, visible);
+
+  const auto& vertices = model.GetVertices();
+  const auto& edges = model.GetEdges();
+  for (size_t i = 0; i < edges.size(); ++i) {
+    const Vertex& a = vertices[edges[i].first];
+    const Vertex& b = vertices[edges[i].second];
+    if (std::max({std::abs(a.x), std::abs(a.y), std::abs(b.x),
+                  std::abs(b.y)}) <= 1.0f) {
+      ASSERT_TRUE(drawn[i]) << "видимое ребро отсечено: " << i;
+    }
+  }
+
+  // Раскрытие узлов ограничено снизу: участков не больше, чем без ограничения
+  std::vector<EdgeRange> coarse;
+  EXPECT_GE(bvh.CollectVisible(frustum, coarse, 4096), visible);
+  EXPECT_LE(coarse.size(), ranges.size());
+}
+
+TEST(BvhTest, TransformUpdatesBoxesWithoutRebuild) {
+  Model model = MakeGridModel(60, 0.05f);
+  const Bvh& bvh = model.GetBvh();
+  const std::vector<uint32_t> order = bvh.GetOrder();
+
+  model.TransformVertices(Matrix4::Translation(1.0f, -2.0f, 0.5f));
+  model.TransformVertices(Matrix4::Scale(3.0f));
+  // Обновление по узлам: порядок рёбер и узлы остаются прежними
+  EXPECT_EQ(model.GetBvh().GetOrder(), order);
+  EXPECT_NEAR(bvh.GetBounds().min.x, model.GetBoundingBox().min.x, 1e-4f);
+  EXPECT_NEAR(bvh.GetBounds().max.y, model.GetBoundingBox().max.y, 1e-4f);
+  EXPECT_NEAR(bvh.GetBounds().min.z, 1.5f, 1e-4f);
+  ExpectBoxesCoverEdges(model, bvh);
+
+  model.TransformVertices(Matrix4::Rotation(30.0f, 45.0f, 10.0f));
+  EXPECT_EQ(model.GetBvh().GetOrder(), order);
+  ExpectBoxesCoverEdges(model, model.GetBvh());
+
+  for (Vertex& v : model.GetMutableVertices()) v.z += 10.0f;
+  EXPECT_NEAR(model.GetBvh().GetBounds().min.z,
+              model.GetBoundingBox().min.z, 1e-4f);
+  ExpectBoxesCoverEdges(model, model.GetBvh());
+}
+
+TEST(BvhTest, PicksVertexAndEdgeUnderCursor) {
+  // Шаг 0.1: при области 200x200 пикселей соседние вершины в 10 пикселях
+  Model model = MakeGridModel(11, 0.1f);
+  const Bvh& bvh = model.GetBvh();
+  const Matrix4 mvp = Matrix4::Identity();
+  const auto& vertices = model.GetVertices();
+  const auto& edges = model.GetEdges();
+
+  PickQuery query{100, 100, 200, 200, 3};
+  PickResult result = bvh.Pick(vertices, edges, mvp, query);
+  ASSERT_EQ(result.kind, PickResult::Kind::kVertex);
+  EXPECT_NEAR(vertices[result.vertex].x, 0.0f, 1e-5f);
+  EXPECT_NEAR(vertices[result.vertex].y, 0.0f, 1e-5f);
+
+  // Середина горизонтального ребра справа от центра; Y экрана вниз
+  query.x = 105;
+  query.y = 99;
+  result = bvh.Pick(vertices, edges, mvp, query);
+  ASSERT_EQ(result.kind, PickResult::Kind::kEdge);
+  const Edge& edge = edges[result.edge];
+  EXPECT_NEAR(vertices[edge.first].y, 0.0f, 1e-5f);
+  EXPECT_NEAR(vertices[edge.second].y, 0.0f, 1e-5f);
+  EXPECT_NEAR(vertices[edge.first].x + vertices[edge.second].x, 0.1f, 1e-5f);
+  EXPECT_NEAR(result.distance, 1.0f, 1e-3f);
+
+  // Между рёбрами и за пределами модели ничего нет
+  query.x = 105;
+  query.y = 95;
+  EXPECT_EQ(bvh.Pick(vertices, edges, mvp, query).kind,
+            PickResult::Kind::kNone);
+  query.x = 5;
+  query.y = 5;
+  EXPECT_EQ(bvh.Pick(vertices, edges, mvp, query).kind,
+            PickResult::Kind::kNone);
+
+  // Модель за дальней плоскостью отсечения не выбирается
+  const Matrix4 far = Matrix4::Translation(0, 0, 5.0f);
+  query.x = 100;
+  query.y = 100;
+  EXPECT_EQ(bvh.Pick(vertices, edges, far, query).kind,
+            PickResult::Kind::kNone);
+}
+
+}  // namespace s21
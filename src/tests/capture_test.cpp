@@ -0,0 +1,317 @@
+#include "../model/capture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <thread>
+
+#include "../patterns/frame_recorder.hpp"
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @struct DecodedGif
+ * @brief Кадры GIF: индексы палитры строками сверху вниз.
+ */
+struct DecodedGif {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<std::vector<uint8_t>> frames;
+  std::vector<uint16_t> delays;
+};
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), {});
+}
+
+/**
+ * @brief Распаковывает LZW по описанию формата GIF89a.
+ */
+bool DecodeLzw(const std::vector<uint8_t>& data, uint32_t min_size,
+               size_t pixels, std::vector<uint8_t>& out) {
+  const uint32_t clear = 1u << min_size;
+  const uint32_t end = clear + 1;
+  std::vector<uint16_t> prefix(4096);
+  std::vector<uint8_t> suffix(4096), first(4096);
+  for (uint32_t i = 0; i < clear; ++i) suffix[i] = first[i] = i;
+
+  uint32_t size = min_size + 1, next = end + 1;
+  int prev = -1;
+  size_t bit = 0;
+  std::vector<uint8_t> entry;
+  while (bit + size <= data.size() * 8) {
+    uint32_t code = 0;
+    for (uint32_t i = 0; i < size; ++i, ++bit) {
+      code |= ((data[bit / 8] >> (bit % 8)) & 1u) << i;
+    }
+    if (code == clear) {
+      size = min_size + 1;
+      next = end + 1;
+      prev = -1;
+      continue;
+    }
+    if (code == end) return out.size() == pixels;
+    if (prev < 0) {
+      if (code >= clear) return false;
+      out.push_back(static_cast<uint8_t>(code));
+      prev = static_cast<int>(code);
+      continue;
+    }
+    if (code > next || (code == next && next >= 4096)) return false;
+    const uint32_t source = code < next ? code : static_cast<uint32_t>(prev);
+    entry.clear();
+    for (uint32_t c = source;; c = prefix[c]) {
+      entry.push_back(suffix[c]);
+      if (c < clear) break;
+    }
+    const uint8_t head = entry.back();
+    out.insert(out.end(), entry.rbegin(), entry.rend());
+    if (code == next) out.push_back(head);
+    if (next < 4096) {
+      prefix[next] = static_cast<uint16_t>(prev);
+      suffix[next] = code < next ? first[code] : first[prev];
+      first[next] = first[prev];
+      ++next;
+      if (next == (1u << size) && size < 12) ++size;
+    }
+    prev = static_cast<int>(code);
+  }
+  return false;
+}
+
+bool DecodeGif(const std::string& path, DecodedGif& gif) {
+  const std::vector<uint8_t> file = ReadFile(path);
+  if (file.size() < 13 || std::string(file.begin(), file.begin() + 6) !=
+                              "GIF89a")
+    return false;
+  auto u16 = [&file](size_t at) {
+    return static_cast<uint16_t>(file[at] | (file[at + 1] << 8));
+  };
+  gif.width = u16(6);
+  gif.height = u16(8);
+  size_t at = 13;
+  if (file[10] & 0x80) at += 3u << ((file[10] & 7) + 1);
+
+  uint16_t delay = 0;
+  while (at < file.size()) {
+    const uint8_t type = file[at++];
+    if (type == 0x3B) return true;
+    if (type == 0x21) {
+      const uint8_t label = file[at++];
+      if (label == 0xF9) delay = u16(at + 2);
+      while (file[at] != 0) at += file[at] + 1;
+      ++at;
+    } else if (type == 0x2C) {
+      if (u16(at + 4) != gif.width || u16(at + 6) != gif.height) return false;
+      at += 9;
+      const uint32_t min_size = file[at++];
+      std::vector<uint8_t> data;
+      while (file[at] != 0) {
+        data.insert(data.end(), file.begin() + at + 1,
+                    file.begin() + at + 1 + file[at]);
+        at += file[at] + 1;
+      }
+      ++at;
+      std::vector<uint8_t> indices;
+      if (!DecodeLzw(data, min_size,
+                     static_cast<size_t>(gif.width) * gif.height, indices))
+        return false;
+      gif.frames.push_back(std::move(indices));
+      gif.delays.push_back(delay);
+    } else {
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Кадр из цветов палитры GIF; indices - сверху вниз.
+ */
+CaptureFrame PaletteFrame(uint32_t width, uint32_t height,
+                          const std::vector<uint8_t>& indices) {
+  const std::vector<uint8_t>& palette = GifPalette();
+  CaptureFrame frame;
+  frame.Resize(width, height);
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      const uint8_t index = indices[y * width + x];
+      // Строки кадра снизу вверх
+      uint8_t* pixel = &frame.pixels[((height - 1 - y) * width + x) * 4];
+      pixel[0] = palette[index * 3];
+      pixel[1] = palette[index * 3 + 1];
+      pixel[2] = palette[index * 3 + 2];
+      pixel[3] = 255;
+    }
+  }
+  return frame;
+}
+
+}  // namespace
+
+TEST(CaptureTest, GifRoundTripsPaletteColors) {
+  constexpr uint32_t kWidth = 211, kHeight = 173;
+  std::mt19937 random(7);
+  std::vector<uint8_t> noise(kWidth * kHeight), bands(kWidth * kHeight);
+  for (uint8_t& index : noise) index = random() % 252;
+  for (uint32_t i = 0; i < bands.size(); ++i) bands[i] = (i / 997) % 252;
+
+  // Шум переполняет словарь (коды очистки), полосы дают длинные цепочки
+  const std::string file = "capture_test.gif";
+  GifWriter writer;
+  ASSERT_TRUE(writer.Open(file, kWidth, kHeight));
+  ASSERT_TRUE(writer.AddFrame(
+      EncodeGifFrame(PaletteFrame(kWidth, kHeight, noise), 10)));
+  ASSERT_TRUE(writer.AddFrame(
+      EncodeGifFrame(PaletteFrame(kWidth, kHeight, bands), 25)));
+  EXPECT_EQ(writer.GetFrameCount(), 2u);
+  ASSERT_TRUE(writer.Close());
+
+  DecodedGif gif;
+  ASSERT_TRUE(DecodeGif(file, gif));
+  EXPECT_EQ(gif.width, kWidth);
+  EXPECT_EQ(gif.height, kHeight);
+  ASSERT_EQ(gif.frames.size(), 2u);
+  EXPECT_EQ(gif.frames[0], noise);
+  EXPECT_EQ(gif.frames[1], bands);
+  EXPECT_EQ(gif.delays, (std::vector<uint16_t>{10, 25}));
+  std::remove(file.c_str());
+
+  CaptureFrame empty;
+  EXPECT_TRUE(EncodeGifFrame(empty, 10).empty());
+  EXPECT_FALSE(writer.Open(file, 0, 10));
+}
+
+TEST(CaptureTest, WritesBottomUpBmp) {
+  CaptureFrame frame;
+  frame.Resize(3, 2);
+  for (size_t i = 0; i < frame.pixels.size(); ++i) {
+    frame.pixels[i] = static_cast<uint8_t>(i * 10);
+  }
+  const std::string file = "capture_test.bmp";
+  ASSERT_TRUE(WriteBmp(frame, file));
+  const std::vector<uint8_t> bmp = ReadFile(file);
+  std::remove(file.c_str());
+
+  // Строка - 9 байт BGR, выровнена до 12
+  ASSERT_EQ(bmp.size(), 54u + 12u * 2u);
+  EXPECT_EQ(bmp[0], 'B');
+  EXPECT_EQ(bmp[1], 'M');
+  EXPECT_EQ(bmp[18], 3);  // Ширина
+  EXPECT_EQ(bmp[22], 2);  // Высота: положительная, строки снизу вверх
+  EXPECT_EQ(bmp[28], 24);
+  for (size_t y = 0; y < 2; ++y) {
+    for (size_t x = 0; x < 3; ++x) {
+      const uint8_t* pixel = &frame.pixels[(y * 3 + x) * 4];
+      const uint8_t* stored = &bmp[54 + y * 12 + x * 3];
+      EXPECT_EQ(stored[0], pixel[2]);
+      EXPECT_EQ(stored[1], pixel[1]);
+      EXPECT_EQ(stored[2], pixel[0]);
+    }
+  }
+  EXPECT_FALSE(WriteBmp(CaptureFrame(), file));
+  EXPECT_EQ(CaptureFramePath("turntable", 7, CaptureFormat::kJpeg),
+            "turntable_0007.jpg");
+}
+
+TEST(FrameRecorderTest, RecordsGifInSubmissionOrder) {
+  constexpr uint32_t kWidth = 64, kHeight = 48;
+  constexpr size_t kFrames = 30;
+  const std::string file = "frame_recorder_test.gif";
+  FrameRecorder recorder;
+  RecordOptions options{CaptureFormat::kGif, file, 20};
+  options.queue_limit = kFrames;
+  ASSERT_TRUE(recorder.Start(options));
+  EXPECT_TRUE(recorder.IsRecording());
+
+  for (size_t i = 0; i < kFrames; ++i) {
+    CaptureFrame frame = recorder.AcquireFrame();
+    frame = PaletteFrame(kWidth, kHeight,
+                         std::vector<uint8_t>(kWidth * kHeight, i * 7));
+    ASSERT_TRUE(recorder.Submit(std::move(frame)));
+  }
+  // Кадр другого размера пропускается
+  CaptureFrame small;
+  small.Resize(8, 8);
+  EXPECT_FALSE(recorder.Submit(std::move(small)));
+
+  const RecordStats stats = recorder.Stop();
+  EXPECT_FALSE(recorder.IsRecording());
+  EXPECT_EQ(stats.frames_written, kFrames);
+  EXPECT_EQ(stats.frames_dropped, 1u);
+  EXPECT_FALSE(stats.error);
+
+  DecodedGif gif;
+  ASSERT_TRUE(DecodeGif(file, gif));
+  ASSERT_EQ(gif.frames.size(), kFrames);
+  for (size_t i = 0; i < kFrames; ++i) {
+    EXPECT_EQ(gif.frames[i][0], i * 7) << i;
+    EXPECT_EQ(gif.delays[i], 5) << i;  // 20 кадров в секунду
+  }
+  std::remove(file.c_str());
+}
+
+TEST(FrameRecorderTest, StopsAfterFrameLimit) {
+  FrameRecorder recorder;
+  RecordOptions options{CaptureFormat::kBmp, "frame_recorder_test", 10, 3};
+  std::atomic<bool> done{false};
+  ASSERT_TRUE(recorder.Start(options, nullptr, [&done] { done = true; }));
+  for (int i = 0; i < 3; ++i) {
+    CaptureFrame frame;
+    frame.Resize(4, 4);
+    ASSERT_TRUE(recorder.Submit(std::move(frame)));
+  }
+  EXPECT_FALSE(recorder.IsRecording());
+  CaptureFrame extra;
+  extra.Resize(4, 4);
+  EXPECT_FALSE(recorder.Submit(std::move(extra)));
+
+  while (!done) std::this_thread::yield();
+  EXPECT_EQ(recorder.Stop().frames_written, 3u);
+  for (size_t i = 0; i < 3; ++i) {
+    const std::string path =
+        CaptureFramePath(options.path, i, CaptureFormat::kBmp);
+    EXPECT_EQ(ReadFile(path).size(), 54u + 12u * 4u) << path;
+    std::remove(path.c_str());
+  }
+
+  // Для JPEG кодировщик задаёт вызывающий
+  options.format = CaptureFormat::kJpeg;
+  EXPECT_FALSE(recorder.Start(options));
+}
+
+TEST(FrameRecorderTest, DropsFramesInsteadOfBlocking) {
+  FrameRecorder recorder;
+  RecordOptions options{CaptureFormat::kBmp, "unused", 10};
+  options.queue_limit = 1;
+  std::atomic<bool> release{false};
+  std::atomic<int> calls{0};
+  auto writer = [&](const CaptureFrame&, const std::string&) {
+    ++calls;
+    while (!release) std::this_thread::yield();
+    return true;
+  };
+  ASSERT_TRUE(recorder.Start(options, writer));
+
+  // Кодировщик занят: очередь в один кадр переполняется, Submit не ждёт
+  constexpr size_t kFrames = 10;
+  for (size_t i = 0; i < kFrames; ++i) {
+    CaptureFrame frame;
+    frame.Resize(2, 2);
+    recorder.Submit(std::move(frame));
+  }
+  release = true;
+  const RecordStats stats = recorder.Stop();
+  EXPECT_GE(stats.frames_dropped, kFrames - 2);
+  EXPECT_EQ(stats.frames_written + stats.frames_dropped, kFrames);
+  EXPECT_EQ(static_cast<size_t>(calls), stats.frames_written);
+}
+
+}  // namespace s21
@@ -0,0 +1,144 @@
+#include "../model/lod.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "../patterns/lod_builder.hpp"
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Каркас квадратной решётки side x side вершин в плоскости z = 0.
+ */
+void MakeGrid(uint32_t side, std::vector<Vertex>& vertices,
+              std::vector<Edge>& edges) {
+  for (uint32_t y = 0; y < side; ++y) {
+    for (uint32_t x = 0; x < side; ++x) {
+      vertices.push_back({static_cast<float>(x), static_cast<float>(y), 0});
+      const uint32_t v = y * side + x;
+      if (x + 1 < side) edges.push_back({v, v + 1});
+      if (y + 1 < side) edges.push_back({v, v + side});
+    }
+  }
+}
+
+}  // namespace
+
+TEST(LodTest, LevelsShrinkAndStayValid) {
+  std::vector<Vertex> vertices;
+  std::vector<Edge> edges;
+  MakeGrid(300, vertices, edges);
+
+  LodOptions options;
+  options.min_edges = 0;
+  options.min_grid = 8;
+  const LodSet set = BuildLodSet(vertices, edges, options);
+
+  EXPECT_FLOAT_EQ(set.extent, 299.0f);
+  ASSERT_FALSE(set.levels.empty());
+  size_t finer_edges = edges.size();
+  uint32_t finer_grid = 1025;
+  for (const LodLevel& level : set.levels) {
+    EXPECT_LT(level.grid, finer_grid);
+    EXPECT_LE(level.edges.size(), finer_edges / 2);
+    EXPECT_FALSE(level.edges.empty());
+    EXPECT_LE(level.vertices.size(),
+              static_cast<size_t>(level.grid) * level.grid);
+    for (const Edge& edge : level.edges) {
+      ASSERT_LT(edge.first, edge.second);
+      ASSERT_LT(edge.second, level.vertices.size());
+    }
+    for (const Vertex& v : level.vertices) {
+      ASSERT_GE(v.x, 0.0f);
+      ASSERT_LE(v.x, 299.0f);
+      ASSERT_EQ(v.z, 0.0f);
+    }
+    finer_grid = level.grid;
+    finer_edges = level.edges.size();
+  }
+  EXPECT_EQ(set.levels.back().grid, 8u);
+  // Решётка 8x8 ячеек: 8x8 вершин и 2 * 8 * 7 рёбер
+  EXPECT_EQ(set.levels.back().vertices.size(), 64u);
+  EXPECT_EQ(set.levels.back().edges.size(), 112u);
+}
+
+TEST(LodTest, SelectLevelByScreenSize) {
+  LodSet set;
+  for (uint32_t grid : {256u, 64u, 16u}) {
+    LodLevel level;
+    level.grid = grid;
+    set.levels.push_back(level);
+  }
+  EXPECT_EQ(set.SelectLevel(10), 2);
+  EXPECT_EQ(set.SelectLevel(16), 2);
+  EXPECT_EQ(set.SelectLevel(17), 1);
+  EXPECT_EQ(set.SelectLevel(200), 0);
+  EXPECT_EQ(set.SelectLevel(257), -1);
+  EXPECT_EQ(set.SelectLevel(500, 2.0f), 0);
+  EXPECT_EQ(LodSet().SelectLevel(1), -1);
+}
+
+TEST(LodTest, SmallOrCancelledBuildIsEmpty) {
+  std::vector<Vertex> vertices;
+  std::vector<Edge> edges;
+  MakeGrid(50, vertices, edges);
+
+  EXPECT_TRUE(BuildLodSet(vertices, edges).levels.empty());
+
+  std::atomic<bool> cancel{true};
+  LodOptions options;
+  options.min_edges = 0;
+  options.cancel = &cancel;
+  EXPECT_TRUE(BuildLodSet(vertices, edges, options).levels.empty());
+}
+
+TEST(LodTest, SingleCellCollapsesModel) {
+  std::vector<Vertex> vertices = {{0, 0, 0}, {2, 0, 0}, {0, 2, 0}, {2, 2, 2}};
+  std::vector<Edge> edges = {{0, 1}, {1, 2}, {0, 2}, {2, 3}};
+  BoundingBox box{{0, 0, 0}, {2, 2, 2}};
+
+  const LodLevel level = BuildLodLevel(vertices, edges, box, 1);
+  ASSERT_EQ(level.vertices.size(), 1u);
+  EXPECT_TRUE(level.edges.empty());
+  EXPECT_EQ(level.vertices[0], (Vertex{1.0f, 1.0f, 0.5f}));
+
+  const LodLevel fine = BuildLodLevel(vertices, edges, box, 2);
+  EXPECT_EQ(fine.vertices.size(), 4u);
+  EXPECT_EQ(fine.edges.size(), 4u);
+}
+
+TEST(LodTest, BuilderRunsInBackground) {
+  std::vector<Vertex> vertices;
+  std::vector<Edge> edges;
+  MakeGrid(100, vertices, edges);
+  Model model;
+  model.SetMeshData("grid.obj", vertices, {}, {}, edges);
+
+  LodOptions options;
+  options.min_edges = 0;
+  std::atomic<bool> done{false};
+  LodBuilder builder;
+  builder.Start(model, [&done] { done = true; }, options);
+  builder.Stop();
+  EXPECT_TRUE(done);
+
+  LodSet set;
+  EXPECT_FALSE(builder.TakeResult("grid.obj", set));
+
+  builder.Start(model, nullptr, options);
+  while (!builder.TakeResult("grid.obj", set)) std::this_thread::yield();
+  EXPECT_FALSE(set.levels.empty());
+  EXPECT_EQ(set.levels.front().edges.size(),
+            BuildLodSet(vertices, edges, options).levels.front().edges.size());
+
+  done = false;
+  builder.Start(model, [&done] { done = true; }, options);
+  while (!done) std::this_thread::yield();
+  EXPECT_FALSE(builder.TakeResult("other.obj", set));
+}
+
+}  // namespace s21
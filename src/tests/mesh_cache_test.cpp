@@ -0,0 +1,124 @@
+#include "../model/mesh_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "../patterns/model_manager.hpp"
+
+namespace s21 {
+
+class MeshCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    directory_ = (std::filesystem::temp_directory_path() / "s21_mesh_cache")
+                     .string();
+    std::filesystem::remove_all(directory_);
+    WriteSource("v 0 0 0\nv 2 0 0\nv 2 2 0\nv 0 2 0\nf 1 2 3 4\nf 1 3 4\n");
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(directory_);
+    std::remove(source_.c_str());
+    ModelManager::GetInstance().SetMeshCache(MeshCache());
+    ModelManager::GetInstance().Clear();
+  }
+
+  void WriteSource(const std::string& text) {
+    std::ofstream out(source_);
+    out << text;
+  }
+
+  std::string directory_;
+  std::string source_ = "mesh_cache_test.obj";
+};
+
+TEST_F(MeshCacheTest, StoreAndLoadRoundTrip) {
+  MeshCache cache(directory_);
+  Model parsed;
+  ASSERT_TRUE(parsed.LoadFromFile(source_));
+  parsed.NormalizeModel();
+  ASSERT_TRUE(cache.Store(source_, parsed));
+
+  Model cached;
+  ASSERT_TRUE(cache.Load(source_, cached));
+  EXPECT_EQ(cached.GetLastError(), Model::ErrorCode::kSuccess);
+  EXPECT_EQ(cached.GetPathFile(), source_);
+  EXPECT_EQ(cached.GetVertices(), parsed.GetVertices());
+  EXPECT_EQ(cached.GetFaceIndices(), parsed.GetFaceIndices());
+  EXPECT_EQ(cached.GetFaceOffsets(), parsed.GetFaceOffsets());
+  ASSERT_EQ(cached.GetEdgeCount(), parsed.GetEdgeCount());
+  for (size_t i = 0; i < parsed.GetEdgeCount(); ++i) {
+    EXPECT_EQ(cached.GetEdges()[i].first, parsed.GetEdges()[i].first);
+    EXPECT_EQ(cached.GetEdges()[i].second, parsed.GetEdges()[i].second);
+  }
+}
+
+TEST_F(MeshCacheTest, ChangedSourceInvalidatesCache) {
+  MeshCache cache(directory_);
+  Model parsed;
+  ASSERT_TRUE(parsed.LoadFromFile(source_));
+  ASSERT_TRUE(cache.Store(source_, parsed));
+
+  WriteSource("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  Model cached;
+  EXPECT_FALSE(cache.Load(source_, cached));
+  EXPECT_EQ(cached.GetVertexCount(), 0u);
+}
+
+TEST_F(MeshCacheTest, CorruptedCacheIsRejected) {
+  MeshCache cache(directory_);
+  Model parsed;
+  ASSERT_TRUE(parsed.LoadFromFile(source_));
+  ASSERT_TRUE(cache.Store(source_, parsed));
+
+  const std::string path = cache.CachePath(source_);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+  Model cached;
+  EXPECT_FALSE(cache.Load(source_, cached));
+
+  EXPECT_FALSE(MeshCache().Load(source_, cached));  // Кэш выключен
+}
+
+TEST_F(MeshCacheTest, ModelManagerUsesCache) {
+  ModelManager& manager = ModelManager::GetInstance();
+  manager.SetMeshCache(MeshCache(directory_));
+
+  ASSERT_TRUE(manager.LoadModel(source_));
+  const auto first = manager.GetModel()->GetVertices();
+  EXPECT_TRUE(std::filesystem::exists(manager.GetMeshCache().CachePath(source_)));
+
+  // Повторная загрузка из кэша даёт ту же нормализованную модель
+  ASSERT_TRUE(manager.LoadModel(source_));
+  EXPECT_EQ(manager.GetModel()->GetVertices(), first);
+  EXPECT_EQ(manager.GetModel()->GetEdgeCount(), 5u);
+  EXPECT_NEAR(manager.GetModel()->GetBoundingBox().Radius(), 1.0f, 1e-5f);
+}
+
+TEST_F(MeshCacheTest, SkippedLineDoesNotFailLoad) {
+  ModelManager& manager = ModelManager::GetInstance();
+  manager.SetMeshCache(MeshCache(directory_));
+  WriteSource("v 0 0 0\nv 2 0 0\nv 2 2 0\nv bad vertex\nf 1 2 3\n");
+
+  // Ошибочная строка пропускается, её описание остаётся предупреждением
+  ASSERT_TRUE(manager.LoadModel(source_));
+  EXPECT_EQ(manager.GetModel()->GetLastError(),
+            Model::ErrorCode::kInvalidData);
+  EXPECT_TRUE(manager.IsResident(source_));
+  EXPECT_EQ(manager.GetModel()->GetVertexCount(), 3);
+  const std::string warning = manager.GetModel()->GetLastErrorString();
+
+  // Повторно модель открывается так же из памяти и из файла: в кэш сеток
+  // модель с предупреждением не попадает
+  EXPECT_TRUE(manager.LoadModel(source_));
+  EXPECT_EQ(manager.GetModel()->GetVertexCount(), 3);
+  EXPECT_FALSE(
+      std::filesystem::exists(manager.GetMeshCache().CachePath(source_)));
+  manager.Clear();
+  EXPECT_TRUE(manager.LoadModel(source_));
+  EXPECT_EQ(manager.GetModel()->GetVertexCount(), 3);
+  EXPECT_EQ(manager.GetModel()->GetLastErrorString(), warning);
+}
+
+}  // namespace s21
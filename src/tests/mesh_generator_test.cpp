@@ -0,0 +1,102 @@
+#include "../model/mesh_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Индексы всех полигонов модели подряд.
+ */
+std::vector<uint32_t> FaceIndices(const Model& model) {
+  std::vector<uint32_t> indices;
+  for (const Polygon& polygon : model.GetPolygons()) {
+    indices.insert(indices.end(), polygon.vertex_indices.begin(),
+                   polygon.vertex_indices.end());
+  }
+  return indices;
+}
+
+}  // namespace
+
+TEST(MeshGeneratorTest, ParsesSpec) {
+  MeshSpec spec;
+  ASSERT_TRUE(ParseMeshSpec("soup:5000:6:full", spec));
+  EXPECT_EQ(spec.shape, MeshShape::kSoup);
+  EXPECT_EQ(spec.faces, 5000u);
+  EXPECT_EQ(spec.sides, 6u);
+  EXPECT_EQ(spec.format, FaceFormat::kFull);
+  EXPECT_EQ(MeshSpecName(spec), "soup:5000:6:full");
+
+  for (const char* bad : {"", "grid", "cube:10", "grid:0", "grid:10:2",
+                          "grid:10x", "grid:10:4:obj", "grid:1:4:full:1"}) {
+    EXPECT_FALSE(ParseMeshSpec(bad, spec)) << bad;
+  }
+  EXPECT_EQ(MeshSpecName(spec), "soup:5000:6:full");
+}
+
+TEST(MeshGeneratorTest, BuildsValidShapes) {
+  for (const char* text : {"grid:1000:3", "grid:1000:4", "grid:999:8",
+                           "sphere:2000:3", "sphere:2000:4", "soup:300:7"}) {
+    MeshSpec spec;
+    ASSERT_TRUE(ParseMeshSpec(text, spec));
+    const MeshGenerator generator(spec);
+    Model model;
+    ASSERT_TRUE(GenerateMesh(spec, model)) << text;
+    EXPECT_TRUE(model.IsValid()) << text;
+    EXPECT_EQ(model.GetVertexCount(), generator.GetVertexCount()) << text;
+    EXPECT_EQ(model.GetPolygonCount(), generator.GetFaceCount()) << text;
+    if (spec.shape != MeshShape::kSphere) {
+      EXPECT_EQ(model.GetPolygonCount(), spec.faces) << text;
+    }
+    for (const Polygon& polygon : model.GetPolygons()) {
+      ASSERT_TRUE(polygon.IsValid(model.GetVertexCount())) << text;
+    }
+  }
+}
+
+TEST(MeshGeneratorTest, SphereIsClosed) {
+  MeshSpec spec{MeshShape::kSphere, 5000};
+  Model model;
+  ASSERT_TRUE(GenerateMesh(spec, model));
+  // Замкнутая поверхность рода 0: V - E + F = 2
+  const auto euler = static_cast<long>(model.GetVertexCount()) -
+                     static_cast<long>(model.GetEdgeCount()) +
+                     static_cast<long>(model.GetPolygonCount());
+  EXPECT_EQ(euler, 2);
+  EXPECT_NEAR(static_cast<double>(model.GetPolygonCount()), 5000.0, 500.0);
+}
+
+TEST(MeshGeneratorTest, WrittenFileMatchesGeneratedModel) {
+  const std::string file = "mesh_generator_test.obj";
+  for (auto format : {FaceFormat::kIndex, FaceFormat::kTexture,
+                      FaceFormat::kNormal, FaceFormat::kFull}) {
+    for (const MeshSpec base : {MeshSpec{MeshShape::kGrid, 500, 6},
+                                MeshSpec{MeshShape::kSoup, 200, 5}}) {
+      MeshSpec spec = base;
+      spec.format = format;
+      const std::string name = MeshSpecName(spec);
+
+      Model generated, loaded;
+      ASSERT_TRUE(GenerateMesh(spec, generated)) << name;
+      ASSERT_TRUE(WriteMeshObj(spec, file)) << name;
+      ASSERT_TRUE(loaded.LoadFromFile(file)) << name;
+
+      EXPECT_EQ(loaded.GetVertexCount(), generated.GetVertexCount()) << name;
+      EXPECT_EQ(FaceIndices(loaded), FaceIndices(generated)) << name;
+      EXPECT_EQ(loaded.GetEdgeCount(), generated.GetEdgeCount()) << name;
+      const Vertex a = loaded.GetVertices().back();
+      const Vertex b = generated.GetVertices().back();
+      EXPECT_FLOAT_EQ(a.x, b.x) << name;
+      EXPECT_FLOAT_EQ(a.y, b.y) << name;
+      EXPECT_FLOAT_EQ(a.z, b.z) << name;
+    }
+  }
+  std::remove(file.c_str());
+}
+
+}  // namespace s21
@@ -0,0 +1,111 @@
+#include "../model/metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "../model/model.hpp"
+#include "../patterns/command.hpp"
+
+namespace s21 {
+
+class MetricsTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Metrics::GetInstance().Reset(); }
+
+  void TearDown() override {
+    Metrics::GetInstance().SetEnabled(true);
+    Metrics::GetInstance().Reset();
+  }
+};
+
+TEST_F(MetricsTest, SummaryAndPercentiles) {
+  auto& metrics = Metrics::GetInstance();
+  for (int i = 1; i <= 100; ++i) metrics.Record("test.value", i);
+
+  MetricSummary summary;
+  ASSERT_TRUE(metrics.GetSummary("test.value", summary));
+  EXPECT_EQ(summary.count, 100u);
+  EXPECT_DOUBLE_EQ(summary.total, 5050);
+  EXPECT_DOUBLE_EQ(summary.min, 1);
+  EXPECT_DOUBLE_EQ(summary.max, 100);
+  EXPECT_DOUBLE_EQ(summary.mean, 50.5);
+  EXPECT_DOUBLE_EQ(summary.p50, 50);
+  EXPECT_DOUBLE_EQ(summary.p99, 99);
+  EXPECT_DOUBLE_EQ(summary.last, 100);
+
+  EXPECT_FALSE(metrics.GetSummary("test.missing", summary));
+}
+
+TEST_F(MetricsTest, PercentilesUseRecentWindow) {
+  auto& metrics = Metrics::GetInstance();
+  for (size_t i = 0; i < Metrics::kWindowSize; ++i) metrics.Record("t", 1000);
+  for (size_t i = 0; i < Metrics::kWindowSize; ++i) metrics.Record("t", 1);
+
+  MetricSummary summary;
+  ASSERT_TRUE(metrics.GetSummary("t", summary));
+  EXPECT_EQ(summary.count, 2 * Metrics::kWindowSize);
+  EXPECT_DOUBLE_EQ(summary.max, 1000);
+  EXPECT_DOUBLE_EQ(summary.p99, 1);
+}
+
+TEST_F(MetricsTest, DisabledMetricsAreNotRecorded) {
+  auto& metrics = Metrics::GetInstance();
+  metrics.SetEnabled(false);
+  metrics.Record("test.value", 1);
+  { ScopedTimer timer("test.timer"); }
+
+  EXPECT_TRUE(metrics.GetSummaries().empty());
+}
+
+TEST_F(MetricsTest, LoadAndCommandsAreTimed) {
+  const std::string file = "metrics_test.obj";
+  std::ofstream out(file);
+  out << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+  out.close();
+
+  ASSERT_TRUE(ModelManager::GetInstance().LoadModelForTest(file));
+  ModelManager::GetInstance().GetModel()->NormalizeModel();
+  MoveCommand(1, 0, 0).Execute();
+
+  auto& metrics = Metrics::GetInstance();
+  MetricSummary summary;
+  for (const char* name : {"load.total", "load.parse", "load.merge",
+                           "model.extract_edges", "model.normalize",
+                           "command.move"}) {
+    EXPECT_TRUE(metrics.GetSummary(name, summary)) << name;
+    EXPECT_GE(summary.min, 0) << name;
+  }
+
+  ModelManager::GetInstance().Clear();
+  ModelManager::GetInstance().LoadModelForTest("");
+  std::remove(file.c_str());
+}
+
+TEST_F(MetricsTest, ExportFormats) {
+  auto& metrics = Metrics::GetInstance();
+  metrics.Record("b.second", 2);
+  metrics.Record("a.first", 0.5);
+
+  EXPECT_EQ(metrics.ToCsv(),
+            "name,count,total,min,max,mean,p50,p99,last\n"
+            "a.first,1,0.5,0.5,0.5,0.5,0.5,0.5,0.5\n"
+            "b.second,1,2,2,2,2,2,2,2\n");
+
+  const std::string json = metrics.ToJson();
+  EXPECT_EQ(json.find("{\"metrics\": ["), 0u);
+  EXPECT_NE(json.find("{\"name\": \"a.first\", \"count\": 1, \"total\": 0.5"),
+            std::string::npos);
+  EXPECT_LT(json.find("a.first"), json.find("b.second"));
+
+  const std::string path = "metrics_test.csv";
+  ASSERT_TRUE(metrics.WriteToFile(path));
+  std::ifstream in(path);
+  std::stringstream content;
+  content << in.rdbuf();
+  EXPECT_EQ(content.str(), metrics.ToCsv());
+  std::remove(path.c_str());
+}
+
+}  // namespace s21
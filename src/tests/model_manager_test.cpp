@@ -3,7 +3,10 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <fstream>
+#include <future>
 
+#include "../controller/controller.hpp"
 #include "../patterns/command.hpp"
 
 namespace s21 {
@@ -19,6 +22,9 @@ class ModelManagerTest : public ::testing::Test {
     // Удаляем временный файл
     std::remove(test_file_.c_str());
     // Очищаем модель после каждого теста
+    ModelManager::GetInstance().Clear();
+    ModelManager::GetInstance().SetMemoryBudget(
+        ModelManager::kDefaultMemoryBudget);
     ModelManager::GetInstance().LoadModel("");  // Сброс модели
   }
 
@@ -170,4 +176,177 @@ TEST_F(ModelManagerTest, CommandsWorkWithSingleton) {
   EXPECT_FLOAT_EQ(vertices_after[0].x, x_before + 1.0f);
 }
 
-}  // namespace s21
\ No newline at end of file
+TEST_F(ModelManagerTest, AsyncLoadReplacesModelOnSuccess) {
+  ModelManager& manager = ModelManager::GetInstance();
+  Controller controller(manager);
+  ASSERT_TRUE(controller.LoadModelFromFile(test_file_));
+  Model* previous = manager.GetModel();
+
+  const std::string square_file = "async_square.obj";
+  std::ofstream out(square_file);
+  out << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n";
+  out.close();
+
+  std::promise<void> done;
+  controller.LoadModelFromFileAsync(square_file, nullptr,
+                                    [&] { done.set_value(); });
+  done.get_future().wait();
+
+  // До FinishAsyncLoad текущая модель не меняется
+  EXPECT_EQ(manager.GetModel(), previous);
+  EXPECT_EQ(controller.GetVerticesCount(), 3);
+
+  std::string error;
+  EXPECT_TRUE(controller.FinishAsyncLoad(error));
+  EXPECT_EQ(controller.GetVerticesCount(), 4);
+  EXPECT_EQ(controller.GetEdgesCount(), 4);
+  EXPECT_NEAR(manager.GetModel()->GetBoundingBox().Radius(), 1.0f, 1e-5f);
+
+  std::remove(square_file.c_str());
+}
+
+TEST_F(ModelManagerTest, AsyncLoadFailureKeepsModel) {
+  ModelManager& manager = ModelManager::GetInstance();
+  Controller controller(manager);
+  ASSERT_TRUE(controller.LoadModelFromFile(test_file_));
+  Model* previous = manager.GetModel();
+
+  controller.LoadModelFromFileAsync("nonexistent.obj", nullptr, nullptr);
+  std::string error;
+  EXPECT_FALSE(controller.FinishAsyncLoad(error));
+  EXPECT_EQ(error, "Failed to open file: nonexistent.obj");
+  EXPECT_EQ(manager.GetModel(), previous);
+
+  // Результат уже забран
+  EXPECT_FALSE(controller.FinishAsyncLoad(error));
+}
+
+TEST_F(ModelManagerTest, AsyncLoadSkipsBadLine) {
+  ModelManager& manager = ModelManager::GetInstance();
+  Controller controller(manager);
+  const std::string warning_file = "async_warning.obj";
+  std::ofstream out(warning_file);
+  out << "v 0 0 0\nv 1 0 0\nv bad vertex\nv 0 1 0\nf 1 2 3\n";
+  out.close();
+
+  // Пропущенная строка - предупреждение, а не ошибка загрузки
+  controller.LoadModelFromFileAsync(warning_file, nullptr, nullptr);
+  std::string error;
+  EXPECT_TRUE(controller.FinishAsyncLoad(error));
+  EXPECT_EQ(controller.GetVerticesCount(), 3);
+  EXPECT_EQ(controller.GetLastErrorString().rfind("Error at line 3", 0), 0u);
+
+  std::remove(warning_file.c_str());
+}
+
+TEST_F(ModelManagerTest, ResidentModelIsSelectedWithoutReload) {
+  ModelManager& manager = ModelManager::GetInstance();
+  const std::string square_file = "resident_square.obj";
+  std::ofstream out(square_file);
+  out << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n";
+  out.close();
+
+  ASSERT_TRUE(manager.LoadModel(test_file_));
+  Model* triangle = manager.GetModel();
+  ASSERT_TRUE(manager.LoadModel(square_file));
+  Model* square = manager.GetModel();
+
+  EXPECT_EQ(manager.GetResidentPaths(),
+            (std::vector<std::string>{square_file, test_file_}));
+  EXPECT_EQ(manager.GetMemoryUsage(),
+            triangle->GetMemoryUsage() + square->GetMemoryUsage());
+
+  // Повторная загрузка и выбор берут ту же модель из памяти
+  EXPECT_TRUE(manager.LoadModel(test_file_));
+  EXPECT_EQ(manager.GetModel(), triangle);
+  EXPECT_TRUE(manager.SelectModel(square_file));
+  EXPECT_EQ(manager.GetModel(), square);
+  EXPECT_EQ(manager.GetResidentPaths().front(), square_file);
+
+  // Неудачная загрузка не выгружает модели из памяти
+  EXPECT_FALSE(manager.LoadModel("nonexistent.obj"));
+  EXPECT_TRUE(manager.IsResident(test_file_));
+  EXPECT_TRUE(manager.IsResident(square_file));
+
+  std::remove(square_file.c_str());
+  EXPECT_FALSE(manager.SelectModel(square_file));
+  EXPECT_FALSE(manager.IsResident(square_file));
+}
+
+TEST_F(ModelManagerTest, MemoryBudgetEvictsLeastRecentlyUsed) {
+  ModelManager& manager = ModelManager::GetInstance();
+  const std::vector<std::string> files = {"lru_a.obj", "lru_b.obj",
+                                          "lru_c.obj"};
+  for (const std::string& file : files) {
+    std::ofstream out(file);
+    out << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+  }
+
+  ASSERT_TRUE(manager.LoadModel(files[0]));
+  const size_t model_size = manager.GetMemoryUsage();
+  manager.SetMemoryBudget(2 * model_size);
+
+  ASSERT_TRUE(manager.LoadModel(files[1]));
+  ASSERT_TRUE(manager.SelectModel(files[0]));
+  ASSERT_TRUE(manager.LoadModel(files[2]));
+
+  // Давнее всего использовалась модель files[1]
+  EXPECT_EQ(manager.GetResidentPaths(),
+            (std::vector<std::string>{files[2], files[0]}));
+  EXPECT_LE(manager.GetMemoryUsage(), manager.GetMemoryBudget());
+
+  // Текущая модель остаётся даже сверх бюджета
+  manager.SetMemoryBudget(0);
+  EXPECT_EQ(manager.GetResidentPaths(), std::vector<std::string>{files[2]});
+  EXPECT_NE(manager.GetModel(), nullptr);
+
+  for (const std::string& file : files) std::remove(file.c_str());
+}
+
+TEST_F(ModelManagerTest, ChangedFileIsReloaded) {
+  ModelManager& manager = ModelManager::GetInstance();
+  ASSERT_TRUE(manager.LoadModel(test_file_));
+  ASSERT_EQ(manager.GetModel()->GetVertexCount(), 3);
+
+  std::ofstream out(test_file_);
+  out << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n";
+  out.close();
+
+  EXPECT_TRUE(manager.LoadModel(test_file_));
+  EXPECT_EQ(manager.GetModel()->GetVertexCount(), 4);
+  EXPECT_EQ(manager.GetResidentPaths().size(), 1u);
+}
+
+TEST_F(ModelManagerTest, SceneModelsStayResident) {
+  ModelManager& manager = ModelManager::GetInstance();
+  Controller controller(manager);
+  const std::vector<std::string> files = {"scene_a.obj", "scene_b.obj"};
+  for (const std::string& file : files) {
+    std::ofstream out(file);
+    out << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+  }
+
+  ASSERT_TRUE(manager.LoadModel(files[0]));
+  controller.SetSceneInstances(3);
+  const Model* first = manager.GetModel();
+  ASSERT_TRUE(manager.LoadModel(files[1]));
+  controller.SetSceneInstances(2);
+  EXPECT_EQ(controller.GetSceneInstances(), 2u);
+  EXPECT_EQ(controller.GetScene().GetTotalInstances(), 5u);
+
+  // Модель сцены не выгружается сверх бюджета, как и текущая
+  manager.SetMemoryBudget(0);
+  EXPECT_EQ(manager.GetResidentPaths().size(), 2u);
+  EXPECT_TRUE(manager.GetScene().Contains(first));
+
+  // Выгруженная модель удаляется и из сцены
+  manager.Unload(files[0]);
+  EXPECT_FALSE(manager.GetScene().Contains(first));
+  EXPECT_EQ(controller.GetScene().GetTotalInstances(), 2u);
+
+  controller.ClearScene();
+  EXPECT_TRUE(controller.GetScene().IsEmpty());
+  for (const std::string& file : files) std::remove(file.c_str());
+}
+
+}  // namespace s21
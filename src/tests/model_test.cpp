@@ -2,8 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <set>
 
 namespace s21 {
 
@@ -181,6 +183,267 @@ TEST_F(ModelTest, GetEdgesForComplexPolygon) {
   std::remove(complex_file.c_str());
 }
 
+TEST_F(ModelTest, FaceIndicesAreStoredContiguously) {
+  std::string csr_file = "csr_test.obj";
+  std::ofstream out(csr_file);
+  out << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n";
+  out << "f 1 2 3\n";
+  out << "f 2 2 2\n";  // Вырожденный полигон не попадает в модель
+  out << "f 1 2 3 4\n";
+  out.close();
+
+  EXPECT_TRUE(model_.LoadFromFile(csr_file));
+  EXPECT_EQ(model_.GetPolygonCount(), 2);
+  EXPECT_EQ(model_.GetFaceIndices(),
+            (std::vector<uint32_t>{0, 1, 2, 0, 1, 2, 3}));
+  EXPECT_EQ(model_.GetFaceOffsets(), (std::vector<uint32_t>{0, 3, 7}));
+  EXPECT_EQ(model_.GetPolygons()[1].vertex_indices.size(), 4);
+
+  std::remove(csr_file.c_str());
+}
+
+TEST_F(ModelTest, LoadFileWithCrlfAndSlashTokens) {
+  std::string crlf_file = "crlf_test.obj";
+  std::ofstream out(crlf_file, std::ios::binary);
+  out << "  v 0 0 0\r\n\tv +1 0 0\r\nv 0 1.5e0 0\r\n";
+  out << "vn 0 0 1\r\n";
+  out << "f 1/1/1 2/2/1 +3//1\r\n";
+  out << "f 1 2 3";  // Последняя строка без перевода строки
+  out.close();
+
+  EXPECT_TRUE(model_.LoadFromFile(crlf_file));
+  ASSERT_EQ(model_.GetVertexCount(), 3);
+  EXPECT_FLOAT_EQ(model_.GetVertices()[1].x, 1.0f);
+  EXPECT_FLOAT_EQ(model_.GetVertices()[2].y, 1.5f);
+
+  const auto& polygons = model_.GetPolygons();
+  ASSERT_EQ(polygons.size(), 2);
+  EXPECT_EQ(polygons[0].vertex_indices[0], 0);
+  EXPECT_EQ(polygons[0].vertex_indices[2], 2);
+
+  std::remove(crlf_file.c_str());
+}
+
+TEST_F(ModelTest, ErrorLineNumber) {
+  std::string bad_file = "bad_line_test.obj";
+  std::ofstream out(bad_file);
+  out << "v 0 0 0\nv 1 0 0\nv 0 1 0\n\n";
+  out << "f 1 2 3\n";
+  out << "f 1 2 9\n";
+  out.close();
+
+  EXPECT_TRUE(model_.LoadFromFile(bad_file));
+  EXPECT_EQ(static_cast<int>(model_.GetLastError()),
+            static_cast<int>(Model::ErrorCode::kInvalidData));
+  EXPECT_EQ(model_.GetLastErrorString(),
+            "Error at line 6: Invalid face index: 9");
+
+  std::remove(bad_file.c_str());
+}
+
+TEST_F(ModelTest, ParallelLoadMatchesSerial) {
+  std::string big_file = "parallel_test.obj";
+  std::ofstream out(big_file);
+  for (int i = 0; i < 200; ++i) {
+    out << "v " << i << " " << i * 0.5 << " " << -i << "\n";
+    if (i % 37 == 0) out << "v bad vertex\n";
+    if (i >= 2) out << "f " << i - 1 << " " << i << " " << i + 1 << "\n";
+  }
+  out << "f 1 2 500\n";  // Ссылка на несуществующую вершину
+  out.close();
+
+  Model serial;
+  LoadOptions serial_options;
+  serial_options.parallel = false;
+  ASSERT_TRUE(serial.LoadFromFile(big_file, serial_options));
+
+  LoadOptions parallel_options;
+  parallel_options.min_chunk_size = 64;  // Много маленьких кусков
+  parallel_options.max_chunks = 16;  // Куски и без рабочих потоков
+  ASSERT_TRUE(model_.LoadFromFile(big_file, parallel_options));
+
+  ASSERT_EQ(model_.GetVertexCount(), serial.GetVertexCount());
+  ASSERT_EQ(model_.GetPolygonCount(), serial.GetPolygonCount());
+  for (size_t i = 0; i < serial.GetVertexCount(); ++i) {
+    EXPECT_EQ(model_.GetVertices()[i], serial.GetVertices()[i]);
+  }
+  for (size_t i = 0; i < serial.GetPolygonCount(); ++i) {
+    EXPECT_TRUE(std::ranges::equal(model_.GetPolygons()[i].vertex_indices,
+                                   serial.GetPolygons()[i].vertex_indices));
+  }
+  EXPECT_EQ(model_.GetLastErrorString(), serial.GetLastErrorString());
+
+  std::remove(big_file.c_str());
+}
+
+TEST_F(ModelTest, ParallelLoadKeepsLastErrorAcrossPasses) {
+  std::string big_file = "two_pass_error_test.obj";
+  std::ofstream out(big_file);
+  for (int i = 0; i < 200; ++i) out << "v " << i << " 0 0\n";
+  // В одном куске: ошибка полигона, затем ошибка вершины строкой ниже
+  out << "f 1 2 999\n";
+  out << "v bad vertex\n";
+  out.close();
+
+  Model serial;
+  LoadOptions serial_options;
+  serial_options.parallel = false;
+  ASSERT_TRUE(serial.LoadFromFile(big_file, serial_options));
+  EXPECT_EQ(serial.GetLastErrorString().rfind("Error at line 202: ", 0), 0u);
+
+  LoadOptions parallel_options;
+  parallel_options.min_chunk_size = 256;
+  parallel_options.max_chunks = 16;
+  ASSERT_TRUE(model_.LoadFromFile(big_file, parallel_options));
+  EXPECT_EQ(model_.GetLastErrorString(), serial.GetLastErrorString());
+
+  std::remove(big_file.c_str());
+}
+
+TEST_F(ModelTest, BoundingBoxIsCachedAndInvalidated) {
+  EXPECT_TRUE(model_.LoadFromFile(valid_file_));
+
+  const BoundingBox& box = model_.GetBoundingBox();
+  EXPECT_FLOAT_EQ(box.min.x, 1.0f);
+  EXPECT_FLOAT_EQ(box.max.z, 9.0f);
+
+  const Edge* edges_before = model_.GetEdges().data();
+  model_.GetMutableVertices()[0].x = -5.0f;
+
+  // AABB пересчитан, рёбра остались прежними
+  EXPECT_FLOAT_EQ(model_.GetBoundingBox().min.x, -5.0f);
+  EXPECT_EQ(model_.GetEdges().data(), edges_before);
+  EXPECT_EQ(model_.GetEdgeCount(), 3);
+
+  model_.NormalizeModel();
+  EXPECT_NEAR(model_.GetBoundingBox().Radius(), 1.0f, 1e-5f);
+  EXPECT_NEAR(model_.GetBoundingBox().Center().x, 0.0f, 1e-5f);
+}
+
+TEST_F(ModelTest, ParallelNormalizeMatchesSerial) {
+  std::string big_file = "parallel_normalize_test.obj";
+  std::ofstream out(big_file);
+  for (int i = 0; i < 1000; ++i) {
+    out << "v " << (i * 37) % 101 << " " << i * 0.25 << " " << -i % 13 << "\n";
+  }
+  out << "f 1 2 3\n";
+  out.close();
+
+  Model serial;
+  ExecutionPolicy serial_policy;
+  serial_policy.parallel = false;
+  serial.SetExecutionPolicy(serial_policy);
+  ASSERT_TRUE(serial.LoadFromFile(big_file));
+
+  ExecutionPolicy parallel_policy;
+  parallel_policy.min_parallel_size = 16;  // Много маленьких блоков
+  model_.SetExecutionPolicy(parallel_policy);
+  ASSERT_TRUE(model_.LoadFromFile(big_file));
+
+  const BoundingBox& box = model_.GetBoundingBox();
+  const BoundingBox& serial_box = serial.GetBoundingBox();
+  EXPECT_EQ(box.min, serial_box.min);
+  EXPECT_EQ(box.max, serial_box.max);
+
+  serial.NormalizeModel();
+  model_.NormalizeModel();
+  const Matrix4 rotation = Matrix4::Rotation(10.0f, 20.0f, 30.0f);
+  serial.TransformVertices(rotation);
+  model_.TransformVertices(rotation);
+
+  ASSERT_EQ(model_.GetVertexCount(), serial.GetVertexCount());
+  for (size_t i = 0; i < serial.GetVertexCount(); ++i) {
+    EXPECT_EQ(model_.GetVertices()[i], serial.GetVertices()[i]);
+  }
+  EXPECT_EQ(model_.GetBoundingBox().min, serial.GetBoundingBox().min);
+  EXPECT_EQ(model_.GetBoundingBox().max, serial.GetBoundingBox().max);
+
+  std::remove(big_file.c_str());
+}
+
+TEST_F(ModelTest, LoadReportsProgress) {
+  std::string big_file = "progress_test.obj";
+  std::ofstream out(big_file);
+  for (int i = 0; i < 300; ++i) {
+    out << "v " << i << " " << i << " " << i << "\n";
+    if (i >= 2) out << "f " << i - 1 << " " << i << " " << i + 1 << "\n";
+  }
+  out.close();
+  const size_t file_size = std::filesystem::file_size(big_file);
+
+  for (size_t chunk_size : {size_t{0}, size_t{64}}) {
+    LoadOptions options;
+    options.min_chunk_size = chunk_size;  // 0 - один кусок
+    options.max_chunks = 16;
+    LoadProgress last;
+    size_t calls = 0;
+    options.progress = [&](const LoadProgress& progress) {
+      EXPECT_GE(progress.bytes_parsed, last.bytes_parsed);
+      last = progress;
+      ++calls;
+    };
+    ASSERT_TRUE(model_.LoadFromFile(big_file, options));
+
+    EXPECT_GT(calls, 0u);
+    EXPECT_EQ(last.bytes_total, file_size);
+    EXPECT_EQ(last.bytes_parsed, file_size);
+    EXPECT_EQ(last.vertices, model_.GetVertexCount());
+    EXPECT_EQ(last.faces, model_.GetPolygonCount());
+  }
+
+  std::remove(big_file.c_str());
+}
+
+TEST_F(ModelTest, EdgesOnlyLoadMatchesFullLoad) {
+  std::string big_file = "edges_only_test.obj";
+  std::ofstream out(big_file);
+  for (int i = 0; i < 300; ++i) {
+    out << "v " << i << " " << i * i << " 0\n";
+    if (i >= 3) {
+      out << "f " << i - 2 << " " << i - 1 << " " << i << " " << i + 1
+          << "\n";
+    }
+    if (i % 50 == 0) out << "f 1 2 1\n";  // Вырожденное ребро 1-1
+  }
+  out.close();
+
+  Model full;
+  ASSERT_TRUE(full.LoadFromFile(big_file));
+  ASSERT_FALSE(full.IsEdgesOnly());
+
+  for (size_t chunk_size : {size_t{0}, size_t{64}}) {
+    LoadOptions options;
+    options.min_chunk_size = chunk_size;
+    options.max_chunks = 16;
+    options.mode = LoadMode::kEdgesOnly;
+    ASSERT_TRUE(model_.LoadFromFile(big_file, options));
+
+    EXPECT_TRUE(model_.IsEdgesOnly());
+    EXPECT_TRUE(model_.GetFaceIndices().empty());
+    EXPECT_EQ(model_.GetPolygonCount(), 0u);
+    EXPECT_EQ(model_.GetVertexCount(), full.GetVertexCount());
+    ASSERT_EQ(model_.GetEdgeCount(), full.GetEdgeCount());
+    for (size_t i = 0; i < full.GetEdgeCount(); ++i) {
+      EXPECT_EQ(model_.GetEdges()[i].first, full.GetEdges()[i].first);
+      EXPECT_EQ(model_.GetEdges()[i].second, full.GetEdges()[i].second);
+    }
+    EXPECT_LT(model_.GetMemoryUsage(), full.GetMemoryUsage());
+  }
+
+  std::remove(big_file.c_str());
+}
+
+TEST_F(ModelTest, CancelledLoadFails) {
+  std::atomic<bool> cancel{true};
+  LoadOptions options;
+  options.cancel = &cancel;
+
+  EXPECT_FALSE(model_.LoadFromFile(valid_file_, options));
+  EXPECT_EQ(model_.GetLastError(), Model::ErrorCode::kCancelled);
+  EXPECT_EQ(model_.GetVertexCount(), 0u);
+  EXPECT_EQ(model_.GetPolygonCount(), 0u);
+}
+
 TEST_F(ModelTest, ErrorHandling) {
   // Несуществующий файл
   EXPECT_FALSE(model_.LoadFromFile("nonexistent.obj"));
@@ -228,4 +491,234 @@ TEST_F(ModelTest, Validation) {
   EXPECT_TRUE(model_.IsValid());
 }
 
+TEST_F(ModelTest, PolygonNeedsThreeDistinctVertices) {
+  auto is_valid = [](std::vector<uint32_t> indices) {
+    return Polygon{indices}.IsValid(4);
+  };
+  EXPECT_TRUE(is_valid({0, 1, 2}));
+  EXPECT_TRUE(is_valid({1, 1, 2, 1, 3}));
+  EXPECT_FALSE(is_valid({0, 1}));
+  EXPECT_FALSE(is_valid({2, 2, 2, 2}));
+  EXPECT_FALSE(is_valid({0, 1, 0, 1, 1}));
+  EXPECT_FALSE(is_valid({0, 1, 4}));
+  EXPECT_FALSE(is_valid({0, 1, 2, 3, 7}));
+}
+
+TEST_F(ModelTest, SurfaceMergesEqualCornersAndTriangulatesFans) {
+  std::string surface_file = "surface_test.obj";
+  std::ofstream out(surface_file);
+  out << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\n";
+  out << "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\nvt 0.5\n";
+  out << "vn 0 0 2\n";
+  out << "f 1/1/1 2/2/1 3/3/1 4/4/1\n";
+  // Вершина 2 с другими текстурными координатами - отдельная вершина
+  out << "f 2/5/1 5/2/1 3/3/1\n";
+  out << "f 1 2 3\n";  // Углы без vt и vn
+  out.close();
+
+  LoadOptions options;
+  options.attributes = true;
+  ASSERT_TRUE(model_.LoadFromFile(surface_file, options));
+  ASSERT_TRUE(model_.HasSurface());
+
+  const auto& vertices = model_.GetSurfaceVertices();
+  ASSERT_EQ(vertices.size(), 9u);  // 4 + (2/5, 5/2) + три угла без атрибутов
+  EXPECT_FLOAT_EQ(vertices[2].position[0], 1.0f);
+  EXPECT_FLOAT_EQ(vertices[2].texcoord[1], 1.0f);
+  EXPECT_FLOAT_EQ(vertices[2].normal[2], 2.0f);
+  EXPECT_FLOAT_EQ(vertices[4].texcoord[0], 0.5f);
+  EXPECT_FLOAT_EQ(vertices[4].texcoord[1], 0.0f);
+  EXPECT_FLOAT_EQ(vertices[6].normal[2], 0.0f);
+
+  const std::vector<uint32_t> triangles = {0, 1, 2, 0, 2, 3, 4, 5, 2, 6, 7, 8};
+  EXPECT_EQ(model_.GetSurfaceTriangles(), triangles);
+
+  // Без attributes и в режиме kEdgesOnly поверхность не строится
+  ASSERT_TRUE(model_.LoadFromFile(surface_file));
+  EXPECT_FALSE(model_.HasSurface());
+  options.mode = LoadMode::kEdgesOnly;
+  ASSERT_TRUE(model_.LoadFromFile(surface_file, options));
+  EXPECT_FALSE(model_.HasSurface());
+
+  std::remove(surface_file.c_str());
+}
+
+TEST_F(ModelTest, ParallelSurfaceMatchesSerial) {
+  std::string big_file = "parallel_surface_test.obj";
+  std::ofstream out(big_file);
+  for (int i = 0; i < 200; ++i) {
+    out << "v " << i << " " << i * 0.5 << " " << -i << "\n";
+    out << "vt " << i * 0.01 << " " << 1 - i * 0.01 << "\n";
+    if (i % 2 == 0) out << "vn 0 0 1\n";
+    if (i >= 2) {
+      out << "f " << i - 1 << "/" << i << "/" << i / 2 << " " << i << "/"
+          << i + 1 << " " << i + 1 << "/" << i - 1 << "/1\n";
+    }
+  }
+  out << "f 1/1/1 2/2/1 3/300/1\n";  // Ссылка на несуществующую vt
+  out.close();
+
+  LoadOptions serial_options;
+  serial_options.parallel = false;
+  serial_options.attributes = true;
+  Model serial;
+  ASSERT_TRUE(serial.LoadFromFile(big_file, serial_options));
+
+  LoadOptions parallel_options;
+  parallel_options.min_chunk_size = 64;
+  parallel_options.max_chunks = 16;
+  parallel_options.attributes = true;
+  ASSERT_TRUE(model_.LoadFromFile(big_file, parallel_options));
+
+  const auto& a = model_.GetSurfaceVertices();
+  const auto& b = serial.GetSurfaceVertices();
+  ASSERT_EQ(a.size(), b.size());
+  EXPECT_EQ(std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0])), 0);
+  EXPECT_EQ(model_.GetSurfaceTriangles(), serial.GetSurfaceTriangles());
+  EXPECT_EQ(model_.GetSurfaceTriangles().size(),
+            model_.GetPolygonCount() * 3);
+  EXPECT_EQ(model_.GetLastErrorString(), serial.GetLastErrorString());
+  EXPECT_EQ(model_.GetLastErrorString(),
+            "Error at line 699: Invalid texture index: 300");
+
+  std::remove(big_file.c_str());
+}
+
+TEST_F(ModelTest, SurfaceNormalsFollowVertexTransform) {
+  std::string surface_file = "surface_transform_test.obj";
+  std::ofstream out(surface_file);
+  out << "v 0 0 0\nv 1 0 0\nv 0 1 0\n";
+  out << "vn 1 1 0\n";
+  out << "f 1//1 2//1 3//1\n";
+  out.close();
+
+  LoadOptions options;
+  options.attributes = true;
+  ASSERT_TRUE(model_.LoadFromFile(surface_file, options));
+
+  // Растяжение по X: позиции растягиваются, нормаль наклоняется к оси Y
+  Matrix4 stretch = Matrix4::Translation(0.0f, 0.0f, 1.0f);
+  stretch(0, 0) = 2.0f;
+  model_.SetVertexTransform(stretch);
+  const SurfaceVertex& v = model_.GetSurfaceVertices()[1];
+  EXPECT_FLOAT_EQ(v.position[0], 2.0f);
+  EXPECT_FLOAT_EQ(v.position[2], 1.0f);
+  EXPECT_NEAR(v.normal[0], 1.0f / std::sqrt(5.0f), 1e-6f);
+  EXPECT_NEAR(v.normal[1], 2.0f / std::sqrt(5.0f), 1e-6f);
+  EXPECT_NEAR(v.normal[2], 0.0f, 1e-6f);
+
+  // Повторная установка считает от исходных нормалей, а не от текущих
+  model_.SetVertexTransform(Matrix4::Identity());
+  EXPECT_FLOAT_EQ(model_.GetSurfaceVertices()[1].position[0], 1.0f);
+  EXPECT_FLOAT_EQ(model_.GetSurfaceVertices()[1].normal[0], 1.0f);
+
+  model_.GetMutableVertices()[1].y = 5.0f;
+  EXPECT_FLOAT_EQ(model_.GetSurfaceVertices()[1].position[1], 5.0f);
+
+  std::remove(surface_file.c_str());
+}
+
+TEST_F(ModelTest, WeldMergesSplitFacesOfCube) {
+  // Куб, у каждой грани которого свои четыре вершины (как при экспорте
+  // из CAD), и вырожденный полигон, две вершины которого совпадают
+  std::string cube_file = "weld_test.obj";
+  std::ofstream out(cube_file);
+  const int faces[6][4][3] = {
+      {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}},
+      {{0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}},
+      {{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}},
+      {{0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}},
+      {{0, 0, 0}, {0, 1, 0}, {0, 1, 1}, {0, 0, 1}},
+      {{1, 0, 0}, {1, 1, 0}, {1, 1, 1}, {1, 0, 1}}};
+  for (int f = 0; f < 6; ++f) {
+    for (const auto& v : faces[f]) {
+      out << "v " << v[0] << " " << v[1] << " " << v[2] + 1e-7 << "\n";
+    }
+    out << "f " << f * 4 + 1 << " " << f * 4 + 2 << " " << f * 4 + 3 << " "
+        << f * 4 + 4 << "\n";
+  }
+  out << "v 5 5 5\nv 5 5 5.0000001\nf 1 25 26\n";
+  out.close();
+
+  ASSERT_TRUE(model_.LoadFromFile(cube_file));
+  EXPECT_EQ(model_.GetVertexCount(), 26u);
+  EXPECT_EQ(model_.GetEdgeCount(), 27u);
+
+  LoadOptions options;
+  options.weld = true;
+  ASSERT_TRUE(model_.LoadFromFile(cube_file, options));
+  EXPECT_EQ(model_.GetVertexCount(), 9u);
+  EXPECT_EQ(model_.GetEdgeCount(), 12u);
+  EXPECT_EQ(model_.GetPolygonCount(), 6u);
+  EXPECT_EQ(model_.GetWeldStats().vertices_removed, 17u);
+  EXPECT_EQ(model_.GetWeldStats().edges_removed, 15u);
+  EXPECT_EQ(model_.GetWeldStats().polygons_removed, 1u);
+  EXPECT_TRUE(model_.IsValid());
+  EXPECT_FLOAT_EQ(model_.GetVertices()[8].x, 5.0f);  // Порядок сохранён
+
+  // Треугольники поверхности удаляются вместе с выродившимся полигоном
+  options.attributes = true;
+  ASSERT_TRUE(model_.LoadFromFile(cube_file, options));
+  EXPECT_EQ(model_.GetPolygonCount(), 6u);
+  ASSERT_EQ(model_.GetSurfaceTriangles().size(), 6u * 2 * 3);
+  const auto& surface = model_.GetSurfaceVertices();
+  for (uint32_t index : model_.GetSurfaceTriangles()) {
+    ASSERT_LT(index, surface.size());
+    EXPECT_LT(surface[index].position[0], 2.0f);  // Не вершина (5, 5, 5)
+  }
+  options.attributes = false;
+
+  // Каркас без полигонов: рёбра сливаются без исходных полигонов
+  Model edges_only;
+  options.mode = LoadMode::kEdgesOnly;
+  ASSERT_TRUE(edges_only.LoadFromFile(cube_file, options));
+  EXPECT_EQ(edges_only.GetVertexCount(), 9u);
+  EXPECT_EQ(edges_only.GetEdgeCount(), 13u);  // И ребро 1-25 выродившегося
+  EXPECT_EQ(edges_only.GetWeldStats().edges_removed, 14u);
+
+  std::remove(cube_file.c_str());
+}
+
+TEST_F(ModelTest, WeldMatchesPairwiseComparison) {
+  // Точки около границ ячеек сетки: совпадающие вершины должны находиться и
+  // в соседних ячейках
+  std::vector<Vertex> vertices;
+  uint32_t state = 12345;
+  auto next = [&state] {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / 16777216.0f;
+  };
+  const float tolerance = 0.01f;
+  for (int i = 0; i < 2000; ++i) {
+    const Vertex v{std::round(next() * 10) * tolerance * 2,
+                   std::round(next() * 10) * tolerance * 2, next() * 0.1f};
+    vertices.push_back(v);
+    vertices.push_back({v.x + (next() - 0.5f) * tolerance,
+                        v.y - (next() - 0.5f) * tolerance, v.z});
+  }
+
+  std::vector<Vertex> kept;  // Вершины, которые должны остаться
+  for (const Vertex& v : vertices) {
+    bool found = false;
+    for (const Vertex& w : kept) {
+      found = std::abs(v.x - w.x) < tolerance &&
+              std::abs(v.y - w.y) < tolerance &&
+              std::abs(v.z - w.z) < tolerance;
+      if (found) break;
+    }
+    if (!found) kept.push_back(v);
+  }
+
+  ASSERT_TRUE(model_.SetMeshData("weld", vertices, {}, {}));
+  const WeldStats stats = model_.WeldVertices(tolerance);
+  EXPECT_EQ(stats.vertices_removed, vertices.size() - kept.size());
+  ASSERT_EQ(model_.GetVertexCount(), kept.size());
+  for (size_t i = 0; i < kept.size(); ++i) {
+    EXPECT_EQ(model_.GetVertices()[i], kept[i]);
+  }
+
+  // Повторное слияние ничего не меняет
+  EXPECT_EQ(model_.WeldVertices(tolerance).vertices_removed, 0u);
+}
+
 }  // namespace s21
\ No newline at end of file
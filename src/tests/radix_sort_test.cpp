@@ -0,0 +1,30 @@
+#include "../model/radix_sort.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+namespace s21 {
+
+TEST(RadixSortTest, MatchesStdSort) {
+  std::mt19937_64 rng(21);
+  std::vector<uint64_t> keys(300000);
+  for (auto& key : keys) {
+    // Ключи рёбер: старшая и младшая половины - индексы вершин
+    key = (rng() % 100000) << 32 | (rng() % 100000);
+  }
+  std::vector<uint64_t> expected = keys;
+  std::sort(expected.begin(), expected.end());
+
+  ParallelRadixSort(keys);
+  EXPECT_EQ(keys, expected);
+}
+
+TEST(RadixSortTest, SortUniqueRemovesDuplicates) {
+  std::vector<uint64_t> keys = {5, 1, 5, 3, 1, 1, 0xFFFFFFFF00000000ull, 3};
+  SortUnique(keys);
+  EXPECT_EQ(keys, (std::vector<uint64_t>{1, 3, 5, 0xFFFFFFFF00000000ull}));
+}
+
+}  // namespace s21
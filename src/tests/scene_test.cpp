@@ -0,0 +1,88 @@
+#include "../model/scene.hpp"
+
+#include <gtest/gtest.h>
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Центр ячейки экземпляра: образ начала координат.
+ */
+Vertex Center(const Matrix4& instance) {
+  Vertex v{0, 0, 0};
+  instance.Apply(v.x, v.y, v.z);
+  return v;
+}
+
+}  // namespace
+
+TEST(SceneTest, LaysOutInstancesOnGrid) {
+  Model first, second;
+  Scene scene;
+  scene.SetInstanceCount(&first, 3);
+  scene.SetInstanceCount(&second, 1);
+  ASSERT_EQ(scene.GetModels().size(), 2u);
+  EXPECT_EQ(scene.GetTotalInstances(), 4u);
+  EXPECT_EQ(scene.GetInstanceCount(&first), 3u);
+
+  // Четыре экземпляра - сетка 2x2, вписанная в [-1, 1]
+  std::vector<Vertex> centers;
+  for (const SceneModel& entry : scene.GetModels()) {
+    for (const Matrix4& instance : entry.instances) {
+      centers.push_back(Center(instance));
+      Vertex corner{1, 1, 1};
+      instance.Apply(corner.x, corner.y, corner.z);
+      EXPECT_LE(corner.x, 1.0f + 1e-5f);
+      EXPECT_LE(corner.y, 1.0f + 1e-5f);
+      EXPECT_NEAR(instance(0, 0), 1.0f / (2 * Scene::kCellSpacing), 1e-6f);
+    }
+  }
+  ASSERT_EQ(centers.size(), 4u);
+  EXPECT_LT(centers[0].x, centers[1].x);
+  EXPECT_FLOAT_EQ(centers[0].y, centers[1].y);
+  EXPECT_GT(centers[0].y, centers[2].y);  // Первая строка сверху
+  EXPECT_FLOAT_EQ(centers[3].x, centers[1].x);
+  EXPECT_NEAR(centers[0].x + centers[3].x, 0.0f, 1e-6f);
+
+  // Единственный экземпляр занимает всю область
+  scene.Remove(&first);
+  ASSERT_EQ(scene.GetModels().size(), 1u);
+  EXPECT_NEAR(Center(scene.GetModels()[0].instances[0]).x, 0.0f, 1e-6f);
+  EXPECT_NEAR(scene.GetModels()[0].instances[0](0, 0),
+              1.0f / Scene::kCellSpacing, 1e-6f);
+}
+
+TEST(SceneTest, VersionAndIdsTrackChanges) {
+  Model model;
+  Scene scene;
+  EXPECT_TRUE(scene.IsEmpty());
+  const uint64_t initial = scene.GetVersion();
+
+  scene.SetInstanceCount(&model, 2);
+  const uint64_t id = scene.GetModels()[0].id;
+  const uint64_t added = scene.GetVersion();
+  EXPECT_GT(added, initial);
+
+  // То же число экземпляров - сцена не меняется
+  scene.SetInstanceCount(&model, 2);
+  EXPECT_EQ(scene.GetVersion(), added);
+
+  scene.SetInstanceCount(&model, Scene::kMaxInstances + 10);
+  EXPECT_EQ(scene.GetInstanceCount(&model), Scene::kMaxInstances);
+  EXPECT_EQ(scene.GetModels()[0].id, id);
+  EXPECT_GT(scene.GetVersion(), added);
+
+  // Повторно добавленная модель получает новую запись
+  scene.Remove(&model);
+  EXPECT_FALSE(scene.Contains(&model));
+  scene.SetInstanceCount(&model, 1);
+  EXPECT_NE(scene.GetModels()[0].id, id);
+
+  scene.SetInstanceCount(nullptr, 5);
+  EXPECT_EQ(scene.GetModels().size(), 1u);
+  scene.Clear();
+  EXPECT_TRUE(scene.IsEmpty());
+}
+
+}  // namespace s21
@@ -0,0 +1,166 @@
+#include "../model/snapshot.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+#include "../controller/controller.hpp"
+#include "../model/mesh_generator.hpp"
+#include "../patterns/vertex_baker.hpp"
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Проверяет, что вершины модели и снимок совпадают с эталоном.
+ */
+void ExpectSameVertices(const std::vector<Vertex>& actual,
+                        const std::vector<Vertex>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    ASSERT_FLOAT_EQ(actual[i].x, expected[i].x) << i;
+    ASSERT_FLOAT_EQ(actual[i].y, expected[i].y) << i;
+    ASSERT_FLOAT_EQ(actual[i].z, expected[i].z) << i;
+  }
+}
+
+}  // namespace
+
+TEST(SnapshotTest, ConsumesLatestPublication) {
+  SnapshotBuffer buffer;
+  EXPECT_EQ(buffer.Consume(), nullptr);
+  EXPECT_FALSE(buffer.HasPending());
+
+  for (float value : {1.0f, 2.0f, 3.0f}) {
+    buffer.GetBack().vertices.assign(4, Vertex{value, value, value});
+    buffer.Publish();
+  }
+  EXPECT_TRUE(buffer.HasPending());
+
+  // Читателю достаётся только последний снимок
+  const GeometrySnapshot* snapshot = buffer.Consume();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->version, 3u);
+  EXPECT_FLOAT_EQ(snapshot->vertices[0].x, 3.0f);
+  EXPECT_EQ(buffer.Consume(), nullptr);
+
+  // Снимок читателя не перезаписывается следующими публикациями
+  buffer.GetBack().vertices.assign(4, Vertex{4.0f, 4.0f, 4.0f});
+  buffer.Publish();
+  buffer.GetBack().vertices.assign(4, Vertex{5.0f, 5.0f, 5.0f});
+  buffer.Publish();
+  EXPECT_FLOAT_EQ(snapshot->vertices[0].x, 3.0f);
+  snapshot = buffer.Consume();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->version, 5u);
+  EXPECT_FLOAT_EQ(snapshot->vertices[3].z, 5.0f);
+}
+
+TEST(SnapshotTest, ReaderNeverSeesTornSnapshot) {
+  constexpr uint64_t kPublications = 20000;
+  constexpr size_t kSize = 256;
+  SnapshotBuffer buffer;
+
+  std::thread writer([&buffer] {
+    for (uint64_t i = 1; i <= kPublications; ++i) {
+      const auto value = static_cast<float>(i);
+      buffer.GetBack().vertices.assign(kSize, Vertex{value, -value, value});
+      buffer.Publish();
+    }
+  });
+
+  // Каждый полученный снимок целиком записан одной публикацией, а номера
+  // публикаций только растут
+  uint64_t last = 0;
+  while (last < kPublications) {
+    const GeometrySnapshot* snapshot = buffer.Consume();
+    if (!snapshot) continue;
+    ASSERT_GT(snapshot->version, last);
+    last = snapshot->version;
+    ASSERT_EQ(snapshot->vertices.size(), kSize);
+    const auto expected = static_cast<float>(last);
+    for (const Vertex& v : snapshot->vertices) {
+      ASSERT_EQ(v.x, expected);
+      ASSERT_EQ(v.y, -expected);
+    }
+  }
+  writer.join();
+}
+
+TEST(VertexBakerTest, CoalescedRequestsMatchSynchronousBake) {
+  MeshSpec spec{MeshShape::kSphere, 20000};
+  Model model, reference;
+  ASSERT_TRUE(GenerateMesh(spec, model));
+  ASSERT_TRUE(GenerateMesh(spec, reference));
+  model.GetBvh();
+
+  VertexBaker baker;
+  int done = 0;
+  baker.SetDoneCallback([&done] { ++done; });
+  TransformState state;
+  for (int angle = 0; angle <= 90; angle += 10) {
+    state.rotate_y = static_cast<float>(angle);
+    state.scale = 1.0f + static_cast<float>(angle) / 90.0f;
+    baker.Request(model, state.ToMatrix());
+  }
+  baker.Wait();
+  EXPECT_FALSE(baker.IsBusy());
+  EXPECT_GE(done, 1);
+  EXPECT_LE(done, 10);
+
+  // Результат - последнее преобразование, как без фонового потока
+  reference.SetVertexTransform(state.ToMatrix());
+  ExpectSameVertices(model.GetVertices(), reference.GetVertices());
+  EXPECT_FALSE(model.GetBvh().IsEmpty());
+
+  const GeometrySnapshot* snapshot = baker.GetSnapshots().Consume();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->version, static_cast<uint64_t>(done));
+  ExpectSameVertices(snapshot->vertices, model.GetVertices());
+  EXPECT_EQ(baker.GetSnapshots().Consume(), nullptr);
+}
+
+TEST(VertexBakerTest, ControllerBakesInBackground) {
+  ModelManager& manager = ModelManager::GetInstance();
+  MeshSpec spec{MeshShape::kGrid, 5000};
+  auto model = std::make_unique<Model>();
+  Model reference;
+  ASSERT_TRUE(GenerateMesh(spec, *model));
+  ASSERT_TRUE(GenerateMesh(spec, reference));
+  manager.SetModel(std::move(model));
+
+  {
+    Controller controller(manager);
+    controller.SetTransformMode(TransformMode::kBake);
+    TransformState state{0.5f, 0.0f, -1.0f, 30.0f, 0.0f, 15.0f, 2.0f};
+    controller.SetTransformState(state);
+    EXPECT_TRUE(controller.ApplyTransformStateAsync());
+    EXPECT_FALSE(controller.ApplyTransformStateAsync());
+
+    // Команды дожидаются фонового пересчёта и применяются к его результату
+    controller.TranslateModel(1, 0, 0);
+    EXPECT_FALSE(controller.GetVertexBaker().IsBusy());
+    reference.SetVertexTransform(Matrix4::Translation(1, 0, 0) *
+                                 state.ToMatrix());
+    ExpectSameVertices(manager.GetModel()->GetVertices(),
+                       reference.GetVertices());
+
+    // В режиме kMatrix вершины возвращаются к исходным, фоновый поток не
+    // нужен, а шаг команды остаётся в матрице модели
+    controller.SetTransformMode(TransformMode::kMatrix);
+    controller.SetTransformState(TransformState{});
+    EXPECT_TRUE(controller.ApplyTransformStateAsync());
+    EXPECT_FALSE(controller.GetVertexBaker().IsBusy());
+    EXPECT_EQ(manager.GetModel()->GetTransform().m,
+              Matrix4::Translation(1, 0, 0).m);
+    reference.SetVertexTransform(Matrix4::Identity());
+    ExpectSameVertices(manager.GetModel()->GetVertices(),
+                       reference.GetVertices());
+  }
+  manager.SetTransformMode(TransformMode::kBake);
+  manager.Clear();
+}
+
+}  // namespace s21
@@ -0,0 +1,40 @@
+#include "../model/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace s21 {
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  std::vector<std::atomic<int>> visits(1000);
+  ThreadPool::GetInstance().ParallelFor(
+      visits.size(), [&](size_t i) { visits[i].fetch_add(1); });
+
+  for (const auto& v : visits) {
+    EXPECT_EQ(v.load(), 1);
+  }
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+  std::atomic<size_t> sum{0};
+  auto& pool = ThreadPool::GetInstance();
+  pool.ParallelFor(8, [&](size_t i) {
+    pool.ParallelFor(8, [&](size_t j) { sum.fetch_add(i * 8 + j); });
+  });
+
+  EXPECT_EQ(sum.load(), 64u * 63u / 2u);
+}
+
+TEST(ThreadPoolTest, ExceptionIsRethrown) {
+  EXPECT_THROW(ThreadPool::GetInstance().ParallelFor(
+                   16,
+                   [](size_t i) {
+                     if (i == 7) throw std::runtime_error("task failed");
+                   }),
+               std::runtime_error);
+}
+
+}  // namespace s21
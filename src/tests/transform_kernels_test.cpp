@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "../model/transform_kernels.hpp"
+
+namespace s21 {
+
+namespace {
+
+Matrix4 TestMatrix() {
+  return Matrix4::Translation(0.5f, -1.25f, 3.0f) * Matrix4::Scale(1.7f) *
+         Matrix4::Rotation(33.0f, -71.0f, 12.5f);
+}
+
+std::vector<float> RandomPoints(size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  std::vector<float> points(count * 3);
+  for (float& v : points) v = dist(gen);
+  return points;
+}
+
+}  // namespace
+
+// Размеры перебираются так, чтобы задеть как полные векторные итерации,
+// так и скалярный хвост
+TEST(TransformKernelsTest, AosMatchesScalarApply) {
+  const Matrix4 m = TestMatrix();
+  for (size_t count = 0; count <= 37; ++count) {
+    std::vector<float> points = RandomPoints(count);
+    std::vector<float> expected = points;
+    for (size_t i = 0; i < count; ++i) {
+      m.Apply(expected[i * 3], expected[i * 3 + 1], expected[i * 3 + 2]);
+    }
+
+    TransformPoints(points.data(), count, m);
+    ASSERT_EQ(points.size(), expected.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      EXPECT_FLOAT_EQ(points[i], expected[i])
+          << "count = " << count << ", kernel " << TransformKernelName();
+    }
+  }
+}
+
+TEST(TransformKernelsTest, SoaMatchesScalarApply) {
+  const Matrix4 m = TestMatrix();
+  for (size_t count = 0; count <= 37; ++count) {
+    std::vector<float> points = RandomPoints(count);
+    std::vector<float> x(count), y(count), z(count);
+    for (size_t i = 0; i < count; ++i) {
+      x[i] = points[i * 3];
+      y[i] = points[i * 3 + 1];
+      z[i] = points[i * 3 + 2];
+      m.Apply(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]);
+    }
+
+    TransformPoints(x.data(), y.data(), z.data(), count, m);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_FLOAT_EQ(x[i], points[i * 3]);
+      EXPECT_FLOAT_EQ(y[i], points[i * 3 + 1]);
+      EXPECT_FLOAT_EQ(z[i], points[i * 3 + 2]);
+    }
+  }
+}
+
+}  // namespace s21
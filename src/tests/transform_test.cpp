@@ -3,6 +3,7 @@
 #include <cmath>
 #include <fstream>
 
+#include "../controller/controller.hpp"
 #include "../patterns/command.hpp"
 #include "../patterns/model_manager.hpp"
 
@@ -29,6 +30,7 @@ class AffineTransformTest : public ::testing::Test {
     // Удаляем временный файл
     std::remove(test_file_.c_str());
     // Сбрасываем модель
+    ModelManager::GetInstance().Clear();
     ModelManager::GetInstance().LoadModelForTest("");
   }
 
@@ -254,4 +256,360 @@ TEST_F(AffineTransformTest, ZeroScaleHandling) {
   }
 }
 
-}  // namespace s21
\ No newline at end of file
+TEST_F(AffineTransformTest, MatrixModeMatchesBakeMode) {
+  ModelManager& manager = ModelManager::GetInstance();
+  ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+
+  RotateCommand(30.0f, 45.0f, 60.0f).Execute();
+  MoveCommand(1.0f, -2.0f, 0.5f).Execute();
+  ScaleCommand(1.5f).Execute();
+  const auto baked = manager.GetModel()->GetVertices();
+
+  ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+  manager.SetTransformMode(TransformMode::kMatrix);
+  const auto original = manager.GetModel()->GetVertices();
+
+  RotateCommand(30.0f, 45.0f, 60.0f).Execute();
+  MoveCommand(1.0f, -2.0f, 0.5f).Execute();
+  ScaleCommand(1.5f).Execute();
+
+  // Вершины не изменились, трансформация накоплена в матрице
+  Model* model = manager.GetModel();
+  EXPECT_EQ(model->GetVertices(), original);
+  EXPECT_FALSE(model->GetTransform().IsIdentity());
+
+  // При возврате в режим kBake матрица применяется к вершинам
+  manager.SetTransformMode(TransformMode::kBake);
+  EXPECT_TRUE(model->GetTransform().IsIdentity());
+  const auto& vertices = model->GetVertices();
+  ASSERT_EQ(vertices.size(), baked.size());
+  for (size_t i = 0; i < baked.size(); ++i) {
+    EXPECT_NEAR(vertices[i].x, baked[i].x, TEST_EPSILON);
+    EXPECT_NEAR(vertices[i].y, baked[i].y, TEST_EPSILON);
+    EXPECT_NEAR(vertices[i].z, baked[i].z, TEST_EPSILON);
+  }
+}
+
+TEST_F(AffineTransformTest, BakeTransformUpdatesBoundingBox) {
+  ModelManager& manager = ModelManager::GetInstance();
+  ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+  Model* model = manager.GetModel();
+
+  model->ApplyTransform(Matrix4::Translation(1.0f, 0.0f, 0.0f));
+  model->ApplyTransform(Matrix4::Scale(2.0f));
+  EXPECT_NEAR(model->GetBoundingBox().max.x, 1.0f, TEST_EPSILON);
+
+  model->BakeTransform();
+  // (1,0,0) -> перенос (2,0,0) -> масштаб (4,0,0)
+  EXPECT_NEAR(model->GetVertices()[0].x, 4.0f, TEST_EPSILON);
+  EXPECT_NEAR(model->GetBoundingBox().max.x, 4.0f, TEST_EPSILON);
+  EXPECT_NEAR(model->GetBoundingBox().min.x, 2.0f, TEST_EPSILON);
+}
+
+TEST_F(AffineTransformTest, TransformStateBuildsScaleRotateTranslate) {
+  TransformState state;
+  EXPECT_TRUE(state.ToMatrix().IsIdentity());
+
+  state.scale = 2.0f;
+  state.rotate_z = 90.0f;
+  state.translate_x = 1.0f;
+  // (1,0,0) -> масштаб (2,0,0) -> поворот (0,2,0) -> перенос (1,2,0)
+  float x = 1.0f, y = 0.0f, z = 0.0f;
+  state.ToMatrix().Apply(x, y, z);
+  EXPECT_NEAR(x, 1.0f, TEST_EPSILON);
+  EXPECT_NEAR(y, 2.0f, TEST_EPSILON);
+  EXPECT_NEAR(z, 0.0f, TEST_EPSILON);
+}
+
+TEST_F(AffineTransformTest, VertexTransformDoesNotAccumulateError) {
+  ModelManager& manager = ModelManager::GetInstance();
+  ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+  Model* model = manager.GetModel();
+  const auto original = model->GetVertices();
+  const size_t usage = model->GetMemoryUsage();
+
+  // Тысячи шагов слайдера: каждый раз от исходных вершин
+  TransformState state;
+  for (int step = 0; step < 3600; ++step) {
+    state.rotate_y = step * 0.1f;
+    state.translate_x = std::sin(step * 0.01f);
+    state.scale = 1.0f + step * 0.001f;
+    model->SetVertexTransform(state.ToMatrix());
+  }
+  float x = 1.0f, y = 0.0f, z = 0.0f;
+  state.ToMatrix().Apply(x, y, z);
+  EXPECT_NEAR(model->GetVertices()[0].x, x, TEST_EPSILON);
+  EXPECT_NEAR(model->GetVertices()[0].z, z, TEST_EPSILON);
+  EXPECT_NEAR(model->GetBoundingBox().max.x,
+              std::max({model->GetVertices()[0].x, model->GetVertices()[1].x,
+                        model->GetVertices()[2].x}),
+              TEST_EPSILON);
+
+  EXPECT_GT(model->GetMemoryUsage(), usage);  // Копия исходных вершин
+
+  // Единичное состояние возвращает вершины точно и освобождает копию
+  model->SetVertexTransform(Matrix4::Identity());
+  EXPECT_EQ(model->GetVertices(), original);
+  EXPECT_EQ(model->GetMemoryUsage(), usage);
+}
+
+TEST_F(AffineTransformTest, ControllerCoalescesTransformState) {
+  ModelManager& manager = ModelManager::GetInstance();
+  ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+  Controller controller(manager);
+  controller.SetTransformMode(TransformMode::kMatrix);
+
+  // Несколько изменений подряд - одно вычисление
+  TransformState state;
+  for (int value = 0; value <= 90; ++value) {
+    state.rotate_x = static_cast<float>(value);
+    controller.SetTransformState(state);
+  }
+  state.translate_z = 0.5f;
+  controller.SetTransformState(state);
+  EXPECT_TRUE(controller.ApplyTransformState());
+  EXPECT_FALSE(controller.ApplyTransformState());
+
+  // Матрица задана заново, а не домножена
+  EXPECT_EQ(manager.GetModel()->GetTransform().m, state.ToMatrix().m);
+  controller.SetTransformState(state);
+  EXPECT_TRUE(controller.ApplyTransformState());
+  EXPECT_EQ(manager.GetModel()->GetTransform().m, state.ToMatrix().m);
+
+  controller.SetTransformMode(TransformMode::kBake);
+}
+
+TEST_F(AffineTransformTest, TransformStateIsKeptPerModel) {
+  ModelManager& manager = ModelManager::GetInstance();
+  const std::string other_file = "affine_other_test.obj";
+  {
+    std::ofstream out(other_file);
+    out << "v 0.0 0.0 0.0\nv 1.0 1.0 0.0\nv 1.0 0.0 1.0\nf 1 2 3\n";
+  }
+  Controller controller(manager);
+  ASSERT_TRUE(controller.LoadModelFromFile(test_file_));
+  const TransformState state{1.0f, 0.0f, 0.0f, 0.0f, 45.0f, 0.0f, 2.0f};
+  controller.SetTransformState(state);
+  controller.ApplyTransformState();
+  const auto transformed = manager.GetModel()->GetVertices();
+
+  // У новой модели исходное положение
+  ASSERT_TRUE(controller.LoadModelFromFile(other_file));
+  EXPECT_EQ(controller.GetTransformState(), TransformState{});
+  Model* other = manager.GetModel();
+  const auto other_original = other->GetVertices();
+  TransformState other_state;
+  other_state.scale = 3.0f;
+  controller.SetTransformState(other_state);
+
+  // Возврат к модели восстанавливает её положение; отложенное состояние
+  // другой модели применено к ней самой
+  ASSERT_TRUE(controller.SelectResidentModel(test_file_));
+  EXPECT_EQ(controller.GetTransformState(), state);
+  EXPECT_FALSE(controller.ApplyTransformState());
+  EXPECT_EQ(manager.GetModel()->GetVertices(), transformed);
+  EXPECT_NEAR(other->GetVertices()[1].x, other_original[1].x * 3.0f,
+              TEST_EPSILON);
+
+  ASSERT_TRUE(controller.SelectResidentModel(other_file));
+  EXPECT_EQ(controller.GetTransformState(), other_state);
+  std::remove(other_file.c_str());
+}
+
+TEST_F(AffineTransformTest, AffineInverse) {
+  TransformState state{1.0f, -2.0f, 0.5f, 30.0f, 45.0f, 60.0f, 2.5f};
+  const Matrix4 matrix = state.ToMatrix();
+  const Matrix4 product = matrix.AffineInverse() * matrix;
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      EXPECT_NEAR(product(row, col), row == col ? 1.0f : 0.0f, TEST_EPSILON);
+    }
+  }
+  EXPECT_TRUE(Matrix4::Scale(0.0f).AffineInverse().IsIdentity());
+}
+
+TEST_F(AffineTransformTest, CommandQueueMergesCommands) {
+  ModelManager& manager = ModelManager::GetInstance();
+  ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+  Controller controller(manager);
+
+  // Сто перемещений подряд - одна команда и один шаг истории
+  for (int i = 0; i < 100; ++i) controller.QueueTranslate(0.01, 0, 0);
+  EXPECT_NEAR(manager.GetModel()->GetVertices()[0].x, 1.0f, TEST_EPSILON);
+  EXPECT_TRUE(controller.FlushCommands());
+  EXPECT_FALSE(controller.FlushCommands());
+  EXPECT_NEAR(manager.GetModel()->GetVertices()[0].x, 2.0f, TEST_EPSILON);
+
+  // Команда без очереди выполняется сразу отдельным шагом
+  controller.TranslateModel(1, 0, 0);
+  EXPECT_NEAR(manager.GetModel()->GetVertices()[0].x, 3.0f, TEST_EPSILON);
+  EXPECT_FALSE(controller.FlushCommands());
+  EXPECT_TRUE(controller.Undo());
+  EXPECT_NEAR(manager.GetModel()->GetVertices()[0].x, 2.0f, TEST_EPSILON);
+
+  CompositeCommand composite;
+  composite.Add(std::make_unique<RotateCommand>(10.0f, 0.0f, 0.0f));
+  composite.Add(std::make_unique<RotateCommand>(20.0f, 0.0f, 0.0f));
+  EXPECT_EQ(composite.GetSize(), 1u);
+  composite.Add(std::make_unique<RotateCommand>(0.0f, 30.0f, 0.0f));
+  composite.Add(std::make_unique<ScaleCommand>(2.0f));
+  composite.Add(std::make_unique<ScaleCommand>(1.5f));
+  EXPECT_EQ(composite.GetSize(), 3u);
+
+  // Составная команда совпадает с последовательным выполнением
+  const Matrix4 expected = Matrix4::Scale(3.0f) *
+                           Matrix4::Rotation(0.0f, 30.0f, 0.0f) *
+                           Matrix4::Rotation(30.0f, 0.0f, 0.0f);
+  const Matrix4 actual = composite.GetMatrix();
+  for (size_t i = 0; i < actual.m.size(); ++i) {
+    EXPECT_NEAR(actual.m[i], expected.m[i], TEST_EPSILON);
+  }
+}
+
+TEST_F(AffineTransformTest, CommandQueueUndoRedo) {
+  ModelManager& manager = ModelManager::GetInstance();
+  for (auto mode : {TransformMode::kBake, TransformMode::kMatrix}) {
+    ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+    Controller controller(manager);
+    controller.SetTransformMode(mode);
+    Model* model = manager.GetModel();
+    const auto original = model->GetVertices();
+    const size_t memory = model->GetMemoryUsage();
+
+    controller.RotateModel(30, 45, 60);
+    controller.QueueScale(2);
+    controller.QueueTranslate(1, -2, 0.5);
+    EXPECT_TRUE(controller.CanUndo());
+    controller.FlushCommands();
+    controller.BakeTransform();
+    const auto transformed = model->GetVertices();
+    EXPECT_FALSE(controller.CanRedo());
+
+    EXPECT_TRUE(controller.Undo());
+    EXPECT_TRUE(controller.Undo());
+    EXPECT_FALSE(controller.Undo());
+    EXPECT_TRUE(controller.CanRedo());
+    controller.BakeTransform();
+    for (size_t i = 0; i < original.size(); ++i) {
+      EXPECT_NEAR(model->GetVertices()[i].x, original[i].x, TEST_EPSILON);
+      EXPECT_NEAR(model->GetVertices()[i].y, original[i].y, TEST_EPSILON);
+      EXPECT_NEAR(model->GetVertices()[i].z, original[i].z, TEST_EPSILON);
+    }
+    // История не хранит копий вершин
+    EXPECT_EQ(model->GetMemoryUsage(), memory);
+
+    EXPECT_TRUE(controller.Redo());
+    EXPECT_TRUE(controller.Redo());
+    EXPECT_FALSE(controller.Redo());
+    controller.BakeTransform();
+    for (size_t i = 0; i < transformed.size(); ++i) {
+      EXPECT_NEAR(model->GetVertices()[i].x, transformed[i].x, TEST_EPSILON);
+      EXPECT_NEAR(model->GetVertices()[i].y, transformed[i].y, TEST_EPSILON);
+      EXPECT_NEAR(model->GetVertices()[i].z, transformed[i].z, TEST_EPSILON);
+    }
+
+    // Новая модель - история сбрасывается
+    manager.Clear();
+    ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+    EXPECT_FALSE(controller.Undo());
+  }
+  manager.SetTransformMode(TransformMode::kBake);
+}
+
+TEST_F(AffineTransformTest, CommandHistoryIsKeptPerModel) {
+  ModelManager& manager = ModelManager::GetInstance();
+  const std::string other_file = "affine_other_test.obj";
+  {
+    std::ofstream out(other_file);
+    out << "v 0.0 0.0 0.0\nv 1.0 1.0 0.0\nv 1.0 0.0 1.0\nf 1 2 3\n";
+  }
+  Controller controller(manager);
+  ASSERT_TRUE(controller.LoadModelFromFile(test_file_));
+  const auto original = manager.GetModel()->GetVertices();
+  controller.TranslateModel(1, 0, 0);
+  controller.ScaleModel(2);
+  const auto transformed = manager.GetModel()->GetVertices();
+
+  // Шаги другой модели не смешиваются с историей первой
+  ASSERT_TRUE(controller.LoadModelFromFile(other_file));
+  EXPECT_FALSE(controller.CanUndo());
+  controller.RotateModel(0, 90, 0);
+
+  ASSERT_TRUE(controller.SelectResidentModel(test_file_));
+  EXPECT_EQ(manager.GetModel()->GetVertices(), transformed);
+  EXPECT_TRUE(controller.Undo());
+  EXPECT_TRUE(controller.Undo());
+  EXPECT_FALSE(controller.Undo());
+  for (size_t i = 0; i < original.size(); ++i) {
+    EXPECT_NEAR(manager.GetModel()->GetVertices()[i].x, original[i].x,
+                TEST_EPSILON);
+  }
+
+  ASSERT_TRUE(controller.SelectResidentModel(other_file));
+  EXPECT_TRUE(controller.Undo());
+  EXPECT_FALSE(controller.Undo());
+  std::remove(other_file.c_str());
+}
+
+TEST_F(AffineTransformTest, CommandsComposeWithTransformState) {
+  ModelManager& manager = ModelManager::GetInstance();
+  Model source;
+  ASSERT_TRUE(source.LoadFromFile(test_file_));
+  const Matrix4 move = Matrix4::Translation(1, -2, 0.5);
+
+  // Ожидаемые вершины: преобразование исходных вершин модели
+  auto expect_vertices = [&source](const Model& model,
+                                   const Matrix4& transform) {
+    for (size_t i = 0; i < source.GetVertices().size(); ++i) {
+      Vertex v = source.GetVertices()[i];
+      transform.Apply(v.x, v.y, v.z);
+      EXPECT_NEAR(model.GetVertices()[i].x, v.x, TEST_EPSILON);
+      EXPECT_NEAR(model.GetVertices()[i].y, v.y, TEST_EPSILON);
+      EXPECT_NEAR(model.GetVertices()[i].z, v.z, TEST_EPSILON);
+    }
+  };
+
+  for (auto mode : {TransformMode::kBake, TransformMode::kMatrix}) {
+    ASSERT_TRUE(manager.LoadModelForTest(test_file_));
+    Controller controller(manager);
+    controller.SetTransformMode(mode);
+    Model* model = manager.GetModel();
+
+    TransformState state{0.0f, 0.0f, 0.0f, 0.0f, 90.0f, 0.0f, 2.0f};
+    controller.SetTransformState(state);
+    controller.ApplyTransformState();
+
+    // Команда отложена до FlushCommands() и применяется поверх состояния
+    controller.QueueTranslate(1, -2, 0.5);
+    controller.BakeTransform();
+    expect_vertices(*model, state.ToMatrix());
+    EXPECT_TRUE(controller.FlushCommands());
+    controller.BakeTransform();
+    expect_vertices(*model, move * state.ToMatrix());
+
+    // Новое состояние не применяет прежнее повторно и сохраняет шаг команды
+    state.rotate_y = 30.0f;
+    controller.SetTransformState(state);
+    controller.ApplyTransformState();
+    controller.BakeTransform();
+    expect_vertices(*model, move * state.ToMatrix());
+
+    EXPECT_TRUE(controller.Undo());
+    controller.BakeTransform();
+    expect_vertices(*model, state.ToMatrix());
+    EXPECT_TRUE(controller.Redo());
+    controller.BakeTransform();
+    expect_vertices(*model, move * state.ToMatrix());
+
+    // Смена режима переносит итоговое преобразование, а не удваивает его
+    controller.SetTransformMode(mode == TransformMode::kBake
+                                    ? TransformMode::kMatrix
+                                    : TransformMode::kBake);
+    controller.BakeTransform();
+    expect_vertices(*model, move * state.ToMatrix());
+    controller.SetTransformMode(mode);
+  }
+  manager.SetTransformMode(TransformMode::kBake);
+}
+
+}  // namespace s21